@@ -0,0 +1,65 @@
+/**
+ * @file bench.hpp
+ * @brief Timing helpers for the plugin benchmarks
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Run() repeats a callable until a batch takes at least MIN_BATCH,
+ * times REPEATS such batches and reports the fastest one per call. That is
+ * less noisy than the mean on a shared machine, and good enough to compare
+ * two implementations measured in the same process.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+
+namespace bench {
+  using Clock = std::chrono::steady_clock;
+
+  inline constexpr std::chrono::milliseconds MIN_BATCH { 20 };
+  inline constexpr int                       REPEATS = 5;
+
+  // Keeps a result alive so the measured work is not optimized away
+  template <typename T>
+  inline auto DoNotOptimize(const T& value) -> void {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile auto* sink = &value;
+    (void)sink;
+#endif
+  }
+
+  /**
+   * @brief Time a callable and print its cost
+   * @return Fastest observed nanoseconds per call
+   */
+  template <typename Fn>
+  auto Run(const std::string_view name, Fn&& function) -> double {
+    long iterations = 1;
+    for (;;) {
+      const auto start = Clock::now();
+      for (long index = 0; index < iterations; ++index)
+        function();
+      if (Clock::now() - start >= MIN_BATCH)
+        break;
+      iterations *= 2;
+    }
+
+    double best = 0.0;
+    for (int repeat = 0; repeat < REPEATS; ++repeat) {
+      const auto start = Clock::now();
+      for (long index = 0; index < iterations; ++index)
+        function();
+      const double perCall = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(iterations);
+      if (repeat == 0 || perCall < best)
+        best = perCall;
+    }
+
+    std::printf("%-48.*s %12.1f ns/op\n", static_cast<int>(name.size()), name.data(), best);
+    return best;
+  }
+} // namespace bench
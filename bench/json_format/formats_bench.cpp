@@ -0,0 +1,68 @@
+/**
+ * @file formats_bench.cpp
+ * @brief json_format's encodings compared by size and speed
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Formats the "full" sample document (every system field and a few
+ * plugin fields) and the "large" one (about 2000 plugin fields) in every
+ * format the plugin was built with, printing ns/op next to the encoded size.
+ * "json-delta" is measured on an unchanged document: the lines carry no
+ * changes, so its cost is that of the diff itself plus a keyframe every
+ * KEYFRAME_INTERVAL lines, and its size is that of an empty delta.
+ *
+ * Every format but "json-delta" is then read back with glaze into an object
+ * with owned strings (see tests/json_format/decoded_output.hpp), which is what
+ * a consumer of the output pays on the other end.
+ */
+
+#include "json_format/json_format.cpp"
+
+#include "bench/bench.hpp"
+#include "tests/common/format_cases.hpp"
+#include "tests/json_format/decoded_output.hpp"
+
+auto main() -> int {
+  JsonFormatPlugin plugin;
+  PluginCache      cache;
+  if (!plugin.initialize({}, cache)) {
+    std::puts("failed to initialize the plugin");
+    return 1;
+  }
+
+  for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+    if (sample.name != "full" && sample.name != "large")
+      continue;
+
+    for (const String& format : plugin.getFormatNames()) {
+      const Result<String> document = plugin.formatOutput(format, sample.data, sample.pluginData);
+      if (!document) {
+        std::printf("%s failed: %s\n", format.c_str(), document.error().message.c_str());
+        return 1;
+      }
+
+      bench::Run(std::format("{:<5} {}", sample.name, format), [&] {
+        bench::DoNotOptimize(plugin.formatOutput(format, sample.data, sample.pluginData));
+      });
+
+      // The delta line after the one just measured, which repeats the same document
+      const usize bytes = format == "json-delta" ? plugin.formatOutput(format, sample.data, sample.pluginData)->size() : document->size();
+      std::printf("%48s %12zu bytes\n", "", bytes);
+
+      if (format == "json-delta")
+        continue;
+
+      tests::json_format::DecodedOutput decoded;
+      if (Result<Unit> read = tests::json_format::Decode(format, *document, decoded); !read) {
+        std::printf("%s failed to decode: %s\n", format.c_str(), read.error().message.c_str());
+        return 1;
+      }
+
+      bench::Run(std::format("{:<5} {} decode", sample.name, format), [&] {
+        bench::DoNotOptimize(tests::json_format::Decode(format, *document, decoded));
+      });
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file collect_bench.cpp
+ * @brief now_playing collection latency, MPRIS and MPD
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Runs against a private dbus-daemon with one scripted player and a
+ * scripted MPD server, so the numbers measure the plugin and its transport,
+ * not whatever the desktop is doing.
+ *
+ * - "fresh connection": what every poll paid before the plugin kept a session
+ *   connection, i.e. connect, authenticate and Hello, then discovery.
+ * - "reused session": the same discovery over the long-lived Session.
+ * - "remembered player": discovery with last run's player asked in the same
+ *   round trip as ListNames, which saves the second round trip when it is
+ *   the only player.
+ * - "plugin collectData": the whole path, including ranking, sanitizing and
+ *   the active-player cache lookup, for each backend and mode. MPD answers
+ *   status and currentsong in one round trip on a reused connection.
+ */
+
+#include "now_playing/now_playing.cpp"
+
+#include "bench/bench.hpp"
+#include "tests/now_playing/mpd_fixture.hpp"
+
+namespace {
+  using namespace now_playing::dbus;
+
+  auto BenchPlugin(const StringView name, const String& config) -> bool {
+    NowPlayingPlugin plugin;
+    PluginCache      cache;
+    if (!plugin.setConfig(config + "\nart_cache = false") || !plugin.initialize({}, cache) || !plugin.collectData(cache)) {
+      std::printf("failed to initialize the plugin for %.*s\n", static_cast<int>(name.size()), name.data());
+      return false;
+    }
+
+    bench::Run(name, [&] {
+      bench::DoNotOptimize(plugin.collectData(cache));
+    });
+
+    plugin.shutdown();
+    return true;
+  }
+
+  auto BenchMpris() -> bool {
+    Option<tests::mpris::Bus>     bus     = tests::mpris::Bus::Start();
+    Option<tests::mpris::Players> players = bus ? tests::mpris::Players::Start(*bus, { { .name = "bench" } }) : None;
+    if (!players) {
+      std::puts("failed to start the private bus or the mock player");
+      return false;
+    }
+
+    const String& address = bus->address();
+
+    bench::Run("fresh connection per collection", [&] {
+      Result<Connection> connection = openBus(address);
+      if (connection)
+        bench::DoNotOptimize(fetchPlayers(*connection, {}));
+    });
+
+    Session session;
+    if (!session.open(address)) {
+      std::puts("failed to open the session connection");
+      return false;
+    }
+
+    bench::Run("reused session connection", [&] {
+      bench::DoNotOptimize(fetchPlayers(session, {}));
+    });
+
+    Option<CachedPlayer> remembered;
+    bench::Run("reused session, remembered player", [&] {
+      bench::DoNotOptimize(fetchPlayers(session, {}, remembered));
+    });
+
+    return BenchPlugin("plugin collectData (MPRIS poll)", std::format("bus_address = \"{}\"", address))
+      && BenchPlugin("plugin collectData (MPRIS events)", std::format("bus_address = \"{}\"\nmode = \"events\"", address));
+  }
+
+  auto BenchMpd() -> bool {
+    const Option<tests::mpd::Server> server = tests::mpd::Server::Start();
+    if (!server) {
+      std::puts("failed to start the mock MPD server");
+      return false;
+    }
+
+    const String config = std::format("backend = \"mpd\"\nmpd_host = \"{}\"", server->socketPath());
+    return BenchPlugin("plugin collectData (MPD poll)", config) && BenchPlugin("plugin collectData (MPD events)", config + "\nmode = \"events\"");
+  }
+} // namespace
+
+auto main() -> int {
+  bool succeeded = true;
+
+  if (tests::mpris::Available())
+    succeeded = BenchMpris();
+  else
+    std::puts("MPRIS skipped: needs dbus-daemon, python3 and jeepney");
+
+  if (tests::mpd::Available())
+    succeeded = BenchMpd() && succeeded;
+  else
+    std::puts("MPD skipped: needs python3");
+
+  return succeeded ? 0 : 1;
+}
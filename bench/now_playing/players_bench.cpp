@@ -0,0 +1,216 @@
+/**
+ * @file players_bench.cpp
+ * @brief now_playing collection cost by player count, metadata size and mode
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Every case runs the plugin's collectData against a private
+ * dbus-daemon hosting scripted players, and reports per call:
+ * - wall time (ns/op), the fastest of several batches as in bench::Run;
+ * - heap allocations, counted by the operator new below;
+ * - CPU time of the whole process, so events mode includes its listener.
+ *
+ * The matrix covers 1 to 50 players with 16 B and 16 KiB titles in poll and
+ * events mode, then one player answering 20 ms late, and finally a storm of
+ * PropertiesChanged signals, reported as listener CPU per signal.
+ */
+
+#include "now_playing/now_playing.cpp"
+
+#include <atomic>
+#include <ctime>
+#include <new>
+#include <thread>
+
+#include "bench/bench.hpp"
+#include "tests/now_playing/mpris_fixture.hpp"
+
+namespace {
+  std::atomic<u64> Allocations = 0;
+} // namespace
+
+// Counts every allocation in the process, including the listener thread's
+auto operator new(const std::size_t size) -> void* {
+  Allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size))
+    return memory;
+  throw std::bad_alloc();
+}
+
+auto operator delete(void* memory) noexcept -> void {
+  std::free(memory);
+}
+
+auto operator delete(void* memory, std::size_t /*size*/) noexcept -> void {
+  std::free(memory);
+}
+
+namespace {
+  using namespace now_playing::dbus;
+
+  auto ProcessCpuNs() -> f64 {
+    timespec now {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return (static_cast<f64>(now.tv_sec) * 1e9) + static_cast<f64>(now.tv_nsec);
+  }
+
+  /**
+   * @brief bench::Run's batching, also reporting allocations and CPU time per call
+   */
+  template <typename Fn>
+  auto Profile(const StringView name, Fn&& function) -> void {
+    long iterations = 1;
+    for (;;) {
+      const auto start = bench::Clock::now();
+      for (long index = 0; index < iterations; ++index)
+        function();
+      if (bench::Clock::now() - start >= bench::MIN_BATCH)
+        break;
+      iterations *= 2;
+    }
+
+    f64 bestWall = 0.0;
+    f64 bestCpu  = 0.0;
+    u64 allocs   = 0;
+    for (int repeat = 0; repeat < bench::REPEATS; ++repeat) {
+      const u64  allocsBefore = Allocations.load(std::memory_order_relaxed);
+      const f64  cpuBefore    = ProcessCpuNs();
+      const auto start        = bench::Clock::now();
+      for (long index = 0; index < iterations; ++index)
+        function();
+      const f64 wall = std::chrono::duration<f64, std::nano>(bench::Clock::now() - start).count() / static_cast<f64>(iterations);
+      const f64 cpu  = (ProcessCpuNs() - cpuBefore) / static_cast<f64>(iterations);
+
+      if (repeat == 0 || wall < bestWall) {
+        bestWall = wall;
+        bestCpu  = cpu;
+        allocs   = (Allocations.load(std::memory_order_relaxed) - allocsBefore) / static_cast<u64>(iterations);
+      }
+    }
+
+    std::printf("%-40.*s %12.1f ns/op %8llu allocs/op %12.1f cpu ns/op\n", static_cast<int>(name.size()), name.data(), bestWall, static_cast<unsigned long long>(allocs), bestCpu);
+  }
+
+  auto MakePlayers(const usize count, const usize titleBytes) -> Vec<tests::mpris::PlayerSpec> {
+    Vec<tests::mpris::PlayerSpec> specs;
+    for (usize index = 0; index < count; ++index)
+      // One playing player among paused ones, listed last so ranking has to look at all of them
+      specs.push_back({ .name = std::format("p{}", index), .status = index + 1 == count ? "Playing" : "Paused", .titleBytes = titleBytes });
+    return specs;
+  }
+
+  /**
+   * @brief Plugin instance on the bus, with the given extra TOML lines
+   */
+  auto StartPlugin(NowPlayingPlugin& plugin, PluginCache& cache, const tests::mpris::Bus& bus, const StringView config) -> bool {
+    return plugin.setConfig(std::format("bus_address = \"{}\"\nart_cache = false\n{}", bus.address(), config)) && plugin.initialize({}, cache);
+  }
+
+  auto RunMatrix(const tests::mpris::Bus& bus) -> void {
+    for (const usize titleBytes : { 16UZ, 16UZ * 1024 })
+      for (const usize count : { 1UZ, 5UZ, 20UZ, 50UZ }) {
+        const Option<tests::mpris::Players> players = tests::mpris::Players::Start(bus, MakePlayers(count, titleBytes));
+        if (!players) {
+          std::puts("failed to start the mock players");
+          return;
+        }
+
+        for (const StringView mode : { "poll", "events" }) {
+          NowPlayingPlugin plugin;
+          PluginCache      cache;
+          if (!StartPlugin(plugin, cache, bus, std::format("mode = \"{}\"", mode))) {
+            std::puts("failed to initialize the plugin");
+            return;
+          }
+
+          Profile(std::format("{:<6} {:>2} players, {:>5} B titles", mode, count, titleBytes), [&] {
+            bench::DoNotOptimize(plugin.collectData(cache));
+          });
+
+          plugin.shutdown();
+        }
+      }
+  }
+
+  auto RunSlowPlayer(const tests::mpris::Bus& bus) -> void {
+    Vec<tests::mpris::PlayerSpec> specs = MakePlayers(10, 16);
+    specs.front().delayMs               = 20;
+
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(bus, specs);
+    if (!players)
+      return;
+
+    for (const StringView mode : { "poll", "events" }) {
+      NowPlayingPlugin plugin;
+      PluginCache      cache;
+      if (!StartPlugin(plugin, cache, bus, std::format("mode = \"{}\"", mode)))
+        return;
+
+      Profile(std::format("{:<6} 10 players, one 20 ms late", mode), [&] {
+        bench::DoNotOptimize(plugin.collectData(cache));
+      });
+
+      plugin.shutdown();
+    }
+  }
+
+  auto RunStorm(const tests::mpris::Bus& bus) -> void {
+    constexpr usize SIGNALS = 2000;
+
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(bus, MakePlayers(5, 256));
+    if (!players)
+      return;
+
+    NowPlayingPlugin plugin;
+    PluginCache      cache;
+    if (!StartPlugin(plugin, cache, bus, "mode = \"events\""))
+      return;
+
+    // The storm is followed by a title change; once the plugin reports it, every signal has been handled
+    const f64  cpuBefore    = ProcessCpuNs();
+    const u64  allocsBefore = Allocations.load(std::memory_order_relaxed);
+    const auto start        = bench::Clock::now();
+
+    if (!players->command(std::format("storm p4 {}", SIGNALS)) || !players->command("title p4 after the storm"))
+      return;
+
+    for (;;) {
+      if (plugin.collectData(cache)) {
+        const PluginFields fields = plugin.getFields();
+        const auto         title  = fields.find("title");
+        if (title != fields.end() && std::get<String>(title->second) == "after the storm")
+          break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const f64 wall = std::chrono::duration<f64, std::milli>(bench::Clock::now() - start).count();
+    std::printf(
+      "events storm of %zu signals: %.1f ms to settle, %.1f cpu us/signal, %.1f allocs/signal\n",
+      SIGNALS,
+      wall,
+      (ProcessCpuNs() - cpuBefore) / 1000.0 / SIGNALS,
+      static_cast<f64>(Allocations.load(std::memory_order_relaxed) - allocsBefore) / SIGNALS
+    );
+
+    plugin.shutdown();
+  }
+} // namespace
+
+auto main() -> int {
+  if (!tests::mpris::Available()) {
+    std::puts("skipped: needs dbus-daemon, python3 and jeepney");
+    return 0;
+  }
+
+  const Option<tests::mpris::Bus> bus = tests::mpris::Bus::Start();
+  if (!bus) {
+    std::puts("failed to start the private bus");
+    return 1;
+  }
+
+  RunMatrix(*bus);
+  RunSlowPlayer(*bus);
+  RunStorm(*bus);
+  return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file text_bench.cpp
+ * @brief now_playing's UTF-8 repair and width functions on multi-KB titles
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Each input is measured with Sanitize (on a fresh copy, so the
+ * copy is reported on its own line), DisplayWidth and Truncate to 40
+ * columns. "scalar width" decodes every codepoint without the SWAR ASCII
+ * skip, as a baseline for what the eight-byte fast path saves.
+ */
+
+#include "now_playing/now_playing_text.hpp"
+
+#include <format>
+
+#include "bench/bench.hpp"
+
+namespace {
+  using namespace now_playing::text;
+
+  auto ScalarDisplayWidth(const StringView text) -> usize {
+    usize pos   = 0;
+    usize width = 0;
+
+    while (pos < text.size()) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      width += decoded.valid ? CodepointWidth(decoded.codepoint) : 1;
+      pos += decoded.length;
+    }
+
+    return width;
+  }
+
+  auto Repeat(const StringView unit, const usize bytes) -> String {
+    String text;
+    while (text.size() + unit.size() <= bytes)
+      text += unit;
+    return text;
+  }
+
+  struct Input {
+    StringView name;
+    String     text;
+  };
+
+  auto MakeInputs() -> Vec<Input> {
+    Vec<Input> inputs;
+    inputs.push_back({ "ascii 4 KiB", Repeat("Some Artist - A Rather Long Track Title (Live) ", 4096) });
+    inputs.push_back({ "ascii 64 KiB", Repeat("Some Artist - A Rather Long Track Title (Live) ", 65536) });
+    inputs.push_back({ "ascii 4 KiB, newline at the end", Repeat("Some Artist - A Rather Long Track Title (Live) ", 4095) + "\n" });
+    inputs.push_back({ "mixed CJK 4 KiB", Repeat("Artist \xE3\x81\x82\xE3\x81\x84\xE3\x81\x86 Title \xF0\x9F\x8E\xB5 ", 4096) });
+    inputs.push_back({ "invalid bytes 4 KiB", Repeat("Some Artist - A Rather Long Title \xC3\x28 (Live) \xFF ", 4096) });
+    return inputs;
+  }
+} // namespace
+
+auto main() -> int {
+  for (const Input& input : MakeInputs()) {
+    std::printf("%.*s (%zu bytes)\n", static_cast<int>(input.name.size()), input.name.data(), input.text.size());
+
+    bench::Run("  copy", [&] {
+      String copy = input.text;
+      bench::DoNotOptimize(copy);
+    });
+
+    bench::Run("  copy + Sanitize", [&] {
+      String copy = input.text;
+      bench::DoNotOptimize(Sanitize(copy));
+      bench::DoNotOptimize(copy);
+    });
+
+    bench::Run("  DisplayWidth", [&] {
+      bench::DoNotOptimize(DisplayWidth(input.text));
+    });
+
+    bench::Run("  scalar width", [&] {
+      bench::DoNotOptimize(ScalarDisplayWidth(input.text));
+    });
+
+    bench::Run("  Truncate to 40 columns", [&] {
+      bench::DoNotOptimize(Truncate(input.text, 40));
+    });
+
+    if (DisplayWidth(input.text) != ScalarDisplayWidth(input.text)) {
+      std::puts("DisplayWidth disagrees with the scalar baseline");
+      return 1;
+    }
+  }
+
+  return 0;
+}
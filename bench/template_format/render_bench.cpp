@@ -0,0 +1,66 @@
+/**
+ * @file render_bench.cpp
+ * @brief The default template against the markdown format it mirrors
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Both plugins lay out the same document, so the ns/op of
+ * formatOutput() compares the compiled template program with the
+ * hand-written markdown builder on the "full" and "large" sample documents.
+ * The outputs are checked to be identical before anything is timed.
+ */
+
+#include "markdown_format/markdown_format.cpp"
+
+// Both plugins define the same factory functions; only markdown_format's are kept
+#undef DRAC_PLUGIN
+#define DRAC_PLUGIN(PluginClass)
+
+#include "template_format/template_format.cpp"
+
+#include <chrono>
+
+#include "bench/bench.hpp"
+#include "tests/common/format_cases.hpp"
+
+auto main() -> int {
+  const fs::path configDir = fs::temp_directory_path() / std::format("template_format_bench.{}", std::chrono::steady_clock::now().time_since_epoch().count());
+
+  draconis::core::plugin::PluginContext context;
+  context.configDir = configDir;
+
+  PluginCache          cache;
+  MarkdownFormatPlugin markdown;
+  TemplateFormatPlugin layout;
+
+  if (!markdown.initialize(context, cache) || !layout.initialize(context, cache)) {
+    std::puts("failed to initialize the plugins");
+    return 1;
+  }
+
+  for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+    if (sample.name != "full" && sample.name != "large")
+      continue;
+
+    const Result<String> expected = markdown.formatOutput("markdown", sample.data, sample.pluginData);
+    const Result<String> rendered = layout.formatOutput("template", sample.data, sample.pluginData);
+
+    if (!expected || !rendered || *expected != *rendered) {
+      std::printf("%s: the default template and the markdown format disagree\n", sample.name.c_str());
+      return 1;
+    }
+
+    bench::Run(std::format("{:<5} markdown", sample.name), [&] {
+      bench::DoNotOptimize(markdown.formatOutput("markdown", sample.data, sample.pluginData));
+    });
+
+    bench::Run(std::format("{:<5} template", sample.name), [&] {
+      bench::DoNotOptimize(layout.formatOutput("template", sample.data, sample.pluginData));
+    });
+  }
+
+  std::error_code errc;
+  fs::remove_all(configDir, errc);
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file forecast_kernels_bench.cpp
+ * @brief Scalar reference vs batch forecast kernels
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Computes all four derived metrics over a forecast window, once by
+ * calling the scalar reference functions per hour and once with the batch
+ * kernels. 168 hours is the weather plugin's 7-day hourly forecast; the
+ * larger sizes show how the gap grows once the loop dominates call overhead.
+ */
+
+#include <cstdio>
+
+#include "bench/bench.hpp"
+#include "weather/ForecastKernels.hpp"
+
+namespace {
+  using namespace weather::kernels;
+
+  auto MakeColumns(const usize hours) -> ForecastColumns {
+    ForecastColumns columns;
+    for (usize hour = 0; hour < hours; ++hour) {
+      const auto phase = static_cast<f64>(hour % 24);
+      columns.time.push_back(static_cast<i64>(hour) * 3600);
+      columns.temperature.push_back(-15.0 + (phase * 2.0));
+      columns.relativeHumidity.push_back(30.0 + (phase * 2.5));
+      columns.windSpeed.push_back(static_cast<f64>(hour % 13));
+    }
+    return columns;
+  }
+} // namespace
+
+auto main() -> int {
+  for (const usize hours : { usize { 168 }, usize { 384 }, usize { 8760 } }) {
+    const ForecastColumns columns = MakeColumns(hours);
+    DerivedColumns        derived {
+             .apparentTemperature = Vec<f64>(hours),
+             .dewPoint            = Vec<f64>(hours),
+             .heatIndex           = Vec<f64>(hours),
+             .windChill           = Vec<f64>(hours),
+    };
+
+    char label[64];
+
+    std::snprintf(label, sizeof(label), "scalar reference, %zu hours", hours);
+    const double scalar = bench::Run(label, [&] {
+      for (usize index = 0; index < hours; ++index) {
+        const f64 temp     = columns.temperature[index];
+        const f64 humidity = columns.relativeHumidity[index];
+        const f64 wind     = columns.windSpeed[index];
+
+        derived.apparentTemperature[index] = reference::ApparentTemperature(temp, humidity, wind);
+        derived.dewPoint[index]            = reference::DewPoint(temp, humidity);
+        derived.heatIndex[index]           = reference::HeatIndex(temp, humidity);
+        derived.windChill[index]           = reference::WindChill(temp, wind);
+      }
+      bench::DoNotOptimize(derived.windChill.data());
+    });
+
+    std::snprintf(label, sizeof(label), "batch kernels, %zu hours", hours);
+    const double batch = bench::Run(label, [&] {
+      ApparentTemperature(columns.temperature, columns.relativeHumidity, columns.windSpeed, derived.apparentTemperature);
+      DewPoint(columns.temperature, columns.relativeHumidity, derived.dewPoint);
+      HeatIndex(columns.temperature, columns.relativeHumidity, derived.heatIndex);
+      WindChill(columns.temperature, columns.windSpeed, derived.windChill);
+      bench::DoNotOptimize(derived.windChill.data());
+    });
+
+    std::printf("  batch speedup: %.2fx\n", scalar / batch);
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file emit_bench.cpp
+ * @brief yaml_format's emitters: BlockWriter, a fresh ryml tree and the reused one
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Built with YAML_FORMAT_USE_RYML, so "plugin (reused ryml tree)" is
+ * the plugin's formatOutput() on its capacity-reserved tree. The other two
+ * extract the fields and lay out the same document with WriteDocument() as
+ * formatOutput() does: once into a ryml::Tree constructed for every call, as
+ * the plugin did before it kept one, and once with the tree-free BlockWriter
+ * that default builds use. Each line reports
+ * ns/op and the heap allocations of one call after warm-up, counting both
+ * operator new and RapidYAML's own allocation callback.
+ */
+
+#include "yaml_format/yaml_format.cpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "bench/bench.hpp"
+#include "tests/common/format_cases.hpp"
+#include "yaml_format/yaml_emitter.hpp"
+
+namespace {
+  std::atomic<u64> Allocations = 0;
+} // namespace
+
+auto operator new(const std::size_t size) -> void* {
+  Allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size))
+    return memory;
+  throw std::bad_alloc();
+}
+
+auto operator delete(void* memory) noexcept -> void {
+  std::free(memory);
+}
+
+auto operator delete(void* memory, std::size_t /*size*/) noexcept -> void {
+  std::free(memory);
+}
+
+namespace {
+  auto CountingAllocate(const usize length, void* /*hint*/, void* /*userData*/) -> void* {
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(length);
+  }
+
+  auto CountingFree(void* memory, const usize /*size*/, void* /*userData*/) -> void {
+    std::free(memory);
+  }
+
+  template <typename Fn>
+  auto Measure(const StringView name, Fn&& function) -> void {
+    bench::Run(name, function);
+
+    const u64 before = Allocations.load(std::memory_order_relaxed);
+    function();
+    std::printf("%48s %12llu allocs/op\n", "", static_cast<unsigned long long>(Allocations.load(std::memory_order_relaxed) - before));
+  }
+} // namespace
+
+auto main() -> int {
+  // Before any tree exists, since each one copies the callbacks when constructed
+  ryml::Callbacks callbacks = ryml::get_callbacks();
+  callbacks.m_allocate      = CountingAllocate;
+  callbacks.m_free          = CountingFree;
+  ryml::set_callbacks(callbacks);
+
+  YamlFormatPlugin plugin;
+  PluginCache      cache;
+  if (!plugin.initialize({}, cache)) {
+    std::puts("failed to initialize the plugin");
+    return 1;
+  }
+
+  for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+    if (sample.name != "full" && sample.name != "large")
+      continue;
+
+    Measure(std::format("{:<5} plugin (reused ryml tree)", sample.name), [&] {
+      bench::DoNotOptimize(plugin.formatOutput("yaml", sample.data, sample.pluginData));
+    });
+
+    Measure(std::format("{:<5} fresh ryml tree", sample.name), [&] {
+      ryml::Tree tree;
+      String     yaml = "---\n";
+      TreeWriter writer(tree);
+      WriteDocument(writer, FieldValues::Extract(sample.data), sample.pluginData);
+      ryml::emitrs_yaml(tree, &yaml, /*append=*/true);
+      bench::DoNotOptimize(yaml);
+    });
+
+    Measure(std::format("{:<5} BlockWriter", sample.name), [&] {
+      String yaml = "---\n";
+      yaml.reserve(2048); // As the default build of the plugin does
+      yaml_format::emitter::BlockWriter writer(yaml);
+      WriteDocument(writer, FieldValues::Extract(sample.data), sample.pluginData);
+      bench::DoNotOptimize(yaml);
+    });
+  }
+
+  return 0;
+}
@@ -0,0 +1,380 @@
+/**
+ * @file format_fields.hpp
+ * @brief System information field schema shared by the output format plugins
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details The core hands every output formatter the same flat
+ * `Map<String, String>` of system information ("host", "os", "ram", ...).
+ * This header describes those keys once: each field's map key, its display
+ * label, the section it belongs to and how its value is parsed. Formatters
+ * call FieldValues::Extract() once per document, which walks the map a single
+ * time and files every known value into a flat array indexed by FieldId, and
+ * then read fields by ID without further lookups or temporary keys.
+ *
+ * Numeric fields are converted with ParseNumber(), which wraps
+ * `std::from_chars`: it never throws, ignores the C locale and reports
+ * malformed and out-of-range values instead of silently truncating them.
+ * FieldValues::findNumber() omits such values and logs why.
+ *
+ * This directory holds no plugin of its own; format plugins include it as
+ * "../common/format_fields.hpp".
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <expected>
+#include <limits>
+#include <type_traits>
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+  #include <locale>
+  #include <sstream>
+#endif
+
+#include <Drac++/Utils/Logging.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+namespace format_fields {
+  using namespace draconis::utils::types;
+
+  /**
+   * @brief Every system information field, in document order
+   */
+  enum class FieldId : u8 {
+    Date,
+    WeatherTemperature,
+    WeatherDescription,
+    WeatherTown,
+    Host,
+    Os,
+    OsName,
+    OsVersion,
+    OsId,
+    Kernel,
+    Ram,
+    MemoryUsedBytes,
+    MemoryTotalBytes,
+    Disk,
+    DiskUsedBytes,
+    DiskTotalBytes,
+    Cpu,
+    CpuCoresPhysical,
+    CpuCoresLogical,
+    Gpu,
+    Uptime,
+    UptimeSeconds,
+    Shell,
+    Packages,
+    DesktopEnvironment,
+    WindowManager,
+  };
+
+  inline constexpr usize FIELD_COUNT = static_cast<usize>(FieldId::WindowManager) + 1;
+
+  /**
+   * @brief Group a field is listed under by the sectioned formatters
+   */
+  enum class Section : u8 {
+    General,
+    Weather,
+    System,
+    Hardware,
+    Software,
+    Environment,
+  };
+
+  /**
+   * @brief Human-readable section heading
+   */
+  constexpr auto SectionLabel(const Section section) -> StringView {
+    switch (section) {
+      case Section::General:     return "General";
+      case Section::Weather:     return "Weather";
+      case Section::System:      return "System";
+      case Section::Hardware:    return "Hardware";
+      case Section::Software:    return "Software";
+      case Section::Environment: return "Environment";
+    }
+    return {};
+  }
+
+  /**
+   * @brief How a field's string value is interpreted by formatters that emit typed output
+   */
+  enum class NumericType : u8 {
+    None, // Free text
+    U32,
+    U64,
+    I64,
+    F64,
+  };
+
+  struct FieldDescriptor {
+    FieldId     id;
+    StringView  key;   // Key in the core's data map
+    StringView  label; // Human-readable label; empty for fields only machine formats emit
+    Section     section;
+    NumericType numeric;
+  };
+
+  // clang-format off
+  inline constexpr Array<FieldDescriptor, FIELD_COUNT> FIELDS = {{
+    { FieldId::Date,               "date",                "Date",                Section::General,     NumericType::None },
+    { FieldId::WeatherTemperature, "weather_temperature", "",                    Section::Weather,     NumericType::F64  },
+    { FieldId::WeatherDescription, "weather_description", "",                    Section::Weather,     NumericType::None },
+    { FieldId::WeatherTown,        "weather_town",        "",                    Section::Weather,     NumericType::None },
+    { FieldId::Host,               "host",                "Host",                Section::System,      NumericType::None },
+    { FieldId::Os,                 "os",                  "OS",                  Section::System,      NumericType::None },
+    { FieldId::OsName,             "os_name",             "",                    Section::System,      NumericType::None },
+    { FieldId::OsVersion,          "os_version",          "",                    Section::System,      NumericType::None },
+    { FieldId::OsId,               "os_id",               "",                    Section::System,      NumericType::None },
+    { FieldId::Kernel,             "kernel",              "Kernel",              Section::System,      NumericType::None },
+    { FieldId::Ram,                "ram",                 "RAM",                 Section::Hardware,    NumericType::None },
+    { FieldId::MemoryUsedBytes,    "memory_used_bytes",   "",                    Section::Hardware,    NumericType::U64  },
+    { FieldId::MemoryTotalBytes,   "memory_total_bytes",  "",                    Section::Hardware,    NumericType::U64  },
+    { FieldId::Disk,               "disk",                "Disk",                Section::Hardware,    NumericType::None },
+    { FieldId::DiskUsedBytes,      "disk_used_bytes",     "",                    Section::Hardware,    NumericType::U64  },
+    { FieldId::DiskTotalBytes,     "disk_total_bytes",    "",                    Section::Hardware,    NumericType::U64  },
+    { FieldId::Cpu,                "cpu",                 "CPU",                 Section::Hardware,    NumericType::None },
+    { FieldId::CpuCoresPhysical,   "cpu_cores_physical",  "",                    Section::Hardware,    NumericType::U32  },
+    { FieldId::CpuCoresLogical,    "cpu_cores_logical",   "",                    Section::Hardware,    NumericType::U32  },
+    { FieldId::Gpu,                "gpu",                 "GPU",                 Section::Hardware,    NumericType::None },
+    { FieldId::Uptime,             "uptime",              "Uptime",              Section::Hardware,    NumericType::None },
+    { FieldId::UptimeSeconds,      "uptime_seconds",      "",                    Section::Hardware,    NumericType::I64  },
+    { FieldId::Shell,              "shell",               "Shell",               Section::Software,    NumericType::None },
+    { FieldId::Packages,           "packages",            "Packages",            Section::Software,    NumericType::U64  },
+    { FieldId::DesktopEnvironment, "de",                  "Desktop Environment", Section::Environment, NumericType::None },
+    { FieldId::WindowManager,      "wm",                  "Window Manager",      Section::Environment, NumericType::None },
+  }};
+  // clang-format on
+
+  constexpr auto Descriptor(const FieldId id) -> const FieldDescriptor& {
+    return FIELDS[static_cast<usize>(id)];
+  }
+
+  namespace detail {
+    constexpr auto IdsMatchPositions() -> bool {
+      for (usize index = 0; index < FIELD_COUNT; ++index)
+        if (static_cast<usize>(FIELDS[index].id) != index)
+          return false;
+      return true;
+    }
+
+    static_assert(IdsMatchPositions(), "FIELDS must list every FieldId in declaration order");
+
+    // Field IDs ordered by key, for binary search
+    inline constexpr Array<FieldId, FIELD_COUNT> BY_KEY = [] {
+      Array<FieldId, FIELD_COUNT> ids {};
+      for (usize index = 0; index < FIELD_COUNT; ++index)
+        ids[index] = FIELDS[index].id;
+      std::ranges::sort(ids, {}, [](const FieldId id) { return Descriptor(id).key; });
+      return ids;
+    }();
+
+    static_assert(
+      std::ranges::adjacent_find(BY_KEY, {}, [](const FieldId id) { return Descriptor(id).key; }) == BY_KEY.end(),
+      "Field keys must be unique"
+    );
+  } // namespace detail
+
+  /**
+   * @brief Field ID of a data map key, if it is part of the schema
+   */
+  constexpr auto FindField(const StringView key) -> Option<FieldId> {
+    const auto match = std::ranges::lower_bound(detail::BY_KEY, key, {}, [](const FieldId id) { return Descriptor(id).key; });
+    if (match == detail::BY_KEY.end() || Descriptor(*match).key != key)
+      return None;
+    return *match;
+  }
+
+  static_assert(FindField("host") == FieldId::Host && FindField("wm") == FieldId::WindowManager);
+  static_assert(!FindField("hostname") && !FindField(""));
+
+  namespace detail {
+    template <NumericType Type>
+    struct ValueOf {
+      using type = StringView;
+    };
+
+    template <>
+    struct ValueOf<NumericType::U32> {
+      using type = u32;
+    };
+
+    template <>
+    struct ValueOf<NumericType::U64> {
+      using type = u64;
+    };
+
+    template <>
+    struct ValueOf<NumericType::I64> {
+      using type = i64;
+    };
+
+    template <>
+    struct ValueOf<NumericType::F64> {
+      using type = f64;
+    };
+  } // namespace detail
+
+  /**
+   * @brief Type a field's value has in typed output: StringView for free text, else its number type
+   */
+  template <FieldId Id>
+  using FieldType = typename detail::ValueOf<Descriptor(Id).numeric>::type;
+
+  /**
+   * @brief Why a numeric field could not be converted
+   */
+  enum class NumberError : u8 {
+    Missing,    // Field absent or empty
+    Invalid,    // Not a number of the requested type (including trailing characters)
+    OutOfRange, // A number, but it does not fit the requested type
+  };
+
+  template <typename T>
+  using NumberResult = std::expected<T, NumberError>;
+
+  constexpr auto NumberErrorMessage(const NumberError error) -> StringView {
+    switch (error) {
+      case NumberError::Missing:    return "missing";
+      case NumberError::Invalid:    return "not a valid number";
+      case NumberError::OutOfRange: return "out of range";
+    }
+    return {};
+  }
+
+  /**
+   * @brief Convert a whole field value to an integer or floating-point number
+   * @details The entire value must be consumed; "12 GiB" is Invalid rather than
+   * 12, and "-1" is Invalid for unsigned types rather than wrapping around.
+   * Floating-point results must be finite.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+  auto ParseNumber(const StringView text) -> NumberResult<T> {
+    if (text.empty())
+      return std::unexpected(NumberError::Missing);
+
+    const char* const first = text.data();
+    const char* const last  = text.data() + text.size();
+    T                 result {};
+
+    if constexpr (std::is_floating_point_v<T>) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      const auto [end, errc] = std::from_chars(first, last, result);
+
+      if (errc == std::errc::result_out_of_range)
+        return std::unexpected(NumberError::OutOfRange);
+      if (errc != std::errc {} || end != last)
+        return std::unexpected(NumberError::Invalid);
+#else
+      // Standard libraries without floating-point from_chars: parse in the
+      // classic locale, so ',' is never a decimal point, after rejecting what
+      // from_chars would (a leading '+', whitespace, hexadecimal)
+      const bool foreign = text.front() == '+' || std::ranges::any_of(text, [](const char character) {
+                             return std::isspace(static_cast<unsigned char>(character)) || character == 'x' || character == 'X';
+                           });
+      if (foreign)
+        return std::unexpected(NumberError::Invalid);
+
+      std::istringstream stream { String(text) };
+      stream.imbue(std::locale::classic());
+      stream >> std::noskipws >> result;
+
+      // On overflow the stream fails and stores the largest finite value
+      if (stream.fail())
+        return std::unexpected(std::fabs(result) == std::numeric_limits<T>::max() ? NumberError::OutOfRange : NumberError::Invalid);
+      if (stream.peek() != std::char_traits<char>::eof())
+        return std::unexpected(NumberError::Invalid);
+#endif
+      if (!std::isfinite(result))
+        return std::unexpected(NumberError::OutOfRange);
+    } else {
+      const auto [end, errc] = std::from_chars(first, last, result);
+
+      if (errc == std::errc::result_out_of_range)
+        return std::unexpected(NumberError::OutOfRange);
+      if (errc != std::errc {} || end != last)
+        return std::unexpected(NumberError::Invalid);
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Every schema field of one data map, indexed by FieldId
+   * @details Holds views into the map, which must outlive this object. Empty
+   * values count as absent, as they do for every formatter.
+   */
+  class FieldValues {
+    Array<StringView, FIELD_COUNT> m_values {};
+
+   public:
+    /**
+     * @brief Walk the map once and file each known, non-empty value under its field
+     */
+    static auto Extract(const Map<String, String>& data) -> FieldValues {
+      FieldValues values;
+
+      for (const auto& [key, value] : data)
+        if (!value.empty())
+          if (const Option<FieldId> id = FindField(key))
+            values.m_values[static_cast<usize>(*id)] = value;
+
+      return values;
+    }
+
+    [[nodiscard]] auto get(const FieldId id) const -> StringView {
+      return m_values[static_cast<usize>(id)];
+    }
+
+    [[nodiscard]] auto has(const FieldId id) const -> bool {
+      return !get(id).empty();
+    }
+
+    [[nodiscard]] auto find(const FieldId id) const -> Option<StringView> {
+      return has(id) ? Option<StringView>(get(id)) : None;
+    }
+
+    /**
+     * @brief Field value converted to T, or the reason it could not be
+     */
+    template <typename T>
+    [[nodiscard]] auto number(const FieldId id) const -> NumberResult<T> {
+      return ParseNumber<T>(get(id));
+    }
+
+    /**
+     * @brief Field value converted to T, or None if it is absent or malformed
+     * @details A value that is present but cannot be converted is logged, so a
+     * field that disappears from the output always leaves a diagnostic.
+     */
+    template <typename T>
+    [[nodiscard]] auto findNumber(const FieldId id) const -> Option<T> {
+      const NumberResult<T> value = number<T>(id);
+      if (value)
+        return *value;
+
+      if (value.error() != NumberError::Missing)
+        warn_log("Omitting field '{}': value '{}' is {}", Descriptor(id).key, get(id), NumberErrorMessage(value.error()));
+      return None;
+    }
+
+    /**
+     * @brief Field value as its FieldType, or None if it is absent or malformed
+     */
+    template <FieldId Id>
+    [[nodiscard]] auto typed() const -> Option<FieldType<Id>> {
+      if constexpr (std::is_same_v<FieldType<Id>, StringView>)
+        return find(Id);
+      else
+        return findNumber<FieldType<Id>>(Id);
+    }
+  };
+} // namespace format_fields
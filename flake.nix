@@ -21,6 +21,7 @@
       "json_format"
       "markdown_format"
       "now_playing"
+      "template_format"
       "weather"
       "yaml_format"
     ];
@@ -36,36 +37,11 @@
           inherit system;
         };
 
-        dbusStatic = pkgs.pkgsStatic.dbus.overrideAttrs (old: let
-          filterAuditApparmor = builtins.filter (package: let
-            name = package.pname or "";
-          in
-            name != "audit" && name != "libapparmor");
-        in {
-          buildInputs = filterAuditApparmor (old.buildInputs or []);
-          propagatedBuildInputs = filterAuditApparmor (old.propagatedBuildInputs or []);
-          mesonFlags =
-            builtins.filter
-            (flag: !(lib.hasPrefix "-Dlibaudit" flag) && !(lib.hasPrefix "-Dapparmor" flag))
-            (old.mesonFlags or [])
-            ++ [
-              "-Dlibaudit=disabled"
-              "-Dapparmor=disabled"
-            ];
-          configureFlags =
-            builtins.filter
-            (flag: !(lib.hasPrefix "--enable-apparmor" flag) && !(lib.hasPrefix "--enable-libaudit" flag))
-            (old.configureFlags or [])
-            ++ [
-              "--disable-apparmor"
-              "--disable-libaudit"
-            ];
-        });
-
         pluginBuildInputsByName = {
           json_format = [];
           markdown_format = [];
-          now_playing = lib.optionals pkgs.stdenv.hostPlatform.isLinux [dbusStatic];
+          now_playing = lib.optionals (!pkgs.stdenv.hostPlatform.isDarwin) [pkgs.pkgsStatic.curl pkgs.stb];
+          template_format = [];
           weather = [pkgs.pkgsStatic.curl];
           yaml_format = [];
         };
@@ -100,21 +76,54 @@
               };
           in ''Coordinates { ${toString coords.lat}, ${toString coords.lon} }'';
 
+        weatherEndpointsCode = endpoints: ''
+          weather::config::MakeEndpoints(
+                "${escapeCppString (endpoints.openmeteo or "")}",
+                "${escapeCppString (endpoints.metno or "")}",
+                "${escapeCppString (endpoints.openweathermap or "")}",
+                "${escapeCppString (endpoints.unixSocket or endpoints.unix_socket or "")}",
+                "${escapeCppString (endpoints.airQuality or endpoints.air_quality or "")}"
+              )'';
+
+        weatherBaseConfigCode = weather: ''
+          weather::config::MakeConfig(
+                weather::config::Provider::${weatherProviderToEnum (weather.provider or "openmeteo")},
+                weather::config::Units::${weatherUnitsToEnum (weather.units or "metric")},
+                weather::config::${weatherLocationCode weather}${lib.optionalString ((weather ? apiKey) || (weather ? api_key)) ",\n                \"${escapeCppString (weather.apiKey or weather.api_key)}\""}
+              )'';
+
+        weatherWithEndpointsCode = weather:
+          if weather ? endpoints
+          then "weather::config::WithEndpoints(\n              ${weatherBaseConfigCode weather},\n              ${weatherEndpointsCode weather.endpoints}\n            )"
+          else weatherBaseConfigCode weather;
+
+        # airQuality accepts a boolean or { ttl = seconds; }
+        weatherConfigCode = weather: let
+          airQuality = weather.airQuality or weather.air_quality or false;
+          enabled =
+            if builtins.isBool airQuality
+            then airQuality
+            else airQuality.enable or true;
+          ttl =
+            if builtins.isAttrs airQuality
+            then airQuality.ttl or 3600
+            else 3600;
+        in
+          if enabled
+          then "weather::config::WithAirQuality(\n              ${weatherWithEndpointsCode weather},\n              ${toString ttl}\n            )"
+          else weatherWithEndpointsCode weather;
+
         weatherConfigHeader = weather: ''
           #pragma once
 
           #include "WeatherConfig.hpp"
 
           namespace draconis::config {
-            inline constexpr auto WEATHER_CONFIG = weather::config::MakeConfig(
-              weather::config::Provider::${weatherProviderToEnum (weather.provider or "openmeteo")},
-              weather::config::Units::${weatherUnitsToEnum (weather.units or "metric")},
-              weather::config::${weatherLocationCode weather}${lib.optionalString ((weather ? apiKey) || (weather ? api_key)) ",\n              \"${escapeCppString (weather.apiKey or weather.api_key)}\""}
-            );
+            inline constexpr auto WEATHER_CONFIG = ${weatherConfigCode weather};
 
             static_assert(
               weather::config::Validate(WEATHER_CONFIG),
-              "Invalid weather config: OpenMeteo/MetNo require coordinates; OpenWeatherMap requires API key and supports city names"
+              "Invalid weather config: OpenMeteo/MetNo require coordinates; OpenWeatherMap requires API key and supports city names; endpoints must be http(s) URLs"
             );
           } // namespace draconis::config
         '';
@@ -173,6 +182,7 @@
                 ''
                   runHook preInstall
                   mkdir -p "$out"
+                  cp -R common "$out/common"
                 ''
                 + builtins.concatStringsSep "\n" (map (name: ''
                     cp -R "${name}" "$out/${name}"
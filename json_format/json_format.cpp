@@ -8,56 +8,117 @@
  * It supports multiple output modes:
  * - "json": Compact JSON output
  * - "json-pretty": Pretty-printed JSON output
+ * - "jsonl": One compact document per line (NDJSON), for repeated snapshots
+ * - "json-delta": NDJSON where most lines only carry the fields that changed
+ *   since the previous call, with a full keyframe at a fixed interval
+ * - "beve": The same document in glaze's binary BEVE encoding
+ * - "cbor", "msgpack": The same document as CBOR / MessagePack
+ *
+ * CBOR and MessagePack need a glaze release that ships <glaze/cbor.hpp> and
+ * <glaze/msgpack.hpp>. Building against an older glaze is an error unless
+ * JSON_FORMAT_NO_CBOR / JSON_FORMAT_NO_MSGPACK is defined, in which case the
+ * format is not registered and asking for it fails with NotSupported.
+ *
+ * The binary formats encode exactly the object "json" produces: a map keyed
+ * by the camelCase names in glz::meta<JsonOutput>, absent fields omitted,
+ * text as UTF-8 strings, byte counts, core counts and the package count as
+ * unsigned integers, uptimeSeconds as a signed integer, weatherTemperature as
+ * a 64-bit float, and pluginFields as a map of plugin ID to a map of field
+ * name to string, number or boolean (a BEVE variant, whose index follows the
+ * alternatives of PluginFieldValue).
  *
  * This file supports both dynamic (shared library) and static compilation.
  * When compiled as a static plugin (DRAC_STATIC_PLUGIN_BUILD defined),
  * it exports factory functions in a namespace instead of extern "C".
  */
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
 #include <glaze/glaze.hpp>
 
+#ifndef JSON_FORMAT_NO_CBOR
+  #if !__has_include(<glaze/cbor.hpp>)
+    #error "The cbor format needs a glaze with <glaze/cbor.hpp>; upgrade glaze or define JSON_FORMAT_NO_CBOR"
+  #endif
+  #include <glaze/cbor.hpp>
+  #define JSON_FORMAT_HAS_CBOR 1
+#else
+  #define JSON_FORMAT_HAS_CBOR 0
+#endif
+
+#ifndef JSON_FORMAT_NO_MSGPACK
+  #if !__has_include(<glaze/msgpack.hpp>)
+    #error "The msgpack format needs a glaze with <glaze/msgpack.hpp>; upgrade glaze or define JSON_FORMAT_NO_MSGPACK"
+  #endif
+  #include <glaze/msgpack.hpp>
+  #define JSON_FORMAT_HAS_MSGPACK 1
+#else
+  #define JSON_FORMAT_HAS_MSGPACK 0
+#endif
+
 #include <Drac++/Core/Plugin.hpp>
 
 #include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Logging.hpp>
 #include <Drac++/Utils/Types.hpp>
 
+#include "../common/format_fields.hpp"
+
 namespace {
   using namespace draconis::utils::types;
   using draconis::core::plugin::PluginData;
+  using format_fields::FieldId;
+  using format_fields::FieldValues;
+  using enum draconis::utils::error::DracErrorCode;
+
+  // Every schema field of JsonOutput, in serialization order, as
+  // X(member, FieldId). The member name is also the JSON key, and its type
+  // follows the field's numeric type in the shared schema.
+  // clang-format off
+#define JSON_OUTPUT_FIELDS(X)                   \
+  X(date,               Date)                   \
+  X(host,               Host)                   \
+  X(kernelVersion,      Kernel)                 \
+  X(operatingSystem,    Os)                     \
+  X(osName,             OsName)                 \
+  X(osVersion,          OsVersion)              \
+  X(osId,               OsId)                   \
+  X(memInfo,            Ram)                    \
+  X(memUsedBytes,       MemoryUsedBytes)        \
+  X(memTotalBytes,      MemoryTotalBytes)       \
+  X(desktopEnv,         DesktopEnvironment)     \
+  X(windowMgr,          WindowManager)          \
+  X(diskUsage,          Disk)                   \
+  X(diskUsedBytes,      DiskUsedBytes)          \
+  X(diskTotalBytes,     DiskTotalBytes)         \
+  X(shell,              Shell)                  \
+  X(cpuModel,           Cpu)                    \
+  X(cpuCoresPhysical,   CpuCoresPhysical)       \
+  X(cpuCoresLogical,    CpuCoresLogical)        \
+  X(gpuModel,           Gpu)                    \
+  X(uptime,             Uptime)                 \
+  X(uptimeSeconds,      UptimeSeconds)          \
+  X(packageCount,       Packages)               \
+  X(weatherTemperature, WeatherTemperature)     \
+  X(weatherDescription, WeatherDescription)     \
+  X(weatherTown,        WeatherTown)
+  // clang-format on
 
   /**
    * @brief JSON output structure for system information
    * @details This structure mirrors the data map keys and provides
-   * proper JSON serialization via glaze
+   * proper JSON serialization via glaze. String members view the data map
+   * passed to formatOutput and are only valid for the duration of that call.
    */
   struct JsonOutput {
-    Option<String> date;
-    Option<String> host;
-    Option<String> kernelVersion;
-    Option<String> operatingSystem;
-    Option<String> osName;
-    Option<String> osVersion;
-    Option<String> osId;
-    Option<String> memInfo;
-    Option<u64>    memUsedBytes;
-    Option<u64>    memTotalBytes;
-    Option<String> desktopEnv;
-    Option<String> windowMgr;
-    Option<String> diskUsage;
-    Option<u64>    diskUsedBytes;
-    Option<u64>    diskTotalBytes;
-    Option<String> shell;
-    Option<String> cpuModel;
-    Option<u32>    cpuCoresPhysical;
-    Option<u32>    cpuCoresLogical;
-    Option<String> gpuModel;
-    Option<String> uptime;
-    Option<i64>    uptimeSeconds;
-    Option<u64>    packageCount;
-    Option<String> weatherTemperature;
-    Option<String> weatherDescription;
-    Option<String> weatherTown;
-    PluginData     pluginFields;
+#define JSON_OUTPUT_MEMBER(member, field) Option<format_fields::FieldType<FieldId::field>> member;
+    JSON_OUTPUT_FIELDS(JSON_OUTPUT_MEMBER)
+#undef JSON_OUTPUT_MEMBER
+    PluginData pluginFields;
   };
 
 } // anonymous namespace
@@ -67,41 +128,326 @@ namespace glz {
   struct meta<JsonOutput> {
     using T = JsonOutput;
 
-    // clang-format off
-    static constexpr detail::Object value = object(
-      "date",              &T::date,
-      "host",              &T::host,
-      "kernelVersion",     &T::kernelVersion,
-      "operatingSystem",   &T::operatingSystem,
-      "osName",            &T::osName,
-      "osVersion",         &T::osVersion,
-      "osId",              &T::osId,
-      "memInfo",           &T::memInfo,
-      "memUsedBytes",      &T::memUsedBytes,
-      "memTotalBytes",     &T::memTotalBytes,
-      "desktopEnv",        &T::desktopEnv,
-      "windowMgr",         &T::windowMgr,
-      "diskUsage",         &T::diskUsage,
-      "diskUsedBytes",     &T::diskUsedBytes,
-      "diskTotalBytes",    &T::diskTotalBytes,
-      "shell",             &T::shell,
-      "cpuModel",          &T::cpuModel,
-      "cpuCoresPhysical",  &T::cpuCoresPhysical,
-      "cpuCoresLogical",   &T::cpuCoresLogical,
-      "gpuModel",          &T::gpuModel,
-      "uptime",            &T::uptime,
-      "uptimeSeconds",     &T::uptimeSeconds,
-      "packageCount",      &T::packageCount,
-      "weatherTemperature",&T::weatherTemperature,
-      "weatherDescription",&T::weatherDescription,
-      "weatherTown",       &T::weatherTown,
-      "pluginFields",      &T::pluginFields
-    );
-    // clang-format on
+#define JSON_OUTPUT_META(member, field) #member, &T::member,
+    static constexpr detail::Object value = object(JSON_OUTPUT_FIELDS(JSON_OUTPUT_META) "pluginFields", &T::pluginFields);
+#undef JSON_OUTPUT_META
   };
 } // namespace glz
 
 namespace {
+  constexpr glz::opts COMPACT_OPTS = { .skip_null_members = true };
+  constexpr glz::opts PRETTY_OPTS  = { .skip_null_members = true, .prettify = true };
+  constexpr glz::opts BEVE_OPTS    = { .format = glz::BEVE, .skip_null_members = true };
+#if JSON_FORMAT_HAS_CBOR
+  constexpr glz::opts CBOR_OPTS = { .format = glz::CBOR, .skip_null_members = true };
+#endif
+#if JSON_FORMAT_HAS_MSGPACK
+  constexpr glz::opts MSGPACK_OPTS = { .format = glz::MSGPACK, .skip_null_members = true };
+#endif
+
+  template <glz::opts Opts, typename T>
+  auto Serialize(const T& value, String& buffer) -> Result<Unit> {
+    buffer.clear();
+
+    if (glz::error_ctx errorContext = glz::write<Opts>(value, buffer))
+      return Err(draconis::utils::error::DracError { draconis::utils::error::DracErrorCode::ParseError, std::format("Failed to write JSON output: {}", glz::format_error(errorContext, buffer)) });
+
+    return {};
+  }
+
+  // JSON member name of each schema field, indexed by FieldId
+  constexpr Array<StringView, format_fields::FIELD_COUNT> JSON_KEYS = [] {
+    Array<StringView, format_fields::FIELD_COUNT> keys {};
+#define JSON_OUTPUT_KEY(member, field) keys[static_cast<usize>(FieldId::field)] = #member;
+    JSON_OUTPUT_FIELDS(JSON_OUTPUT_KEY)
+#undef JSON_OUTPUT_KEY
+    return keys;
+  }();
+
+  static_assert(std::ranges::none_of(JSON_KEYS, [](const StringView key) { return key.empty(); }), "JSON_OUTPUT_FIELDS must list every schema field");
+
+  /**
+   * @brief Fill every system information member; pluginFields is left empty
+   */
+  auto MakeOutput(const FieldValues& fields) -> JsonOutput {
+    JsonOutput output;
+
+#define JSON_OUTPUT_FILL(member, field) output.member = fields.typed<FieldId::field>();
+    JSON_OUTPUT_FIELDS(JSON_OUTPUT_FILL)
+#undef JSON_OUTPUT_FILL
+
+    return output;
+  }
+
+  /**
+   * @brief Append "/segment" to a JSON Pointer (RFC 6901), escaping '~' and '/'
+   */
+  auto AppendPointerSegment(String& path, const StringView segment) -> void {
+    path += '/';
+
+    for (const char character : segment) {
+      if (character == '~')
+        path += "~0";
+      else if (character == '/')
+        path += "~1";
+      else
+        path += character;
+    }
+  }
+
+  /**
+   * @brief 64-bit FNV-1a of a serialized value; never 0, which marks an absent field
+   */
+  auto HashValue(const StringView bytes) -> u64 {
+    u64 hash = 14695981039346656037ULL;
+
+    for (const char byte : bytes) {
+      hash ^= static_cast<u8>(byte);
+      hash *= 1099511628211ULL;
+    }
+
+    return hash == 0 ? 1 : hash;
+  }
+
+  /**
+   * @brief Serialize one schema field with the type JsonOutput gives it
+   * @return Whether the field has a (valid) value; scratch holds it if so
+   */
+  auto SerializeField(const FieldValues& fields, const FieldId id, String& scratch) -> Result<bool> {
+    const auto serializeAs = [&]<typename T>(const Option<T>& value) -> Result<bool> {
+      if (!value)
+        return false;
+      TRY_VOID(Serialize<COMPACT_OPTS>(*value, scratch));
+      return true;
+    };
+
+    using format_fields::NumericType;
+
+    switch (format_fields::Descriptor(id).numeric) {
+      case NumericType::None: return serializeAs(fields.find(id));
+      case NumericType::U32:  return serializeAs(fields.findNumber<u32>(id));
+      case NumericType::U64:  return serializeAs(fields.findNumber<u64>(id));
+      case NumericType::I64:  return serializeAs(fields.findNumber<i64>(id));
+      case NumericType::F64:  return serializeAs(fields.findNumber<f64>(id));
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief State behind the "json-delta" format
+   * @details Each call produces one NDJSON line tagged with a sequence number.
+   * Every KEYFRAME_INTERVAL-th line (starting with the first) carries the full
+   * compact document under "data"; the others carry only the fields whose
+   * value changed since the previous line under "set" and the fields that
+   * disappeared under "unset", both keyed by JSON Pointer
+   * ("/host", "/pluginFields/weather/temperature"):
+   *
+   *   {"seq":0,"type":"full","data":{...}}
+   *   {"seq":1,"type":"delta","set":{"/uptimeSeconds":273660}}
+   *   {"seq":2,"type":"delta","unset":["/pluginFields/now_playing/title"]}
+   *
+   * Only a 64-bit hash of each field's serialized value is kept between calls.
+   * Each invocation of the core is a new process, so the plugin saves that
+   * state with save() after every line and restores it with load() before
+   * the first; see JsonFormatPlugin::formatDelta().
+   */
+  class DeltaEncoder {
+   public:
+    static constexpr u64 KEYFRAME_INTERVAL = 120;
+
+    [[nodiscard]] auto nextIsKeyframe() const -> bool {
+      return m_sequence % KEYFRAME_INTERVAL == 0;
+    }
+
+    /**
+     * @brief Record the snapshot and write its line
+     * @param keyframe The full compact document if nextIsKeyframe(), else None
+     */
+    auto encode(const FieldValues& fields, const PluginData& pluginData, const Option<StringView> keyframe, String& line) -> Result<Unit> {
+      const u64 sequence = m_sequence++;
+
+      m_set.clear();
+      m_unset.clear();
+
+      for (usize index = 0; index < format_fields::FIELD_COUNT; ++index) {
+        const bool present = TRY(SerializeField(fields, static_cast<FieldId>(index), m_value));
+        const u64  hash    = present ? HashValue(m_value) : 0;
+
+        if (hash != m_fieldHashes[index]) {
+          m_path.clear();
+          AppendPointerSegment(m_path, JSON_KEYS[index]);
+          TRY_VOID(present ? appendSet() : appendUnset());
+        }
+
+        m_fieldHashes[index] = hash;
+      }
+
+      for (const auto& [pluginId, pluginFields] : pluginData)
+        for (const auto& [fieldName, value] : pluginFields) {
+          m_path.clear();
+          AppendPointerSegment(m_path, "pluginFields");
+          AppendPointerSegment(m_path, pluginId);
+          AppendPointerSegment(m_path, fieldName);
+
+          TRY_VOID(Serialize<COMPACT_OPTS>(value, m_value));
+          const u64 hash = HashValue(m_value);
+
+          auto [entry, inserted] = m_pluginHashes.try_emplace(m_path);
+          if (inserted || entry->second.hash != hash)
+            TRY_VOID(appendSet());
+
+          entry->second = { .hash = hash, .sequence = sequence };
+        }
+
+      for (auto entry = m_pluginHashes.begin(); entry != m_pluginHashes.end();) {
+        if (entry->second.sequence == sequence) {
+          ++entry;
+          continue;
+        }
+
+        m_path = entry->first;
+        TRY_VOID(appendUnset());
+        entry = m_pluginHashes.erase(entry);
+      }
+
+      line = std::format(R"({{"seq":{},"type":"{}")", sequence, keyframe ? "full" : "delta");
+
+      if (keyframe) {
+        line += R"(,"data":)";
+        line += *keyframe;
+      } else {
+        if (!m_set.empty())
+          line += std::format(R"(,"set":{{{}}})", m_set);
+        if (!m_unset.empty())
+          line += std::format(R"(,"unset":[{}])", m_unset);
+      }
+
+      line += "}\n";
+      return {};
+    }
+
+    /**
+     * @brief Restore the state written by save()
+     * @details A missing, unreadable or incompatible file leaves the encoder
+     * untouched, so the next line is a keyframe at sequence 0.
+     */
+    auto load(const std::filesystem::path& path) -> Result<Unit> {
+      std::ifstream in(path, std::ios::binary);
+      if (!in)
+        ERR_FMT(NotFound, "No delta state at {}", path.string());
+
+      String magic;
+      u64    sequence   = 0;
+      usize  fieldCount = 0;
+      in >> magic >> sequence >> fieldCount;
+
+      if (!in || magic != STATE_MAGIC || fieldCount != format_fields::FIELD_COUNT)
+        ERR_FMT(ParseError, "Unrecognized delta state in {}", path.string());
+
+      Array<u64, format_fields::FIELD_COUNT> fieldHashes {};
+      for (u64& hash : fieldHashes)
+        in >> hash;
+
+      if (!in)
+        ERR_FMT(ParseError, "Truncated delta state in {}", path.string());
+
+      // One "hash sequence length path" record per plugin field; paths may hold any byte
+      std::unordered_map<String, PluginFieldState> pluginHashes;
+      PluginFieldState                             state {};
+      usize                                        length = 0;
+
+      while (in >> state.hash >> state.sequence >> length) {
+        String path(length, '\0');
+        if (in.get() != ' ' || !in.read(path.data(), static_cast<std::streamsize>(length)))
+          break;
+        pluginHashes.insert_or_assign(std::move(path), state);
+      }
+
+      if (!in.eof())
+        ERR_FMT(ParseError, "Truncated delta state in {}", path.string());
+
+      m_sequence     = sequence;
+      m_fieldHashes  = fieldHashes;
+      m_pluginHashes = std::move(pluginHashes);
+      return {};
+    }
+
+    /**
+     * @brief Write the state to `path`, replacing it atomically
+     * @details Concurrent processes each leave a complete file behind; the
+     * last one to finish wins.
+     */
+    auto save(const std::filesystem::path& path) const -> Result<Unit> {
+      namespace fs = std::filesystem;
+
+      std::error_code errc;
+      fs::create_directories(path.parent_path(), errc);
+
+      const fs::path temporary = path.string() + std::format(".{}.tmp", std::chrono::steady_clock::now().time_since_epoch().count());
+
+      {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out << STATE_MAGIC << ' ' << m_sequence << ' ' << m_fieldHashes.size() << '\n';
+        for (const u64 hash : m_fieldHashes)
+          out << hash << '\n';
+        for (const auto& [pointer, state] : m_pluginHashes)
+          out << state.hash << ' ' << state.sequence << ' ' << pointer.size() << ' ' << pointer << '\n';
+        out.close();
+
+        if (!out) {
+          fs::remove(temporary, errc);
+          ERR_FMT(IoError, "Failed to write {}", temporary.string());
+        }
+      }
+
+      fs::rename(temporary, path, errc);
+      if (errc) {
+        const String reason = errc.message();
+        fs::remove(temporary, errc);
+        ERR_FMT(IoError, "Failed to store {}: {}", path.string(), reason);
+      }
+
+      return {};
+    }
+
+   private:
+    static constexpr StringView STATE_MAGIC = "json-delta-v1";
+
+    struct PluginFieldState {
+      u64 hash;
+      u64 sequence; // Last snapshot the field was present in
+    };
+
+    u64                                          m_sequence = 0;
+    Array<u64, format_fields::FIELD_COUNT>       m_fieldHashes {};
+    std::unordered_map<String, PluginFieldState> m_pluginHashes;
+    String                                       m_path;  // Pointer of the field being compared
+    String                                       m_value; // Serialized value of that field
+    String                                       m_key;   // m_path as a JSON string
+    String                                       m_set;
+    String                                       m_unset;
+
+    auto appendSet() -> Result<Unit> {
+      TRY_VOID(Serialize<COMPACT_OPTS>(m_path, m_key));
+
+      if (!m_set.empty())
+        m_set += ',';
+      m_set += m_key;
+      m_set += ':';
+      m_set += m_value;
+      return {};
+    }
+
+    auto appendUnset() -> Result<Unit> {
+      TRY_VOID(Serialize<COMPACT_OPTS>(m_path, m_key));
+
+      if (!m_unset.empty())
+        m_unset += ',';
+      m_unset += m_key;
+      return {};
+    }
+  };
 
   class JsonFormatPlugin : public draconis::core::plugin::IOutputFormatPlugin {
    private:
@@ -111,13 +457,103 @@ namespace {
     static constexpr auto FORMAT_JSON        = "json";
     static constexpr auto FORMAT_JSON_PRETTY = "json-pretty";
 
+    static constexpr auto FORMAT_JSONL       = "jsonl";
+    static constexpr auto FORMAT_JSON_DELTA  = "json-delta";
+    static constexpr auto FORMAT_BEVE        = "beve";
+    static constexpr auto FORMAT_CBOR        = "cbor";
+    static constexpr auto FORMAT_MSGPACK     = "msgpack";
+
+    static constexpr StringView DELTA_STATE_FILE = "json_format_delta.state";
+
+    mutable std::mutex            m_deltaMutex;
+    mutable DeltaEncoder          m_delta;
+    Option<std::filesystem::path> m_deltaStatePath; // None without a cache directory
+    mutable bool                  m_deltaLoaded = false;
+
+    /**
+     * @brief Fail for a binary format this build left out, rather than emitting JSON in its place
+     */
+    static auto checkBuiltIn(const StringView formatName) -> Result<Unit> {
+      if ((!JSON_FORMAT_HAS_CBOR && formatName == FORMAT_CBOR) || (!JSON_FORMAT_HAS_MSGPACK && formatName == FORMAT_MSGPACK))
+        ERR_FMT(NotSupported, "The {} format was not built into the JSON plugin; it needs a newer glaze", formatName);
+      return {};
+    }
+
+    static auto isBinaryFormat(const StringView formatName) -> bool {
+      return formatName == FORMAT_BEVE
+#if JSON_FORMAT_HAS_CBOR
+        || formatName == FORMAT_CBOR
+#endif
+#if JSON_FORMAT_HAS_MSGPACK
+        || formatName == FORMAT_MSGPACK
+#endif
+        ;
+    }
+
+    static auto serializeBinary([[maybe_unused]] const StringView formatName, const JsonOutput& output) -> Result<String> {
+      String bytes;
+
+#if JSON_FORMAT_HAS_CBOR
+      if (formatName == FORMAT_CBOR) {
+        TRY_VOID(Serialize<CBOR_OPTS>(output, bytes));
+        return bytes;
+      }
+#endif
+#if JSON_FORMAT_HAS_MSGPACK
+      if (formatName == FORMAT_MSGPACK) {
+        TRY_VOID(Serialize<MSGPACK_OPTS>(output, bytes));
+        return bytes;
+      }
+#endif
+
+      TRY_VOID(Serialize<BEVE_OPTS>(output, bytes));
+      return bytes;
+    }
+
+    /**
+     * @brief One "json-delta" line for this snapshot (see DeltaEncoder)
+     */
+    auto formatDelta(const FieldValues& fields, const PluginData& pluginData) const -> Result<String> {
+      const std::lock_guard lock(m_deltaMutex);
+
+      // Continue from the line the previous process wrote, if any
+      if (m_deltaStatePath && !m_deltaLoaded) {
+        m_deltaLoaded = true;
+        if (Result<Unit> loaded = m_delta.load(*m_deltaStatePath); !loaded && loaded.error().code != NotFound)
+          warn_log("JSON delta state ignored, starting with a keyframe: {}", loaded.error().message);
+      }
+
+      const bool keyframe = m_delta.nextIsKeyframe();
+      String     document;
+
+      if (keyframe) {
+        JsonOutput output   = MakeOutput(fields);
+        output.pluginFields = pluginData;
+        TRY_VOID(Serialize<COMPACT_OPTS>(output, document));
+      }
+
+      String line;
+      TRY_VOID(m_delta.encode(fields, pluginData, keyframe ? Option<StringView>(document) : None, line));
+
+      // A stale state would make the next process diff against the wrong
+      // line, so one that cannot be updated is removed instead
+      if (m_deltaStatePath)
+        if (Result<Unit> saved = m_delta.save(*m_deltaStatePath); !saved) {
+          warn_log("JSON delta state not saved, the next run starts with a keyframe: {}", saved.error().message);
+          std::error_code errc;
+          std::filesystem::remove(*m_deltaStatePath, errc);
+        }
+
+      return line;
+    }
+
    public:
     JsonFormatPlugin() {
       m_metadata = {
         .name         = "JSON Format",
         .version      = "1.0.0",
         .author       = "Draconis++ Team",
-        .description  = "Provides JSON output formatting (compact and pretty-printed)",
+        .description  = "Provides JSON output formatting (compact, pretty-printed, NDJSON, delta-encoded NDJSON) and binary BEVE/CBOR/MessagePack",
         .type         = draconis::core::plugin::PluginType::OutputFormat,
         .dependencies = {}
       };
@@ -127,7 +563,10 @@ namespace {
       return m_metadata;
     }
 
-    auto initialize(const draconis::core::plugin::PluginContext& /*ctx*/, ::PluginCache& /*cache*/) -> Result<Unit> override {
+    auto initialize(const draconis::core::plugin::PluginContext& ctx, ::PluginCache& /*cache*/) -> Result<Unit> override {
+      if (!ctx.cacheDir.empty())
+        m_deltaStatePath = ctx.cacheDir / DELTA_STATE_FILE;
+
       m_ready = true;
       return {};
     }
@@ -148,101 +587,55 @@ namespace {
       if (!m_ready)
         return Err(draconis::utils::error::DracError { draconis::utils::error::DracErrorCode::Other, "JsonFormatPlugin is not ready." });
 
-      // Determine if pretty printing based on format name
-      bool prettyPrint = (formatName == FORMAT_JSON_PRETTY);
+      TRY_VOID(checkBuiltIn(formatName));
 
-      // Build the JSON output structure
-      JsonOutput output;
+      const FieldValues fields = FieldValues::Extract(data);
 
-      // Helper lambda to get optional string value
-      auto getOptional = [&data](const String& key) -> Option<String> {
-        if (auto iter = data.find(key); iter != data.end() && !iter->second.empty())
-          return iter->second;
-        return std::nullopt;
-      };
+      if (formatName == FORMAT_JSON_DELTA)
+        return formatDelta(fields, pluginData);
 
-      // Helper lambda to get optional numeric value
-      auto getOptionalU64 = [&data](const String& key) -> Option<u64> {
-        if (auto iter = data.find(key); iter != data.end() && !iter->second.empty()) {
-          try {
-            return std::stoull(iter->second);
-          } catch (...) {
-            return std::nullopt;
-          }
-        }
-        return std::nullopt;
-      };
+      JsonOutput output   = MakeOutput(fields);
+      output.pluginFields = pluginData;
 
-      auto getOptionalU32 = [&data](const String& key) -> Option<u32> {
-        if (auto iter = data.find(key); iter != data.end() && !iter->second.empty()) {
-          try {
-            return static_cast<u32>(std::stoul(iter->second));
-          } catch (...) {
-            return std::nullopt;
-          }
-        }
-        return std::nullopt;
-      };
+      // Binary encodings of the same object; the String holds raw bytes
+      if (isBinaryFormat(formatName))
+        return serializeBinary(formatName, output);
 
-      auto getOptionalI64 = [&data](const String& key) -> Option<i64> {
-        if (auto iter = data.find(key); iter != data.end() && !iter->second.empty()) {
-          try {
-            return std::stoll(iter->second);
-          } catch (...) {
-            return std::nullopt;
-          }
-        }
-        return std::nullopt;
-      };
+      String document;
+      if (formatName == FORMAT_JSON_PRETTY)
+        TRY_VOID(Serialize<PRETTY_OPTS>(output, document));
+      else
+        TRY_VOID(Serialize<COMPACT_OPTS>(output, document));
 
-      // Map data to JSON output structure
-      output.date               = getOptional("date");
-      output.host               = getOptional("host");
-      output.kernelVersion      = getOptional("kernel");
-      output.operatingSystem    = getOptional("os");
-      output.osName             = getOptional("os_name");
-      output.osVersion          = getOptional("os_version");
-      output.osId               = getOptional("os_id");
-      output.memInfo            = getOptional("ram");
-      output.memUsedBytes       = getOptionalU64("memory_used_bytes");
-      output.memTotalBytes      = getOptionalU64("memory_total_bytes");
-      output.desktopEnv         = getOptional("de");
-      output.windowMgr          = getOptional("wm");
-      output.diskUsage          = getOptional("disk");
-      output.diskUsedBytes      = getOptionalU64("disk_used_bytes");
-      output.diskTotalBytes     = getOptionalU64("disk_total_bytes");
-      output.shell              = getOptional("shell");
-      output.cpuModel           = getOptional("cpu");
-      output.cpuCoresPhysical   = getOptionalU32("cpu_cores_physical");
-      output.cpuCoresLogical    = getOptionalU32("cpu_cores_logical");
-      output.gpuModel           = getOptional("gpu");
-      output.uptime             = getOptional("uptime");
-      output.uptimeSeconds      = getOptionalI64("uptime_seconds");
-      output.packageCount       = getOptionalU64("packages");
-      output.weatherTemperature = getOptional("weather_temperature");
-      output.weatherDescription = getOptional("weather_description");
-      output.weatherTown        = getOptional("weather_town");
-      output.pluginFields       = pluginData;
-
-      // Serialize to JSON
-      String jsonStr;
-
-      glz::error_ctx errorContext = prettyPrint
-        ? glz::write<glz::opts { .skip_null_members = true, .prettify = true }>(output, jsonStr)
-        : glz::write<glz::opts { .skip_null_members = true }>(output, jsonStr);
-
-      if (errorContext)
-        return Err(draconis::utils::error::DracError { draconis::utils::error::DracErrorCode::ParseError, std::format("Failed to write JSON output: {}", glz::format_error(errorContext, jsonStr)) });
-
-      return jsonStr;
+      // NDJSON: one compact document per line
+      if (formatName == FORMAT_JSONL)
+        document += '\n';
+
+      return document;
     }
 
     [[nodiscard]] auto getFormatNames() const -> Span<const String> override {
-      static const Array<String, 2> names = { FORMAT_JSON, FORMAT_JSON_PRETTY };
+      static const Vec<String> names = {
+        FORMAT_JSON,
+        FORMAT_JSON_PRETTY,
+        FORMAT_JSONL,
+        FORMAT_JSON_DELTA,
+        FORMAT_BEVE,
+#if JSON_FORMAT_HAS_CBOR
+        FORMAT_CBOR,
+#endif
+#if JSON_FORMAT_HAS_MSGPACK
+        FORMAT_MSGPACK,
+#endif
+      };
       return names;
     }
 
-    [[nodiscard]] auto getFileExtension(const String& /*formatName*/) const -> String override {
+    [[nodiscard]] auto getFileExtension(const String& formatName) const -> String override {
+      if (formatName == FORMAT_JSONL || formatName == FORMAT_JSON_DELTA)
+        return "jsonl";
+      if (isBinaryFormat(formatName))
+        return formatName; // "beve", "cbor" and "msgpack" are their own extensions
       return "json";
     }
   };
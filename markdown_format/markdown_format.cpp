@@ -20,9 +20,14 @@
 #include <Drac++/Utils/Error.hpp>
 #include <Drac++/Utils/Types.hpp>
 
+#include "../common/format_fields.hpp"
+
 namespace {
 
   using namespace draconis::utils::types;
+  using format_fields::FieldId;
+  using format_fields::FieldValues;
+  using format_fields::Section;
 
   /**
    * @brief Zero-overhead builder for generating Markdown documents
@@ -62,14 +67,12 @@ namespace {
     }
 
     /**
-     * @brief Look up map key, check existence and empty, add line if valid
-     * @param data The data map to search
-     * @param key The key to look up
-     * @param label The display label for the line
+     * @brief Add a line for a schema field under its display label
+     * @param fields The extracted field values
+     * @param id The field to add (skipped if absent)
      */
-    auto mapEntry(const Map<String, String>& data, const String& key, std::string_view label) -> void {
-      if (auto iter = data.find(key); iter != data.end() && !iter->second.empty())
-        line(label, iter->second);
+    auto field(const FieldValues& fields, const FieldId id) -> void {
+      line(format_fields::Descriptor(id).label, fields.get(id));
     }
 
     /**
@@ -150,71 +153,59 @@ namespace {
           draconis::utils::error::DracError { draconis::utils::error::DracErrorCode::Other, "MarkdownFormatPlugin is not ready." }
         );
 
-      MarkdownBuilder builder;
+      const FieldValues fields = FieldValues::Extract(data);
+      MarkdownBuilder   builder;
 
       // 1. Title
       builder.raw("# System Information\n\n");
 
-      // 2. General Section
-      builder.section("General");
-      builder.mapEntry(data, "date", "Date");
-
-      // Weather requires special handling due to formatting logic
-      if (auto iter = data.find("weather_temperature"); iter != data.end() && !iter->second.empty()) {
-        try {
-          double temperature = std::stod(iter->second);
-          String suffix;
+      // 2. Schema fields, one section at a time in table order. Weather has no
+      // heading of its own: its one line is listed under General.
+      Option<Section> openSection;
 
-          if (auto town = data.find("weather_town"); town != data.end() && !town->second.empty())
-            suffix = std::format(" in {}", town->second);
-          else if (auto desc = data.find("weather_description"); desc != data.end() && !desc->second.empty())
-            suffix = std::format(", {}", desc->second);
+      for (const format_fields::FieldDescriptor& descriptor : format_fields::FIELDS) {
+        const Section section = descriptor.section == Section::Weather ? Section::General : descriptor.section;
 
-          builder.line("Weather", std::format("{}°{}", std::lround(temperature), suffix));
-        } catch (...) {
-          (void)0; // Ignore invalid temperature values
+        if (section != openSection) {
+          builder.section(format_fields::SectionLabel(section));
+          openSection = section;
         }
-      }
 
-      // 3. System Section
-      builder.section("System");
-      builder.mapEntry(data, "host", "Host");
-      builder.mapEntry(data, "os", "OS");
-      builder.mapEntry(data, "kernel", "Kernel");
-
-      // 4. Hardware Section
-      builder.section("Hardware");
-      builder.mapEntry(data, "ram", "RAM");
-      builder.mapEntry(data, "disk", "Disk");
-      builder.mapEntry(data, "cpu", "CPU");
-      builder.mapEntry(data, "gpu", "GPU");
-      builder.mapEntry(data, "uptime", "Uptime");
-
-      // 5. Software Section
-      builder.section("Software");
-      builder.mapEntry(data, "shell", "Shell");
-
-      // Packages requires validation (skip if zero)
-      if (auto iter = data.find("packages"); iter != data.end() && !iter->second.empty()) {
-        try {
-          if (u64 count = std::stoull(iter->second); count > 0)
-            builder.line("Packages", std::to_string(count));
-        } catch (...) {
-          (void)0; // Ignore invalid package count values
+        switch (descriptor.id) {
+          // Weather requires special handling due to formatting logic
+          case FieldId::WeatherTemperature:
+            if (const Option<f64> temperature = fields.findNumber<f64>(FieldId::WeatherTemperature)) {
+              String suffix;
+
+              if (const Option<StringView> town = fields.find(FieldId::WeatherTown))
+                suffix = std::format(" in {}", *town);
+              else if (const Option<StringView> desc = fields.find(FieldId::WeatherDescription))
+                suffix = std::format(", {}", *desc);
+
+              builder.line("Weather", std::format("{}°{}", std::lround(*temperature), suffix));
+            }
+            break;
+
+          // Packages requires validation (skip if zero)
+          case FieldId::Packages:
+            if (const Option<u64> count = fields.findNumber<u64>(FieldId::Packages); count && *count > 0)
+              builder.line(descriptor.label, std::to_string(*count));
+            break;
+
+          // Fields without a label are only emitted by the machine-readable formats
+          default:
+            if (!descriptor.label.empty())
+              builder.field(fields, descriptor.id);
+            break;
         }
       }
 
-      // 6. Environment Section
-      builder.section("Environment");
-      builder.mapEntry(data, "de", "Desktop Environment");
-      builder.mapEntry(data, "wm", "Window Manager");
-
-      // 7. Dynamic Plugin Data
+      // 3. Dynamic Plugin Data
       if (!pluginData.empty()) {
         builder.raw("## Plugin Data\n\n");
-        for (const auto& [pluginId, fields] : pluginData) {
+        for (const auto& [pluginId, pluginFields] : pluginData) {
           builder.raw(std::format("### {}\n\n", pluginId));
-          for (const auto& [fieldName, value] : fields)
+          for (const auto& [fieldName, value] : pluginFields)
             builder.raw(std::format("- **{}**: {}\n", fieldName, draconis::core::plugin::PluginFieldToString(value)));
           builder.raw("\n");
         }
@@ -11,6 +11,7 @@
  * - macOS: MediaRemote private framework
  */
 
+#include <charconv>
 #include <format>
 #include <glaze/glaze.hpp>
 #include <utility>
@@ -21,6 +22,7 @@
 #include <Drac++/Utils/Logging.hpp>
 #include <Drac++/Utils/Types.hpp>
 
+#include "now_playing_text.hpp"
 #include "now_playing_types.hpp"
 
 using namespace draconis::core::plugin;
@@ -42,7 +44,19 @@ namespace glz {
       "album",
       &T::album,
       "playerName",
-      &T::playerName
+      &T::playerName,
+      "lengthUs",
+      &T::lengthUs,
+      "trackId",
+      &T::trackId,
+      "artUrl",
+      &T::artUrl,
+      "trackNumber",
+      &T::trackNumber,
+      "artists",
+      &T::artists,
+      "url",
+      &T::url
     );
   };
 } // namespace glz
@@ -269,398 +283,1439 @@ namespace now_playing::macos {
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__DragonFly__) || defined(__NetBSD__)
 
+  #include <algorithm>
+  #include <atomic>
+  #include <cerrno>
+  #include <chrono>
   #include <cstring>
-  #include <dbus/dbus.h>
+  #include <fcntl.h>
+  #include <memory>
+  #include <mutex>
+  #include <thread>
+  #include <unistd.h>
+
+  #ifdef __linux__
+    #include <sys/eventfd.h>
+  #endif
+
+  #include "now_playing_art.hpp"
+  #include "now_playing_dbus.hpp"
+  #include "now_playing_mpd.hpp"
 
 namespace now_playing::dbus {
   /**
-   * @brief RAII wrapper for DBusError
+   * @brief Connect to the configured bus address, or the user's session bus
+   * @details An explicit address points the plugin at another bus, such as a
+   * private dbus-daemon hosting scripted players.
    */
-  class Error {
-    DBusError m_err {};
-    bool      m_isInitialized = false;
+  auto openBus(const Option<String>& address) -> Result<Connection> {
+    return address ? Connection::open(*address) : Connection::busOpenPrivate(BusType::Session);
+  }
 
-   public:
-    Error() : m_isInitialized(true) {
-      dbus_error_init(&m_err);
+  // Appearing, exiting and restarting MPRIS players
+  inline constexpr const char* PLAYER_OWNER_RULE =
+    "type='signal',sender='org.freedesktop.DBus',interface='org.freedesktop.DBus',member='NameOwnerChanged',"
+    "arg0namespace='org.mpris.MediaPlayer2'";
+
+  /**
+   * @brief A player's well-known and unique bus names
+   * @details Remembered across runs, so the next run can skip discovery, and
+   * kept by Session for every player it watches.
+   */
+  struct CachedPlayer {
+    String busName;    // Well-known name, for display and rediscovery
+    String uniqueName; // Connection name the player answered on
+
+    auto operator==(const CachedPlayer&) const -> bool = default;
+  };
+
+  /**
+   * @brief Long-lived session bus connection that reconnects when the bus drops
+   * @details The connection subscribes to NameOwnerChanged for MPRIS players,
+   * so once a full discovery has been recorded with watch(), the player list
+   * is kept current from the signals and later runs need neither ListNames
+   * nor GetNameOwner.
+   */
+  class Session {
+    Option<String>     m_address; // None: the user's session bus
+    Option<Connection> m_connection;
+    Vec<CachedPlayer>  m_players;         // Watched players, in discovery order
+    bool               m_watching = false; // The NameOwnerChanged match rule is installed
+    bool               m_current  = false; // m_players reflects the bus
+
+    auto connect() -> Result<Unit> {
+      m_connection = TRY(openBus(m_address));
+      m_players.clear();
+      m_current = false;
+
+      Result<Unit> subscribed = m_connection->addMatch(PLAYER_OWNER_RULE);
+      if (!subscribed)
+        debug_log("Now Playing: not watching player names, discovering on every run: {}", subscribed.error().message);
+
+      m_watching = subscribed.has_value();
+      return {};
     }
 
-    ~Error() {
-      if (m_isInitialized)
-        dbus_error_free(&m_err);
+    auto applyOwnerChange(const Message& message) -> void {
+      if (!message.isSignal("org.freedesktop.DBus", "NameOwnerChanged"))
+        return;
+
+      MessageIter          iter     = message.iterInit();
+      const Option<String> name     = iter.getString();
+      Option<String>       newOwner = iter.next() && iter.next() ? iter.getString() : None;
+      if (!name)
+        return;
+
+      const auto player = std::ranges::find(m_players, *name, &CachedPlayer::busName);
+
+      if (!newOwner) {
+        if (player != m_players.end())
+          m_players.erase(player);
+      } else if (player != m_players.end()) {
+        player->uniqueName = std::move(*newOwner);
+      } else {
+        m_players.push_back({ .busName = *name, .uniqueName = std::move(*newOwner) });
+      }
     }
 
-    Error(const Error&)                    = delete;
-    auto operator=(const Error&) -> Error& = delete;
+   public:
+    auto open(Option<String> address) -> Result<Unit> {
+      m_address = std::move(address);
+      return connect();
+    }
 
-    Error(Error&& other) noexcept
-      : m_err(other.m_err), m_isInitialized(other.m_isInitialized) {
-      other.m_isInitialized = false;
-      dbus_error_init(&other.m_err);
+    auto close() -> void {
+      m_connection = None;
     }
 
-    auto operator=(Error&& other) noexcept -> Error& {
-      if (this != &other) {
-        if (m_isInitialized)
-          dbus_error_free(&m_err);
-        m_err                 = other.m_err;
-        m_isInitialized       = other.m_isInitialized;
-        other.m_isInitialized = false;
-        dbus_error_init(&other.m_err);
+    /**
+     * @brief The live connection, re-established first if it was lost
+     */
+    auto get() -> Result<Connection*> {
+      if (!m_connection || !m_connection->isConnected()) {
+        if (m_connection)
+          debug_log("Now Playing: session bus connection lost, reconnecting");
+        TRY_VOID(connect());
       }
-      return *this;
-    }
 
-    [[nodiscard]] auto isSet() const -> bool {
-      return m_isInitialized && dbus_error_is_set(&m_err);
+      return &*m_connection;
     }
 
-    [[nodiscard]] auto message() const -> const char* {
-      return isSet() ? m_err.message : "";
+    /**
+     * @brief The watched players, or nullptr until a discovery has been recorded
+     * @details Applies the NameOwnerChanged signals that arrived since the last
+     * call, without waiting for more. A player that appeared moments ago may
+     * only be listed on the next call, once its signal has been delivered.
+     */
+    auto watchedPlayers() -> const Vec<CachedPlayer>* {
+      if (!m_connection)
+        return nullptr;
+
+      // A discovery is about to run, and what it lists supersedes anything queued so far
+      if (!m_current) {
+        while (m_connection->popMessage()) {}
+        return nullptr;
+      }
+
+      while (m_connection->readWrite(0)) {
+        bool received = false;
+        for (Option<Message> message = m_connection->popMessage(); message; message = m_connection->popMessage()) {
+          applyOwnerChange(*message);
+          received = true;
+        }
+        if (!received)
+          break;
+      }
+
+      return m_connection->isConnected() ? &m_players : nullptr;
     }
 
-    [[nodiscard]] auto get() -> DBusError* {
-      return &m_err;
+    /**
+     * @brief Record a full discovery as the starting point for watching
+     * @param players Every listed player, with its unique name
+     */
+    auto watch(Vec<CachedPlayer> players) -> void {
+      // Signals that arrived during discovery are applied on top by the next watchedPlayers()
+      m_players = std::move(players);
+      m_current = m_watching;
     }
   };
 
+  inline constexpr StringView  MPRIS_PREFIX       = "org.mpris.MediaPlayer2.";
+  inline constexpr const char* MPRIS_PATH         = "/org/mpris/MediaPlayer2";
+  inline constexpr const char* MPRIS_PLAYER_IFACE = "org.mpris.MediaPlayer2.Player";
+
   /**
-   * @brief RAII wrapper for DBusMessageIter
+   * @brief Extract player name from MPRIS bus name
+   * @note Bus names only hold ASCII letters, digits, '_', '-' and '.', so the
+   * name needs no repair before it is displayed.
    */
-  class MessageIter {
-    DBusMessageIter m_iter {};
-    bool            m_isValid = false;
-
-    friend class Message;
+  auto extractPlayerName(const String& busName) -> String {
+    if (busName.starts_with(MPRIS_PREFIX))
+      return busName.substr(MPRIS_PREFIX.size());
+    return busName;
+  }
 
-    explicit MessageIter(const DBusMessageIter& iter, const bool isValid)
-      : m_iter(iter), m_isValid(isValid) {}
+  auto parsePlaybackStatus(StringView status) -> PlaybackStatus {
+    if (status == "Playing")
+      return PlaybackStatus::Playing;
+    if (status == "Paused")
+      return PlaybackStatus::Paused;
+    if (status == "Stopped")
+      return PlaybackStatus::Stopped;
+    return PlaybackStatus::Unknown;
+  }
 
-    auto getBasic(RawPointer value) {
-      if (m_isValid)
-        dbus_message_iter_get_basic(&m_iter, value);
+  /**
+   * @brief The MPRIS player names in a ListNames reply
+   */
+  auto parsePlayerNames(const Message& listNamesReply) -> Result<Vec<String>> {
+    MessageIter iter = listNamesReply.iterInit();
+    if (!iter.isValid() || iter.getArgType() != TYPE_ARRAY)
+      ERR(ParseError, "Invalid DBus ListNames reply format: Expected array");
+
+    MessageIter subIter = iter.recurse();
+    if (!subIter.isValid())
+      ERR(ParseError, "Invalid DBus ListNames reply format: Could not recurse into array");
+
+    Vec<String> players;
+    while (subIter.getArgType() != TYPE_INVALID) {
+      if (Option<String> name = subIter.getString())
+        if (name->starts_with(MPRIS_PREFIX))
+          players.push_back(std::move(*name));
+      if (!subIter.next())
+        break;
     }
 
-   public:
-    MessageIter(const MessageIter&)                    = delete;
-    auto operator=(const MessageIter&) -> MessageIter& = delete;
-    MessageIter(MessageIter&&)                         = delete;
-    auto operator=(MessageIter&&) -> MessageIter&      = delete;
-    ~MessageIter()                                     = default;
+    return players;
+  }
+
+  auto newListNamesCall() -> Result<Message> {
+    return Message::newMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "ListNames");
+  }
+
+  /**
+   * @brief List the well-known bus names of every MPRIS player
+   */
+  auto listPlayers(const Connection& connection) -> Result<Vec<String>> {
+    Message listNamesMsg = TRY(newListNamesCall());
+    return parsePlayerNames(TRY(connection.sendWithReplyAndBlock(listNamesMsg, 100)));
+  }
 
-    [[nodiscard]] auto isValid() const -> bool {
-      return m_isValid;
+  /**
+   * @brief MPRIS metadata keys the decoder understands
+   */
+  enum class MetadataKey : u8 {
+    Unknown,
+    Title,
+    Album,
+    Artist,
+    Length,
+    TrackId,
+    ArtUrl,
+    TrackNumber,
+    Url,
+  };
+
+  constexpr auto Fnv1a(const StringView text) -> u64 {
+    u64 hash = 14695981039346656037ULL;
+    for (const char character : text) {
+      hash ^= static_cast<u8>(character);
+      hash *= 1099511628211ULL;
     }
+    return hash;
+  }
 
-    [[nodiscard]] auto getArgType() -> i32 {
-      return m_isValid ? dbus_message_iter_get_arg_type(&m_iter) : DBUS_TYPE_INVALID;
+  /**
+   * @brief Map a metadata key to its slot with one hash and one comparison
+   * @details The switch is over compile-time hashes of the known keys, so
+   * unknown keys are rejected without touching the heap.
+   */
+  constexpr auto lookupMetadataKey(const StringView key) -> MetadataKey {
+    const auto confirm = [&](const StringView expected, const MetadataKey result) {
+      return key == expected ? result : MetadataKey::Unknown;
+    };
+
+    switch (Fnv1a(key)) {
+      case Fnv1a("xesam:title"):       return confirm("xesam:title", MetadataKey::Title);
+      case Fnv1a("xesam:album"):       return confirm("xesam:album", MetadataKey::Album);
+      case Fnv1a("xesam:artist"):      return confirm("xesam:artist", MetadataKey::Artist);
+      case Fnv1a("mpris:length"):      return confirm("mpris:length", MetadataKey::Length);
+      case Fnv1a("mpris:trackid"):     return confirm("mpris:trackid", MetadataKey::TrackId);
+      case Fnv1a("mpris:artUrl"):      return confirm("mpris:artUrl", MetadataKey::ArtUrl);
+      case Fnv1a("xesam:trackNumber"): return confirm("xesam:trackNumber", MetadataKey::TrackNumber);
+      case Fnv1a("xesam:url"):         return confirm("xesam:url", MetadataKey::Url);
+      default:                         return MetadataKey::Unknown;
     }
+  }
+
+  static_assert(lookupMetadataKey("mpris:artUrl") == MetadataKey::ArtUrl);
+  static_assert(lookupMetadataKey("xesam:comment") == MetadataKey::Unknown);
+
+  /**
+   * @brief Store a string into an optional slot, reusing its existing buffer
+   */
+  auto assignInPlace(Option<String>& slot, const StringView value) -> void {
+    if (value.empty())
+      slot = None;
+    else if (slot)
+      slot->assign(value);
+    else
+      slot.emplace(value);
+  }
+
+  /**
+   * @brief assignInPlace() for text that is displayed, repaired as it is stored
+   * @details Done here, once per decoded string, so the listener publishes
+   * snapshots readers can show as they are.
+   */
+  auto assignText(Option<String>& slot, const StringView value) -> void {
+    assignInPlace(slot, value);
+    if (slot)
+      text::Sanitize(*slot);
+  }
+
+  /**
+   * @brief Decode an MPRIS Metadata dictionary (a{sv}) into the media fields
+   * @details Single pass over the dictionary, decoding straight into `data`.
+   * Strings are assigned into the buffers the previous track left behind, so
+   * a long-lived MediaData (as kept by the listener) stops allocating once it
+   * has seen a track of similar size. Keys the dictionary does not mention are
+   * cleared afterwards: the dictionary always describes the whole track.
+   */
+  auto decodeMetadata(MessageIter& metadataIter, MediaData& data) -> Result<Unit> {
+    if (metadataIter.getArgType() != TYPE_ARRAY || metadataIter.getElementType() != TYPE_DICT_ENTRY)
+      ERR(ParseError, "Metadata is not a dictionary array");
+
+    MessageIter dictIter = metadataIter.recurse();
+    if (!dictIter.isValid())
+      ERR(ParseError, "Could not recurse into metadata dictionary");
+
+    u16 seen = 0;
+
+    for (; dictIter.getArgType() == TYPE_DICT_ENTRY; dictIter.next()) {
+      MessageIter entryIter = dictIter.recurse();
+
+      const MetadataKey key = lookupMetadataKey(entryIter.getStringView().value_or(""));
+      if (key == MetadataKey::Unknown || !entryIter.next() || entryIter.getArgType() != TYPE_VARIANT)
+        continue;
+
+      MessageIter valueIter = entryIter.recurse();
+      seen |= static_cast<u16>(1U << std::to_underlying(key));
+
+      switch (key) {
+        case MetadataKey::Title:   assignText(data.title, valueIter.getStringView().value_or("")); break;
+        case MetadataKey::Album:   assignText(data.album, valueIter.getStringView().value_or("")); break;
+        case MetadataKey::TrackId: assignInPlace(data.trackId, valueIter.getStringView().value_or("")); break;
+        case MetadataKey::ArtUrl:  assignInPlace(data.artUrl, valueIter.getStringView().value_or("")); break;
+        case MetadataKey::Url:     assignInPlace(data.url, valueIter.getStringView().value_or("")); break;
+        case MetadataKey::Length:  data.lengthUs = valueIter.getInteger(); break;
+
+        case MetadataKey::TrackNumber:
+          if (Option<i64> number = valueIter.getInteger())
+            data.trackNumber = static_cast<i32>(*number);
+          else
+            data.trackNumber = None;
+          break;
+
+        case MetadataKey::Artist: {
+          usize count = 0;
+
+          if (valueIter.getArgType() == TYPE_ARRAY && valueIter.getElementType() == TYPE_STRING) {
+            for (MessageIter artistIter = valueIter.recurse(); artistIter.getArgType() == TYPE_STRING; artistIter.next()) {
+              const StringView artist = artistIter.getStringView().value_or("");
+              if (artist.empty())
+                continue;
+
+              if (count < data.artists.size())
+                data.artists[count].assign(artist);
+              else
+                data.artists.emplace_back(artist);
+              text::Sanitize(data.artists[count]);
+              ++count;
+            }
+          } else if (Option<StringView> artist = valueIter.getStringView(); artist && !artist->empty()) {
+            // Some players send a plain string despite the spec
+            if (data.artists.empty())
+              data.artists.emplace_back(*artist);
+            else
+              data.artists.front().assign(*artist);
+            text::Sanitize(data.artists.front());
+            count = 1;
+          }
+
+          data.artists.resize(count);
+          break;
+        }
 
-    [[nodiscard]] auto getElementType() -> i32 {
-      return m_isValid ? dbus_message_iter_get_element_type(&m_iter) : DBUS_TYPE_INVALID;
+        case MetadataKey::Unknown: break;
+      }
     }
 
-    auto next() -> bool {
-      return m_isValid && dbus_message_iter_next(&m_iter);
+    const auto wasSeen = [&](const MetadataKey key) { return (seen & (1U << std::to_underlying(key))) != 0; };
+
+    if (!wasSeen(MetadataKey::Title))
+      data.title = None;
+    if (!wasSeen(MetadataKey::Album))
+      data.album = None;
+    if (!wasSeen(MetadataKey::Artist))
+      data.artists.clear();
+    if (!wasSeen(MetadataKey::Length))
+      data.lengthUs = None;
+    if (!wasSeen(MetadataKey::TrackId))
+      data.trackId = None;
+    if (!wasSeen(MetadataKey::ArtUrl))
+      data.artUrl = None;
+    if (!wasSeen(MetadataKey::TrackNumber))
+      data.trackNumber = None;
+    if (!wasSeen(MetadataKey::Url))
+      data.url = None;
+
+    // `artist` stays the display string: every credited artist, comma separated (already repaired)
+    if (data.artists.empty()) {
+      data.artist = None;
+    } else {
+      String& joined = data.artist ? *data.artist : data.artist.emplace();
+      joined.assign(data.artists.front());
+      for (usize index = 1; index < data.artists.size(); ++index)
+        joined.append(", ").append(data.artists[index]);
     }
 
-    [[nodiscard]] auto recurse() -> MessageIter {
-      if (!m_isValid)
-        return MessageIter({}, false);
+    return {};
+  }
+
+  /**
+   * @brief Which properties a dictionary passed to decodePlayerProperties contained
+   */
+  struct PropertyChanges {
+    bool metadata = false;
+    bool position = false;
+  };
+
+  /**
+   * @brief Apply a Player interface property dictionary (a{sv}) to the media state
+   * @details Used for both Properties.GetAll replies and PropertiesChanged
+   * signals; properties that are not present are left untouched. Position is
+   * only ever present in GetAll replies, since players do not signal it.
+   */
+  auto decodePlayerProperties(MessageIter& propertiesIter, MediaData& data) -> Result<PropertyChanges> {
+    if (propertiesIter.getArgType() != TYPE_ARRAY || propertiesIter.getElementType() != TYPE_DICT_ENTRY)
+      ERR(ParseError, "Player properties are not a dictionary array");
+
+    MessageIter     dictIter = propertiesIter.recurse();
+    PropertyChanges changes;
+
+    const MonotonicClock::time_point now = MonotonicClock::now();
+
+    while (dictIter.getArgType() == TYPE_DICT_ENTRY) {
+      MessageIter    entryIter = dictIter.recurse();
+      Option<String> key       = entryIter.getString();
+
+      if (key && entryIter.next() && entryIter.getArgType() == TYPE_VARIANT) {
+        MessageIter valueIter = entryIter.recurse();
+
+        if (*key == "Metadata") {
+          TRY_VOID(decodeMetadata(valueIter, data));
+          changes.metadata = true;
+        } else if (*key == "PlaybackStatus") {
+          AnchorPosition(data, now);
+          data.status = parsePlaybackStatus(valueIter.getString().value_or(""));
+        } else if (*key == "Rate") {
+          AnchorPosition(data, now);
+          data.rate = valueIter.getDouble().value_or(1.0);
+        } else if (*key == "Position") {
+          data.positionUs        = valueIter.getInteger();
+          data.positionSampledAt = now;
+          changes.position       = true;
+        }
+      }
 
-      DBusMessageIter subIter;
-      dbus_message_iter_recurse(&m_iter, &subIter);
-      return MessageIter(subIter, true);
+      if (!dictIter.next())
+        break;
     }
 
-    [[nodiscard]] auto getString() -> Option<String> {
-      if (m_isValid && getArgType() == DBUS_TYPE_STRING) {
-        const char* strPtr = nullptr;
-        getBasic(static_cast<RawPointer>(&strPtr));
-        if (strPtr && strlen(strPtr) > 0)
-          return String(strPtr);
+    return changes;
+  }
+
+  /**
+   * @brief State of one MPRIS player
+   */
+  struct PlayerState {
+    String    busName;    // Well-known name, e.g. org.mpris.MediaPlayer2.spotify
+    String    uniqueName; // Connection name that signals are sent from, e.g. :1.42 (listener only)
+    MediaData media;
+  };
+
+  /**
+   * @brief Order players so the one to report comes first
+   * @details Playing beats paused beats stopped; ties are broken by the
+   * position of the player in the configured priority list (matched against
+   * the start of the player name, so "firefox" also covers
+   * "firefox.instance_1_42"), then by discovery order.
+   */
+  auto rankPlayers(Vec<PlayerState>& players, Span<const String> priority) -> void {
+    const auto statusRank = [](const PlaybackStatus status) -> usize {
+      switch (status) {
+        case PlaybackStatus::Playing: return 0;
+        case PlaybackStatus::Paused:  return 1;
+        case PlaybackStatus::Stopped: return 2;
+        case PlaybackStatus::Unknown: return 3;
       }
-      return None;
+      return 3;
+    };
+
+    const auto priorityRank = [&](const PlayerState& player) -> usize {
+      const StringView name = player.media.playerName ? StringView(*player.media.playerName) : StringView {};
+      for (usize index = 0; index < priority.size(); ++index)
+        if (name.starts_with(priority[index]))
+          return index;
+      return priority.size();
+    };
+
+    std::ranges::stable_sort(players, {}, [&](const PlayerState& player) {
+      return std::pair(statusRank(player.media.status), priorityRank(player));
+    });
+  }
+
+  /**
+   * @brief Query every given player with pipelined calls on one connection
+   * @details All Properties.GetAll (and, for the listener, GetNameOwner) calls
+   * are queued before any reply is awaited, so the total latency is roughly
+   * one round trip regardless of how many players are running. Players that
+   * fail to answer are skipped.
+   * @param resolveOwners Also look up each player's unique connection name
+   */
+  auto queryPlayers(const Connection& connection, Span<const String> busNames, const bool resolveOwners) -> Vec<PlayerState> {
+    struct InFlight {
+      const String*               busName;
+      Result<PendingCall>         properties;
+      Option<Result<PendingCall>> owner;
+    };
+
+    const auto send = [&](const char* destination, const char* path, const char* interface, const char* method, const char* arg)
+      -> Result<PendingCall> {
+      Message msg = TRY(Message::newMethodCall(destination, path, interface, method));
+      if (!msg.appendArgs(arg))
+        ERR_FMT(InternalError, "Failed to append arguments to {} message", method);
+      return connection.sendWithReply(msg, 100);
+    };
+
+    Vec<InFlight> calls;
+    calls.reserve(busNames.size());
+
+    for (const String& busName : busNames) {
+      InFlight& call = calls.emplace_back(
+        &busName, send(busName.c_str(), MPRIS_PATH, "org.freedesktop.DBus.Properties", "GetAll", MPRIS_PLAYER_IFACE), None
+      );
+
+      // Signals carry the sender's unique name, so the listener resolves it up front
+      if (resolveOwners)
+        call.owner = send("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "GetNameOwner", busName.c_str());
+    }
+
+    connection.flush();
+
+    Vec<PlayerState> players;
+    players.reserve(calls.size());
+
+    for (InFlight& call : calls) {
+      PlayerState player { .busName = *call.busName, .uniqueName = {}, .media = {} };
+      player.media.playerName = extractPlayerName(*call.busName);
+
+      Result<Message> reply = call.properties ? call.properties->wait() : Result<Message>(Err(call.properties.error()));
+
+      if (call.owner)
+        if (Result<Message> ownerReply = *call.owner ? (*call.owner)->wait() : Result<Message>(Err(call.owner->error())))
+          if (MessageIter ownerIter = ownerReply->iterInit(); ownerIter.isValid())
+            player.uniqueName = ownerIter.getString().value_or("");
+
+      if (!reply) {
+        debug_log("Now Playing: failed to query {}: {}", *call.busName, reply.error().message);
+        continue;
+      }
+
+      MessageIter propertiesIter = reply->iterInit();
+      if (Result<PropertyChanges> decoded = decodePlayerProperties(propertiesIter, player.media); !decoded) {
+        debug_log("Now Playing: failed to decode {}: {}", *call.busName, decoded.error().message);
+        continue;
+      }
+
+      players.push_back(std::move(player));
     }
+
+    return players;
+  }
+
+  /**
+   * @brief Fetch every MPRIS player's state, best candidate first
+   */
+  auto fetchPlayers(const Connection& connection, Span<const String> priority) -> Result<Vec<PlayerState>> {
+    Vec<String> names = TRY(listPlayers(connection));
+    if (names.empty())
+      ERR(NotFound, "No active MPRIS players found");
+
+    Vec<PlayerState> players = queryPlayers(connection, names, false);
+    if (players.empty())
+      ERR(NotFound, "No MPRIS player answered");
+
+    rankPlayers(players, priority);
+    return players;
+  }
+
+  /**
+   * @brief Players found by one discovery, before ranking
+   */
+  struct Discovery {
+    Vec<PlayerState> players;
+    usize            listed = 0; // MPRIS names ListNames returned, whether or not they answered
   };
 
   /**
-   * @brief RAII wrapper for DBusMessage
+   * @brief List and query every player, asking the remembered one alongside discovery
+   * @details The remembered player's Properties.GetAll goes out in the same
+   * round trip as ListNames, to its unique name, so a player that has exited
+   * (or restarted under a new connection) fails instead of answering for
+   * someone else. When it is the only player the run costs one round trip
+   * instead of two. Any other players are then queried as usual, with their
+   * owners resolved in the same pipeline, so the ranking, the priority list
+   * and the full player list come out the same as without a remembered player.
    */
-  class Message {
-    DBusMessage* m_msg = nullptr;
+  auto discoverPlayers(const Connection& connection, const Option<CachedPlayer>& remembered) -> Result<Discovery> {
+    Message             listNamesMsg = TRY(newListNamesCall());
+    PendingCall         listNames    = TRY(connection.sendWithReply(listNamesMsg, 100));
+    Option<PendingCall> getAll;
+
+    if (remembered) {
+      Message getAllMsg = TRY(Message::newMethodCall(remembered->uniqueName.c_str(), MPRIS_PATH, "org.freedesktop.DBus.Properties", "GetAll"));
+      if (!getAllMsg.appendArgs(MPRIS_PLAYER_IFACE))
+        ERR(InternalError, "Failed to append arguments to GetAll message");
+      getAll = TRY(connection.sendWithReply(getAllMsg, 100));
+    }
 
-   public:
-    explicit Message(DBusMessage* msg = nullptr) : m_msg(msg) {}
+    connection.flush();
 
-    ~Message() {
-      if (m_msg)
-        dbus_message_unref(m_msg);
+    Vec<String> names = TRY(parsePlayerNames(TRY(listNames.wait())));
+    Discovery   discovery { .players = {}, .listed = names.size() };
+
+    if (getAll) {
+      PlayerState player { .busName = remembered->busName, .uniqueName = remembered->uniqueName, .media = {} };
+      player.media.playerName = extractPlayerName(remembered->busName);
+
+      const Result<Message> reply   = getAll->wait();
+      bool                  decoded = false;
+
+      if (reply && std::ranges::find(names, remembered->busName) != names.end()) {
+        MessageIter iter = reply->iterInit();
+        decoded          = decodePlayerProperties(iter, player.media).has_value();
+      }
+
+      if (decoded) {
+        std::erase(names, remembered->busName);
+        discovery.players.push_back(std::move(player));
+      } else {
+        debug_log("Now Playing: {} is gone, rediscovering", remembered->busName);
+      }
     }
 
-    Message(const Message&)                    = delete;
-    auto operator=(const Message&) -> Message& = delete;
+    std::ranges::move(queryPlayers(connection, names, true), std::back_inserter(discovery.players));
+    return discovery;
+  }
 
-    Message(Message&& other) noexcept
-      : m_msg(std::exchange(other.m_msg, nullptr)) {}
+  /**
+   * @brief Fetch every player, asking the remembered one alongside discovery
+   * @see discoverPlayers
+   */
+  auto fetchPlayers(const Connection& connection, Span<const String> priority, const Option<CachedPlayer>& remembered)
+    -> Result<Vec<PlayerState>> {
+    Discovery discovery = TRY(discoverPlayers(connection, remembered));
+    if (discovery.listed == 0)
+      ERR(NotFound, "No active MPRIS players found");
+    if (discovery.players.empty())
+      ERR(NotFound, "No MPRIS player answered");
 
-    auto operator=(Message&& other) noexcept -> Message& {
-      if (this != &other) {
-        if (m_msg)
-          dbus_message_unref(m_msg);
-        m_msg = std::exchange(other.m_msg, nullptr);
+    rankPlayers(discovery.players, priority);
+    return std::move(discovery.players);
+  }
+
+  /**
+   * @brief Fetch every player over the session, from its watched names when it has them
+   * @details With a current name list the GetAll calls go out straight away,
+   * addressed by well-known name: one round trip, and none at all when no
+   * player is running. Otherwise a full discovery runs, and is recorded for
+   * the next run if every listed player answered with its owner.
+   */
+  auto fetchSessionPlayers(Session& session, const Connection& connection, Span<const String> priority, const Option<CachedPlayer>& remembered)
+    -> Result<Vec<PlayerState>> {
+    Vec<PlayerState> players;
+
+    if (const Vec<CachedPlayer>* watched = session.watchedPlayers()) {
+      if (watched->empty())
+        ERR(NotFound, "No active MPRIS players found");
+
+      Vec<String> names;
+      names.reserve(watched->size());
+      for (const CachedPlayer& player : *watched)
+        names.push_back(player.busName);
+
+      players = queryPlayers(connection, names, false);
+      for (PlayerState& player : players)
+        player.uniqueName = std::ranges::find(*watched, player.busName, &CachedPlayer::busName)->uniqueName;
+    } else {
+      Discovery discovery = TRY(discoverPlayers(connection, remembered));
+
+      if (discovery.players.size() == discovery.listed &&
+          std::ranges::none_of(discovery.players, &String::empty, &PlayerState::uniqueName)) {
+        Vec<CachedPlayer> found;
+        found.reserve(discovery.players.size());
+        for (const PlayerState& player : discovery.players)
+          found.push_back({ .busName = player.busName, .uniqueName = player.uniqueName });
+        session.watch(std::move(found));
       }
-      return *this;
+
+      if (discovery.listed == 0)
+        ERR(NotFound, "No active MPRIS players found");
+      players = std::move(discovery.players);
     }
 
-    [[nodiscard]] auto get() const -> DBusMessage* {
-      return m_msg;
+    if (players.empty())
+      ERR(NotFound, "No MPRIS player answered");
+
+    rankPlayers(players, priority);
+    return players;
+  }
+
+  /**
+   * @brief Fetch every player over a reused session connection
+   * @details A call that fails because the bus went away is retried once on a
+   * fresh connection, so a restarted session bus is picked up transparently.
+   */
+  auto fetchPlayers(Session& session, Span<const String> priority) -> Result<Vec<PlayerState>> {
+    const Connection* connection = TRY(session.get());
+
+    Result<Vec<PlayerState>> result = fetchSessionPlayers(session, *connection, priority, None);
+    if (result || connection->isConnected())
+      return result;
+
+    session.close();
+    connection = TRY(session.get());
+    return fetchSessionPlayers(session, *connection, priority, None);
+  }
+
+  /**
+   * @brief Fetch players over the session, remembering the active one for the next run
+   * @details Like the plain Session overload, a call that fails because the
+   * bus went away is retried once on a fresh connection. `remembered` is only
+   * set while it names a playing player; when nothing plays there is no likely
+   * candidate, and the run is a plain discovery. It only speeds up discovery,
+   * so it goes unused once the session watches the player names.
+   */
+  auto fetchPlayers(Session& session, Span<const String> priority, Option<CachedPlayer>& remembered) -> Result<Vec<PlayerState>> {
+    const Connection*        connection = TRY(session.get());
+    Result<Vec<PlayerState>> players    = fetchSessionPlayers(session, *connection, priority, remembered);
+
+    if (!players && !connection->isConnected()) {
+      session.close();
+      connection = TRY(session.get());
+      players    = fetchSessionPlayers(session, *connection, priority, remembered);
     }
 
-    [[nodiscard]] auto iterInit() const -> MessageIter {
-      if (!m_msg)
-        return MessageIter({}, false);
+    remembered = None;
+    if (players && players->front().media.status == PlaybackStatus::Playing && !players->front().uniqueName.empty())
+      remembered = CachedPlayer { .busName = players->front().busName, .uniqueName = players->front().uniqueName };
 
-      DBusMessageIter iter;
-      const bool      isValid = dbus_message_iter_init(m_msg, &iter);
-      return MessageIter(iter, isValid);
+    return players;
+  }
+
+  /**
+   * @brief Immutable view of every known player, published by the listener
+   */
+  struct Snapshot {
+    Vec<PlayerState> players; // Ranked, best candidate first
+
+    [[nodiscard]] auto active() const -> const PlayerState* {
+      return players.empty() ? nullptr : &players.front();
     }
+  };
 
-    template <typename... Args>
-    [[nodiscard]] auto appendArgs(Args&&... args) -> bool {
-      if (!m_msg)
-        return false;
+  /**
+   * @brief Single-writer, many-reader holder for an immutable snapshot
+   * @details Readers take a reference-counted pointer and never block the
+   * writer. Standard libraries without std::atomic<std::shared_ptr> fall back
+   * to a mutex around the pointer swap.
+   */
+  template <typename T>
+  class AtomicSnapshot {
+#if __cpp_lib_atomic_shared_ptr >= 201711L
+    std::atomic<std::shared_ptr<const T>> m_value;
 
-      DBusMessageIter iter;
-      dbus_message_iter_init_append(m_msg, &iter);
+   public:
+    [[nodiscard]] auto load() const -> std::shared_ptr<const T> {
+      return m_value.load(std::memory_order_acquire);
+    }
 
-      bool success = true;
-      ((success = success && appendArgInternal(iter, std::forward<Args>(args))), ...);
-      return success;
+    auto store(std::shared_ptr<const T> value) -> void {
+      m_value.store(std::move(value), std::memory_order_release);
     }
+#else
+    mutable std::mutex       m_mutex;
+    std::shared_ptr<const T> m_value;
 
-    static auto newMethodCall(const char* destination, const char* path, const char* interface, const char* method)
-      -> Result<Message> {
-      DBusMessage* rawMsg = dbus_message_new_method_call(destination, path, interface, method);
-      if (!rawMsg)
-        ERR(OutOfMemory, "dbus_message_new_method_call failed");
-      return Message(rawMsg);
+   public:
+    [[nodiscard]] auto load() const -> std::shared_ptr<const T> {
+      const std::lock_guard lock(m_mutex);
+      return m_value;
     }
 
-   private:
-    template <typename T>
-    auto appendArgInternal(DBusMessageIter& iter, T&& arg) -> bool {
-      using DecayedT = std::decay_t<T>;
-      if constexpr (std::is_convertible_v<DecayedT, const char*>) {
-        const char* valuePtr = static_cast<const char*>(std::forward<T>(arg));
-        return dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, static_cast<const RawPointer>(&valuePtr));
-      } else {
-        static_assert(!sizeof(T*), "Unsupported type passed to appendArgs");
-        return false;
-      }
+    auto store(std::shared_ptr<const T> value) -> void {
+      const std::lock_guard lock(m_mutex);
+      m_value = std::move(value);
     }
+#endif
   };
 
   /**
-   * @brief RAII wrapper for DBusConnection
+   * @brief File descriptor that becomes readable when the listener publishes a visible change
+   * @details An eventfd on Linux and a non-blocking pipe elsewhere. Repeated
+   * notifications coalesce until clear() drains them.
    */
-  class Connection {
-    DBusConnection* m_conn = nullptr;
+  class ChangeNotifier {
+    i32 m_readFd  = -1;
+    i32 m_writeFd = -1; // Same as m_readFd for an eventfd
 
    public:
-    explicit Connection(DBusConnection* conn = nullptr) : m_conn(conn) {}
+    auto open() -> Result<Unit> {
+      close();
+  #ifdef __linux__
+      m_readFd = m_writeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (m_readFd < 0)
+        ERR_FMT(PlatformSpecific, "eventfd() failed: {}", std::strerror(errno));
+  #else
+      Array<i32, 2> fds {};
+      if (::pipe2(fds.data(), O_NONBLOCK | O_CLOEXEC) != 0)
+        ERR_FMT(PlatformSpecific, "pipe2() failed: {}", std::strerror(errno));
+      m_readFd  = fds[0];
+      m_writeFd = fds[1];
+  #endif
+      return {};
+    }
+
+    auto close() -> void {
+      if (m_writeFd >= 0 && m_writeFd != m_readFd)
+        ::close(m_writeFd);
+      if (m_readFd >= 0)
+        ::close(m_readFd);
+      m_readFd = m_writeFd = -1;
+    }
+
+    // A full pipe or a saturated counter already reads as "changed", so failures are ignored
+    auto notify() const -> void {
+      if (m_writeFd < 0)
+        return;
+  #ifdef __linux__
+      const u64 one = 1;
+      static_cast<void>(::write(m_writeFd, &one, sizeof(one)));
+  #else
+      const u8 byte = 1;
+      static_cast<void>(::write(m_writeFd, &byte, sizeof(byte)));
+  #endif
+    }
+
+    auto clear() const -> void {
+      if (m_readFd < 0)
+        return;
+
+      Array<u8, 64> buffer {};
+      while (::read(m_readFd, buffer.data(), buffer.size()) > 0) {}
+    }
+
+    [[nodiscard]] auto fd() const -> Option<i32> {
+      return m_readFd >= 0 ? Option<i32>(m_readFd) : None;
+    }
+
+    ChangeNotifier()                                         = default;
+    ChangeNotifier(const ChangeNotifier&)                    = delete;
+    auto operator=(const ChangeNotifier&) -> ChangeNotifier& = delete;
+    ChangeNotifier(ChangeNotifier&&)                         = delete;
+    auto operator=(ChangeNotifier&&) -> ChangeNotifier&      = delete;
 
-    ~Connection() {
-      if (m_conn)
-        dbus_connection_unref(m_conn);
+    ~ChangeNotifier() {
+      close();
     }
+  };
+
+  /**
+   * @brief Background MPRIS listener backing the "events" collection mode
+   * @details Subscribes to NameOwnerChanged for org.mpris.MediaPlayer2.*, and to
+   * PropertiesChanged and Seeked on /org/mpris/MediaPlayer2, keeps every
+   * player's metadata, playback status and position sample up to date, and
+   * republishes a Snapshot on each change. Readers only ever load the
+   * snapshot, so they do no IPC. When the active player, its track or its
+   * playback status changes, the change notifier fires as well.
+   */
+  class Listener {
+    static constexpr i32 WAKE_INTERVAL_MS   = 250; // Upper bound on how long stop() waits for the thread
+    static constexpr i32 RECONNECT_DELAY_MS = 1000;
+
+    AtomicSnapshot<Snapshot> m_snapshot;
+    Vec<String>              m_priority;
+    Option<String>           m_address; // None: the user's session bus
+    ChangeNotifier           m_notifier;
+    std::jthread             m_thread;
+
+    static auto subscribe(const Connection& connection) -> Result<Unit> {
+      TRY_VOID(connection.addMatch(PLAYER_OWNER_RULE));
+      TRY_VOID(connection.addMatch(
+        "type='signal',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged',path='/org/mpris/MediaPlayer2'"
+      ));
+      TRY_VOID(connection.addMatch(
+        "type='signal',interface='org.mpris.MediaPlayer2.Player',member='Seeked',path='/org/mpris/MediaPlayer2'"
+      ));
+      return {};
+    }
+
+    /**
+     * @brief Sample a player's position with one Properties.Get call
+     * @details Players never signal Position, so the listener asks once per
+     * track; Seeked signals and local extrapolation cover the rest.
+     */
+    static auto samplePosition(const Connection& connection, PlayerState& player) -> void {
+      const auto query = [&]() -> Result<i64> {
+        Message msg = TRY(Message::newMethodCall(player.busName.c_str(), MPRIS_PATH, "org.freedesktop.DBus.Properties", "Get"));
+        if (!msg.appendArgs(MPRIS_PLAYER_IFACE, "Position"))
+          ERR(InternalError, "Failed to append arguments to Get message");
+
+        Message     reply = TRY(connection.sendWithReplyAndBlock(msg, 100));
+        MessageIter iter  = reply.iterInit();
+        if (iter.getArgType() != TYPE_VARIANT)
+          ERR(ParseError, "Position reply is not a variant");
+
+        Option<i64> position = iter.recurse().getInteger();
+        if (!position)
+          ERR(ParseError, "Position is not an integer");
+        return *position;
+      };
+
+      Result<i64> position = query();
+      if (!position)
+        debug_log("Now Playing: could not sample position of {}: {}", player.busName, position.error().message);
+
+      player.media.positionUs        = position ? Option<i64>(*position) : None;
+      player.media.positionSampledAt = MonotonicClock::now();
+    }
+
+    // Identifies the current track without keeping a copy of its metadata around
+    static auto trackFingerprint(const MediaData& media) -> u64 {
+      return Fnv1a(media.trackId.value_or("")) ^ (Fnv1a(media.title.value_or("")) * 31);
+    }
+
+    static auto scanPlayers(const Connection& connection) -> Vec<PlayerState> {
+      Result<Vec<String>> names = listPlayers(connection);
+      if (!names)
+        return {};
+
+      return queryPlayers(connection, *names, true);
+    }
+
+    /**
+     * @brief Apply one signal to the player list
+     * @return true if the published state changed
+     */
+    static auto handleSignal(const Connection& connection, const Message& message, Vec<PlayerState>& players) -> bool {
+      if (message.isSignal("org.freedesktop.DBus", "NameOwnerChanged")) {
+        MessageIter    iter     = message.iterInit();
+        Option<String> name     = iter.getString();
+        Option<String> newOwner = iter.next() && iter.next() ? iter.getString() : None;
+
+        if (!name || !name->starts_with(MPRIS_PREFIX))
+          return false;
+
+        std::erase_if(players, [&](const PlayerState& player) { return player.busName == *name; });
+
+        if (newOwner)
+          std::ranges::move(queryPlayers(connection, Span<const String>(&*name, 1), true), std::back_inserter(players));
+
+        return true;
+      }
+
+      if (message.isSignal("org.freedesktop.DBus.Properties", "PropertiesChanged")) {
+        const Option<StringView> sender = message.sender();
+        MessageIter              iter   = message.iterInit();
 
-    Connection(const Connection&)                    = delete;
-    auto operator=(const Connection&) -> Connection& = delete;
+        if (!sender || iter.getString() != MPRIS_PLAYER_IFACE || !iter.next())
+          return false;
 
-    Connection(Connection&& other) noexcept
-      : m_conn(std::exchange(other.m_conn, nullptr)) {}
+        const auto player = std::ranges::find(players, *sender, &PlayerState::uniqueName);
+        if (player == players.end())
+          return false;
 
-    auto operator=(Connection&& other) noexcept -> Connection& {
-      if (this != &other) {
-        if (m_conn)
-          dbus_connection_unref(m_conn);
-        m_conn = std::exchange(other.m_conn, nullptr);
+        const u64 previousTrack = trackFingerprint(player->media);
+
+        Result<PropertyChanges> decoded = decodePlayerProperties(iter, player->media);
+        if (!decoded)
+          debug_log("Now Playing: ignoring malformed PropertiesChanged from {}: {}", player->busName, decoded.error().message);
+        else if (decoded->metadata && !decoded->position && trackFingerprint(player->media) != previousTrack)
+          samplePosition(connection, *player);
+
+        return true;
+      }
+
+      if (message.isSignal(MPRIS_PLAYER_IFACE, "Seeked")) {
+        const Option<StringView> sender = message.sender();
+        const MessageIter        iter   = message.iterInit();
+
+        const auto player = sender ? std::ranges::find(players, *sender, &PlayerState::uniqueName) : players.end();
+        if (player == players.end())
+          return false;
+
+        player->media.positionUs        = iter.getInteger();
+        player->media.positionSampledAt = MonotonicClock::now();
+        return true;
       }
-      return *this;
+
+      return false;
     }
 
-    [[nodiscard]] auto get() const -> DBusConnection* {
-      return m_conn;
+    // The working list stays in discovery order; each published copy is ranked
+    auto publish(const Vec<PlayerState>& players) -> void {
+      Snapshot snapshot { .players = players };
+      rankPlayers(snapshot.players, m_priority);
+
+      const std::shared_ptr<const Snapshot> previous = m_snapshot.load();
+      const PlayerState*                    before   = previous ? previous->active() : nullptr;
+      const PlayerState*                    after    = snapshot.active();
+
+      const bool changed = (before == nullptr) != (after == nullptr) ||
+        (before && after && IsVisibleChange(before->media, after->media));
+
+      m_snapshot.store(std::make_shared<const Snapshot>(std::move(snapshot)));
+
+      if (changed)
+        m_notifier.notify();
     }
 
-    [[nodiscard]] auto sendWithReplyAndBlock(const Message& message, const i32 timeout_milliseconds = 1000) const
-      -> Result<Message> {
-      if (!m_conn || !message.get())
-        ERR(InvalidArgument, "Invalid connection or message");
+    auto run(const std::stop_token& stopToken, Connection connection) -> void {
+      Vec<PlayerState> players = m_snapshot.load()->players;
 
-      Error        err;
-      DBusMessage* rawReply = dbus_connection_send_with_reply_and_block(m_conn, message.get(), timeout_milliseconds, err.get());
+      while (!stopToken.stop_requested()) {
+        if (!connection.readWrite(WAKE_INTERVAL_MS)) {
+          // The bus went away: clear the state and keep trying to come back
+          publish(players = {});
+          std::this_thread::sleep_for(std::chrono::milliseconds(RECONNECT_DELAY_MS));
 
-      if (err.isSet())
-        ERR_FMT(PlatformSpecific, "DBus error: {}", err.message());
+          if (Result<Connection> reopened = openBus(m_address); reopened && subscribe(*reopened)) {
+            connection = std::move(*reopened);
+            publish(players = scanPlayers(connection));
+            debug_log("Now Playing: listener reconnected to the session bus");
+          }
+          continue;
+        }
 
-      if (!rawReply)
-        ERR(ApiUnavailable, "DBus returned null without error");
+        bool changed = false;
+        while (Option<Message> message = connection.popMessage())
+          changed = handleSignal(connection, *message, players) || changed;
 
-      return Message(rawReply);
+        if (changed)
+          publish(players);
+      }
     }
 
-    static auto busGet(const DBusBusType bus_type) -> Result<Connection> {
-      Error           err;
-      DBusConnection* rawConn = dbus_bus_get(bus_type, err.get());
+   public:
+    /**
+     * @brief Connect, subscribe and take the initial snapshot, then start listening
+     * @details Setup runs on the calling thread so failures are reported to initialize().
+     */
+    auto start(Vec<String> priority, Option<String> address) -> Result<Unit> {
+      m_priority = std::move(priority);
+      m_address  = std::move(address);
+
+      // Hosts that cannot poll an fd still get the snapshot, so this is not fatal
+      if (Result<Unit> opened = m_notifier.open(); !opened)
+        debug_log("Now Playing: change notification unavailable: {}", opened.error().message);
+
+      Connection connection = TRY(openBus(m_address));
+      TRY_VOID(subscribe(connection));
+
+      publish(scanPlayers(connection));
+
+      m_thread = std::jthread([this, conn = std::move(connection)](const std::stop_token& stopToken) mutable {
+        run(stopToken, std::move(conn));
+      });
+      return {};
+    }
 
-      if (err.isSet())
-        ERR_FMT(ApiUnavailable, "DBus bus_get failed: {}", err.message());
+    auto stop() -> void {
+      if (m_thread.joinable()) {
+        m_thread.request_stop();
+        m_thread.join();
+      }
+      m_notifier.close();
+    }
 
-      if (!rawConn)
-        ERR(ApiUnavailable, "dbus_bus_get returned null without error");
+    [[nodiscard]] auto isRunning() const -> bool {
+      return m_thread.joinable();
+    }
 
-      return Connection(rawConn);
+    [[nodiscard]] auto snapshot() const -> std::shared_ptr<const Snapshot> {
+      return m_snapshot.load();
+    }
+
+    /**
+     * @brief Descriptor that polls readable after a visible change, until clearChanges()
+     */
+    [[nodiscard]] auto changeFd() const -> Option<i32> {
+      return isRunning() ? m_notifier.fd() : None;
+    }
+
+    auto clearChanges() const -> void {
+      m_notifier.clear();
+    }
+
+    Listener()                                   = default;
+    Listener(const Listener&)                    = delete;
+    auto operator=(const Listener&) -> Listener& = delete;
+    Listener(Listener&&)                         = delete;
+    auto operator=(Listener&&) -> Listener&      = delete;
+
+    ~Listener() {
+      stop();
     }
   };
+} // namespace now_playing::dbus
 
+namespace now_playing::mpd {
   /**
-   * @brief Extract player name from MPRIS bus name
+   * @brief Background MPD client backing the "events" collection mode
+   * @details Parks its connection in `idle player`, so MPD pushes every change
+   * of song or playback state instead of being polled. Each wake-up refetches
+   * status and song with one command list and republishes the result; readers
+   * only load it. A lost connection publishes nothing (null) and is retried.
    */
-  auto extractPlayerName(const String& busName) -> String {
-    constexpr StringView prefix = "org.mpris.MediaPlayer2.";
-    if (busName.starts_with(prefix))
-      return busName.substr(prefix.size());
-    return busName;
-  }
+  class Watcher {
+    static constexpr i32 WAKE_INTERVAL_MS   = 250; // Upper bound on how long stop() waits for the thread
+    static constexpr i32 RECONNECT_DELAY_MS = 1000;
 
-  /**
-   * @brief Fetch now playing information via MPRIS/DBus
-   */
-  auto fetchNowPlaying() -> Result<MediaData> {
-    Connection connection = TRY(Connection::busGet(DBUS_BUS_SESSION));
+    dbus::AtomicSnapshot<MediaData> m_snapshot;
+    dbus::ChangeNotifier            m_notifier;
+    Endpoint                        m_endpoint;
+    std::jthread                    m_thread;
 
-    Option<String> activePlayer = None;
+    auto publish(std::shared_ptr<const MediaData> media) -> void {
+      const std::shared_ptr<const MediaData> previous = m_snapshot.load();
 
-    // Find active MPRIS player
-    {
-      Message listNamesMsg = TRY(
-        Message::newMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "ListNames")
-      );
+      const bool changed = (previous == nullptr) != (media == nullptr) || (previous && media && IsVisibleChange(*previous, *media));
 
-      Message listNamesReply = TRY(connection.sendWithReplyAndBlock(listNamesMsg, 100));
+      m_snapshot.store(std::move(media));
 
-      MessageIter iter = listNamesReply.iterInit();
-      if (!iter.isValid() || iter.getArgType() != DBUS_TYPE_ARRAY)
-        ERR(ParseError, "Invalid DBus ListNames reply format: Expected array");
+      if (changed)
+        m_notifier.notify();
+    }
+
+    auto refresh(Connection& connection) -> Result<Unit> {
+      publish(std::make_shared<const MediaData>(TRY(FetchMedia(connection))));
+      return {};
+    }
+
+    // Block in `idle player` until MPD reports a change or a stop is requested
+    static auto idle(const std::stop_token& stopToken, Connection& connection) -> Result<Unit> {
+      TRY_VOID(connection.send("idle player"));
+
+      while (!connection.waitReadable(WAKE_INTERVAL_MS))
+        if (stopToken.stop_requested())
+          return {};
+
+      return connection.receive([](StringView, StringView) {});
+    }
+
+    auto run(const std::stop_token& stopToken, Connection connection) -> void {
+      while (!stopToken.stop_requested()) {
+        Result<Unit> result = idle(stopToken, connection);
+        if (stopToken.stop_requested())
+          return;
+
+        if (result)
+          result = refresh(connection);
+
+        if (result)
+          continue;
 
-      MessageIter subIter = iter.recurse();
-      if (!subIter.isValid())
-        ERR(ParseError, "Invalid DBus ListNames reply format: Could not recurse into array");
+        debug_log("Now Playing: lost the MPD connection: {}", result.error().message);
+        publish(nullptr);
 
-      while (subIter.getArgType() != DBUS_TYPE_INVALID) {
-        if (Option<String> name = subIter.getString())
-          if (name->starts_with("org.mpris.MediaPlayer2.")) {
-            activePlayer = std::move(*name);
+        while (!stopToken.stop_requested()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(RECONNECT_DELAY_MS));
+
+          if (Result<Connection> reopened = Connection::open(m_endpoint); reopened && refresh(*reopened)) {
+            connection = std::move(*reopened);
+            debug_log("Now Playing: reconnected to MPD");
             break;
           }
-        if (!subIter.next())
-          break;
+        }
       }
     }
 
-    if (!activePlayer)
-      ERR(NotFound, "No active MPRIS players found");
+   public:
+    /**
+     * @brief Connect and take the initial state, then start listening
+     * @details Setup runs on the calling thread so failures are reported to initialize().
+     */
+    auto start(Endpoint endpoint) -> Result<Unit> {
+      m_endpoint = std::move(endpoint);
 
-    // Get metadata from active player
-    Message msg = TRY(Message::newMethodCall(activePlayer->c_str(), "/org/mpris/MediaPlayer2", "org.freedesktop.DBus.Properties", "Get"));
+      if (Result<Unit> opened = m_notifier.open(); !opened)
+        debug_log("Now Playing: change notification unavailable: {}", opened.error().message);
 
-    if (!msg.appendArgs("org.mpris.MediaPlayer2.Player", "Metadata"))
-      ERR(InternalError, "Failed to append arguments to Properties.Get message");
+      Connection connection = TRY(Connection::open(m_endpoint));
+      TRY_VOID(refresh(connection));
 
-    Message reply = TRY(connection.sendWithReplyAndBlock(msg, 100));
+      m_thread = std::jthread([this, conn = std::move(connection)](const std::stop_token& stopToken) mutable {
+        run(stopToken, std::move(conn));
+      });
+      return {};
+    }
 
-    MediaData data;
-    data.playerName = extractPlayerName(*activePlayer);
+    auto stop() -> void {
+      if (m_thread.joinable()) {
+        m_thread.request_stop();
+        m_thread.join();
+      }
+      m_notifier.close();
+    }
 
-    MessageIter propIter = reply.iterInit();
-    if (!propIter.isValid())
-      ERR(ParseError, "Properties.Get reply has no arguments");
+    [[nodiscard]] auto isRunning() const -> bool {
+      return m_thread.joinable();
+    }
 
-    if (propIter.getArgType() != DBUS_TYPE_VARIANT)
-      ERR(ParseError, "Properties.Get reply argument is not a variant");
+    [[nodiscard]] auto snapshot() const -> std::shared_ptr<const MediaData> {
+      return m_snapshot.load();
+    }
 
-    MessageIter variantIter = propIter.recurse();
-    if (!variantIter.isValid())
-      ERR(ParseError, "Could not recurse into variant");
+    [[nodiscard]] auto changeFd() const -> Option<i32> {
+      return isRunning() ? m_notifier.fd() : None;
+    }
 
-    if (variantIter.getArgType() != DBUS_TYPE_ARRAY || variantIter.getElementType() != DBUS_TYPE_DICT_ENTRY)
-      ERR(ParseError, "Metadata is not a dictionary array");
+    auto clearChanges() const -> void {
+      m_notifier.clear();
+    }
 
-    MessageIter dictIter = variantIter.recurse();
-    if (!dictIter.isValid())
-      ERR(ParseError, "Could not recurse into metadata dictionary");
+    Watcher()                                  = default;
+    Watcher(const Watcher&)                    = delete;
+    auto operator=(const Watcher&) -> Watcher& = delete;
+    Watcher(Watcher&&)                         = delete;
+    auto operator=(Watcher&&) -> Watcher&      = delete;
 
-    while (dictIter.getArgType() == DBUS_TYPE_DICT_ENTRY) {
-      MessageIter entryIter = dictIter.recurse();
-      if (!entryIter.isValid()) {
-        if (!dictIter.next())
-          break;
-        continue;
-      }
+    ~Watcher() {
+      stop();
+    }
+  };
+} // namespace now_playing::mpd
 
-      Option<String> key = entryIter.getString();
-      if (!key) {
-        if (!dictIter.next())
-          break;
-        continue;
-      }
+#endif // Linux/BSD
 
-      if (!entryIter.next() || entryIter.getArgType() != DBUS_TYPE_VARIANT) {
-        if (!dictIter.next())
-          break;
-        continue;
-      }
+namespace {
+  /**
+   * @brief Look up `key = value` in a flat TOML table
+   * @details Only what this plugin's settings need: bare booleans and numbers,
+   * and quoted strings. Comments and surrounding whitespace are ignored.
+   */
+  auto ReadConfigValue(StringView toml, StringView key) -> Option<StringView> {
+    const auto trim = [](StringView text) -> StringView {
+      const usize first = text.find_first_not_of(" \t\r");
+      if (first == StringView::npos)
+        return {};
+      return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    };
 
-      MessageIter valueVariantIter = entryIter.recurse();
-      if (!valueVariantIter.isValid()) {
-        if (!dictIter.next())
-          break;
+    while (!toml.empty()) {
+      const usize lineEnd = toml.find('\n');
+      StringView  line    = toml.substr(0, lineEnd);
+      toml                = lineEnd == StringView::npos ? StringView {} : toml.substr(lineEnd + 1);
+
+      if (const usize comment = line.find('#'); comment != StringView::npos)
+        line = line.substr(0, comment);
+
+      const usize equals = line.find('=');
+      if (equals == StringView::npos || trim(line.substr(0, equals)) != key)
         continue;
-      }
 
-      if (*key == "xesam:title") {
-        data.title = valueVariantIter.getString();
-      } else if (*key == "xesam:album") {
-        data.album = valueVariantIter.getString();
-      } else if (*key == "xesam:artist") {
-        if (valueVariantIter.getArgType() == DBUS_TYPE_ARRAY &&
-            valueVariantIter.getElementType() == DBUS_TYPE_STRING) {
-          MessageIter artistArrayIter = valueVariantIter.recurse();
-          if (artistArrayIter.isValid())
-            data.artist = artistArrayIter.getString();
-        }
-      }
+      StringView value = trim(line.substr(equals + 1));
+      if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+        value = value.substr(1, value.size() - 2);
+      return value;
+    }
 
-      if (!dictIter.next())
+    return None;
+  }
+
+  /**
+   * @brief Parse a TOML array of strings, e.g. ["spotify", "mpd"]
+   */
+  auto ReadConfigList(StringView value) -> Vec<String> {
+    Vec<String> items;
+
+    if (!value.starts_with('[') || !value.ends_with(']'))
+      return items;
+
+    value = value.substr(1, value.size() - 2);
+    while (!value.empty()) {
+      const usize open = value.find_first_of("\"'");
+      if (open == StringView::npos)
         break;
+
+      const usize close = value.find(value[open], open + 1);
+      if (close == StringView::npos)
+        break;
+
+      items.emplace_back(value.substr(open + 1, close - open - 1));
+      value = value.substr(close + 1);
     }
 
-    return data;
+    return items;
   }
-} // namespace now_playing::dbus
 
-#endif // Linux/BSD
+  auto ParseUnsigned(const StringView value) -> Option<u64> {
+    u64 result = 0;
+    if (const auto [end, errc] = std::from_chars(value.data(), value.data() + value.size(), result);
+        errc != std::errc {} || end != value.data() + value.size())
+      return None;
+    return result;
+  }
+
+  /**
+   * @brief Repair the strings a player reported before they are displayed
+   * @details MPRIS strings are repaired as they are decoded (see
+   * dbus::assignText()); this covers MPD and the other platforms' backends.
+   */
+  auto SanitizeMedia(now_playing::MediaData& data) -> void {
+    for (Option<String>* field : { &data.title, &data.artist, &data.album, &data.playerName })
+      if (*field)
+        now_playing::text::Sanitize(**field);
+
+    for (String& artist : data.artists)
+      now_playing::text::Sanitize(artist);
+  }
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+  // Last run's playing player; validated on every use, so the TTL only bounds how long a stale entry lingers
+  constexpr StringView ACTIVE_PLAYER_CACHE_KEY = "now_playing_active_player";
+  constexpr u32        ACTIVE_PLAYER_CACHE_TTL = 24 * 60 * 60;
+#endif
 
-namespace {
   class NowPlayingPlugin : public IInfoProviderPlugin {
    private:
-    PluginMetadata                m_metadata;
-    now_playing::NowPlayingConfig m_config;
-    now_playing::MediaData        m_data;
-    Option<String>                m_lastError;
-    bool                          m_ready = false;
+    PluginMetadata                                     m_metadata;
+    now_playing::NowPlayingConfig                      m_config;
+    now_playing::MediaData                             m_data;
+    Vec<now_playing::MediaData>                        m_players; // Every player, best candidate first; m_data is the first
+    Option<String>                                     m_lastError;
+    u64                                                m_generation = 0; // Bumped whenever m_data changes visibly
+#if !defined(_WIN32) && !defined(__APPLE__)
+    now_playing::dbus::Session                         m_session;
+    now_playing::dbus::Listener                        m_listener;
+    Option<now_playing::mpd::Connection>               m_mpd; // Poll mode; reopened when it drops
+    now_playing::mpd::Watcher                          m_mpdWatcher;
+    now_playing::mpd::Endpoint                         m_mpdEndpoint;
+    Option<now_playing::art::ArtCache>                 m_artCache;
+    Option<now_playing::art::ArtCache::Entry>          m_art;    // Cached album art of m_data
+    Option<String>                                     m_artUrl; // URL m_art was last resolved for
+    std::shared_ptr<const now_playing::dbus::Snapshot> m_adopted; // Events mode: the listener snapshot m_players came from
+#endif
+    bool                                               m_ready = false;
+
+    // `data` has already been through SanitizeMedia()
+    auto setActive(now_playing::MediaData data) -> void {
+      if (now_playing::IsVisibleChange(m_data, data))
+        ++m_generation;
+      m_data = std::move(data);
+    }
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // The players' strings were repaired when they were decoded
+    auto adoptPlayers(Vec<now_playing::dbus::PlayerState> players) -> void {
+      m_players.clear();
+      m_players.reserve(players.size());
+      for (now_playing::dbus::PlayerState& player : players)
+        m_players.push_back(std::move(player.media));
+
+      setActive(m_players.empty() ? now_playing::MediaData {} : m_players.front());
+      updateArt();
+    }
+
+    // A snapshot is immutable, so one adopted on an earlier run is not copied again
+    auto adoptSnapshot(std::shared_ptr<const now_playing::dbus::Snapshot> snapshot) -> void {
+      if (snapshot && snapshot == m_adopted) {
+        updateArt(); // Art still being prepared on the last run may be ready now
+        return;
+      }
+
+      adoptPlayers(snapshot ? snapshot->players : Vec<now_playing::dbus::PlayerState> {});
+      m_adopted = std::move(snapshot);
+    }
+
+    auto adoptMedia(now_playing::MediaData media) -> void {
+      SanitizeMedia(media);
+      setActive(std::move(media));
+      m_players = { m_data };
+      updateArt();
+    }
+
+    /**
+     * @brief Query MPD over the persistent connection
+     * @details A connection MPD dropped (it closes idle clients after a
+     * timeout) is reopened and the query retried once. A server that timed
+     * out is not asked again in the same run; the next run reconnects.
+     */
+    auto fetchMpd() -> Result<now_playing::MediaData> {
+      for (i32 attempt = 0;; ++attempt) {
+        if (!m_mpd || !m_mpd->isOpen())
+          m_mpd = TRY(now_playing::mpd::Connection::open(m_mpdEndpoint));
+
+        Result<now_playing::MediaData> media = now_playing::mpd::FetchMedia(*m_mpd);
+        if (media || m_mpd->isOpen() || attempt > 0 || media.error().code == Timeout)
+          return media;
+      }
+    }
+
+    auto collectMpd() -> Result<Unit> {
+      // Events mode: the watcher keeps the state current, so this is a pointer load
+      if (m_config.mode == now_playing::CollectionMode::Events) {
+        m_mpdWatcher.clearChanges();
+
+        const std::shared_ptr<const now_playing::MediaData> media = m_mpdWatcher.snapshot();
+        if (!media) {
+          m_lastError = "MPD is not reachable";
+          ERR(ApiUnavailable, "MPD is not reachable");
+        }
+
+        adoptMedia(*media);
+        return {};
+      }
+
+      Result<now_playing::MediaData> media = fetchMpd();
+      if (!media) {
+        m_lastError = media.error().message;
+        return std::unexpected(media.error());
+      }
+
+      adoptMedia(std::move(*media));
+      return {};
+    }
+
+    auto updateArt() -> void {
+      // Art already resolved for this URL is kept; a miss is asked again until its fill completes
+      if (m_art && m_artUrl == m_data.artUrl)
+        return;
+
+      m_art    = None;
+      m_artUrl = m_data.artUrl;
+      if (!m_artCache || !m_data.artUrl)
+        return;
+
+      if (Result<now_playing::art::ArtCache::Entry> entry = m_artCache->resolve(*m_data.artUrl))
+        m_art = std::move(*entry);
+      else
+        debug_log("Now Playing: album art unavailable: {}", entry.error().message);
+    }
+#endif
 
    public:
     NowPlayingPlugin() {
@@ -693,27 +1748,147 @@ namespace {
         return {};
 
       // Parse TOML config for now_playing
-      // Currently only 'enabled' field is supported
-      // Example: enabled = true
-      String configStr(tomlConfig);
+      // Example:
+      //   enabled = true
+      //   mode = "events"   # "poll" (default) or "events"
+      //   players = ["spotify", "mpd"]   # Tie-break order among equally active players
+      //   max_width = 40     # Display value budget in terminal columns, 0 for no limit
+      //   art_cache = true   # Keep album art in the cache directory (MPRIS only)
+      //   art_cache_mb = 64  # Size budget for cached art
+      //   art_size = 512     # Longest edge of cached art in pixels, 0 to keep the original
+      //   bus_address = "unix:path=/tmp/test-bus"   # Use this bus instead of the session bus (MPRIS only)
+      //   backend = "mpd"    # "mpris" (default) or "mpd" (Linux/BSD)
+      //   mpd_host = "localhost"   # Or a socket path; defaults to MPD_HOST
+      //   mpd_port = 6600          # Defaults to MPD_PORT
+      //   mpd_password = "secret"
+      if (Option<StringView> enabled = ReadConfigValue(tomlConfig, "enabled"))
+        m_config.enabled = *enabled != "false";
+
+      if (Option<StringView> mode = ReadConfigValue(tomlConfig, "mode")) {
+        if (*mode == "events")
+          m_config.mode = now_playing::CollectionMode::Events;
+        else if (*mode == "poll")
+          m_config.mode = now_playing::CollectionMode::Poll;
+        else
+          warn_log("Now Playing plugin: unknown mode '{}', using poll", *mode);
+      }
+
+      if (Option<StringView> players = ReadConfigValue(tomlConfig, "players"))
+        m_config.playerPriority = ReadConfigList(*players);
+
+      if (Option<StringView> artCache = ReadConfigValue(tomlConfig, "art_cache"))
+        m_config.artCache = *artCache == "true";
+
+      if (Option<StringView> artCacheMb = ReadConfigValue(tomlConfig, "art_cache_mb")) {
+        u64 megabytes = 0;
+        if (const auto [end, errc] = std::from_chars(artCacheMb->data(), artCacheMb->data() + artCacheMb->size(), megabytes);
+            errc == std::errc {} && end == artCacheMb->data() + artCacheMb->size() && megabytes > 0 && megabytes <= UINT64_MAX / (1024 * 1024))
+          m_config.artCacheBytes = megabytes * 1024 * 1024;
+        else
+          warn_log("Now Playing plugin: invalid art_cache_mb '{}'", *artCacheMb);
+      }
 
-      // Simple parsing - look for enabled = true/false
-      if (configStr.find("enabled = false") != String::npos || configStr.find("enabled=false") != String::npos)
-        m_config.enabled = false;
-      else if (configStr.find("enabled = true") != String::npos || configStr.find("enabled=true") != String::npos)
-        m_config.enabled = true;
+      if (Option<StringView> artSize = ReadConfigValue(tomlConfig, "art_size")) {
+        if (Option<u64> pixels = ParseUnsigned(*artSize); pixels && *pixels <= UINT16_MAX)
+          m_config.artSize = static_cast<u32>(*pixels);
+        else
+          warn_log("Now Playing plugin: invalid art_size '{}'", *artSize);
+      }
+
+      if (Option<StringView> maxWidth = ReadConfigValue(tomlConfig, "max_width")) {
+        if (Option<u64> columns = ParseUnsigned(*maxWidth))
+          m_config.maxWidth = *columns;
+        else
+          warn_log("Now Playing plugin: invalid max_width '{}'", *maxWidth);
+      }
+
+      if (Option<StringView> busAddress = ReadConfigValue(tomlConfig, "bus_address"); busAddress && !busAddress->empty())
+        m_config.busAddress = String(*busAddress);
+
+      if (Option<StringView> backend = ReadConfigValue(tomlConfig, "backend")) {
+        if (*backend == "mpd")
+          m_config.backend = now_playing::Backend::Mpd;
+        else if (*backend == "mpris")
+          m_config.backend = now_playing::Backend::Mpris;
+        else
+          warn_log("Now Playing plugin: unknown backend '{}', using mpris", *backend);
+      }
+
+      if (Option<StringView> mpdHost = ReadConfigValue(tomlConfig, "mpd_host"); mpdHost && !mpdHost->empty())
+        m_config.mpdHost = String(*mpdHost);
 
-      debug_log("Now Playing plugin: received runtime config, enabled={}", m_config.enabled);
+      if (Option<StringView> mpdPort = ReadConfigValue(tomlConfig, "mpd_port")) {
+        if (Option<u64> port = ParseUnsigned(*mpdPort); port && *port > 0 && *port <= UINT16_MAX)
+          m_config.mpdPort = static_cast<u16>(*port);
+        else
+          warn_log("Now Playing plugin: invalid mpd_port '{}'", *mpdPort);
+      }
+
+      if (Option<StringView> mpdPassword = ReadConfigValue(tomlConfig, "mpd_password"))
+        m_config.mpdPassword = String(*mpdPassword);
+
+      debug_log(
+        "Now Playing plugin: received runtime config, enabled={}, mode={}",
+        m_config.enabled,
+        m_config.mode == now_playing::CollectionMode::Events ? "events" : "poll"
+      );
       return {};
     }
 
-    auto initialize(const PluginContext& /*ctx*/, PluginCache& /*cache*/) -> Result<Unit> override {
+    auto initialize(const PluginContext& ctx, PluginCache& /*cache*/) -> Result<Unit> override {
       // Config already set via setConfig() or defaults to enabled=true
+#if !defined(_WIN32) && !defined(__APPLE__)
+      if (m_config.enabled && m_config.artCache)
+        m_artCache.emplace(ctx.cacheDir / "now_playing_art", m_config.artCacheBytes, m_config.artSize);
+
+      if (m_config.enabled && m_config.backend == now_playing::Backend::Mpd) {
+        m_mpdEndpoint = now_playing::mpd::ResolveEndpoint(m_config.mpdHost, m_config.mpdPort, m_config.mpdPassword);
+
+        if (m_config.mode == now_playing::CollectionMode::Events)
+          if (Result<Unit> started = m_mpdWatcher.start(m_mpdEndpoint); !started) {
+            warn_log("Now Playing: could not start MPD watcher, falling back to polling: {}", started.error().message);
+            m_config.mode = now_playing::CollectionMode::Poll;
+          }
+
+        m_ready = true;
+        return {};
+      }
+
+      if (m_config.enabled && m_config.mode == now_playing::CollectionMode::Events) {
+        if (Result<Unit> started = m_listener.start(m_config.playerPriority, m_config.busAddress); !started) {
+          warn_log("Now Playing: could not start MPRIS listener, falling back to polling: {}", started.error().message);
+          m_config.mode = now_playing::CollectionMode::Poll;
+        }
+      }
+
+      // Open the session bus connection once; collectData reuses it. Failure is not
+      // fatal - the next collection retries, so a bus that starts later is picked up.
+      if (m_config.enabled && m_config.mode == now_playing::CollectionMode::Poll)
+        if (Result<Unit> opened = m_session.open(m_config.busAddress); !opened)
+          debug_log("Now Playing: session bus unavailable at startup: {}", opened.error().message);
+#else
+      static_cast<void>(ctx);
+      if (m_config.mode == now_playing::CollectionMode::Events)
+        debug_log("Now Playing: events mode is only available with MPRIS, polling instead");
+      if (m_config.backend == now_playing::Backend::Mpd)
+        warn_log("Now Playing: the MPD backend is only available on Linux/BSD");
+#endif
+
       m_ready = true;
       return {};
     }
 
     auto shutdown() -> Unit override {
+#if !defined(_WIN32) && !defined(__APPLE__)
+      m_listener.stop();
+      m_session.close();
+      m_mpdWatcher.stop();
+      m_mpd      = None;
+      m_artCache = None;
+      m_art      = None;
+      m_artUrl   = None;
+      m_adopted  = nullptr;
+#endif
       m_ready = false;
     }
 
@@ -725,7 +1900,7 @@ namespace {
       return m_config.enabled;
     }
 
-    auto collectData(PluginCache& /*cache*/) -> Result<Unit> override {
+    auto collectData(PluginCache& cache) -> Result<Unit> override {
       if (!m_ready)
         ERR(NotSupported, "Now Playing plugin is not ready");
 
@@ -736,23 +1911,64 @@ namespace {
 
       m_lastError = None;
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+      if (m_config.backend == now_playing::Backend::Mpd)
+        return collectMpd();
+
+      // Events mode: the listener keeps the snapshot current, so this is a pointer load
+      if (m_config.mode == now_playing::CollectionMode::Events) {
+        // Drain before loading, so a change published in between leaves the fd readable
+        m_listener.clearChanges();
+        adoptSnapshot(m_listener.snapshot());
+
+        if (m_players.empty()) {
+          m_lastError = "No active MPRIS players found";
+          ERR(NotFound, "No active MPRIS players found");
+        }
+
+        return {};
+      }
+
+      // Poll mode: query every player at once and rank them, asking last run's player in the discovery round trip.
+      // An entry with no unique name records that nothing was playing.
+      Option<now_playing::dbus::CachedPlayer> cached = cache.get<now_playing::dbus::CachedPlayer>(String(ACTIVE_PLAYER_CACHE_KEY));
+      if (cached && cached->uniqueName.empty())
+        cached = None;
+
+      Option<now_playing::dbus::CachedPlayer> remembered = cached;
+
+      auto players = now_playing::dbus::fetchPlayers(m_session, m_config.playerPriority, remembered);
+      if (!players) {
+        m_lastError = players.error().message;
+        return std::unexpected(players.error());
+      }
+
+      if (remembered != cached)
+        cache.set(String(ACTIVE_PLAYER_CACHE_KEY), remembered.value_or(now_playing::dbus::CachedPlayer {}), ACTIVE_PLAYER_CACHE_TTL);
+
+      adoptPlayers(std::move(*players));
+      return {};
+#else
+      static_cast<void>(cache);
+
       // Fetch fresh data using platform-specific implementation (no caching - media changes too frequently)
-#ifdef _WIN32
+  #ifdef _WIN32
       auto result = now_playing::npsm::FetchNowPlaying();
-#elif defined(__APPLE__)
+  #else
       auto result = now_playing::macos::fetchNowPlaying();
-#else
-      auto result = now_playing::dbus::fetchNowPlaying();
-#endif
+  #endif
 
       if (!result) {
         m_lastError = result.error().message;
         return std::unexpected(result.error());
       }
 
-      m_data = *result;
+      SanitizeMedia(*result);
+      setActive(std::move(*result));
+      m_players = { m_data };
 
       return {};
+#endif
     }
 
     [[nodiscard]] auto getFields() const -> PluginFields override {
@@ -770,6 +1986,76 @@ namespace {
       if (m_data.playerName)
         fields["player"] = *m_data.playerName;
 
+      if (Option<StringView> status = now_playing::PlaybackStatusName(m_data.status))
+        fields["status"] = String(*status);
+
+      if (m_data.lengthUs)
+        fields["length"] = static_cast<f64>(*m_data.lengthUs) / 1'000'000.0;
+
+      // Extrapolated on every call, so frequent refreshes cost no IPC
+      if (Option<i64> position = now_playing::ExtrapolatePosition(m_data, now_playing::MonotonicClock::now())) {
+        fields["position"] = static_cast<f64>(*position) / 1'000'000.0;
+
+        if (m_data.lengthUs && *m_data.lengthUs > 0)
+          fields["progress"] = 100.0 * static_cast<f64>(*position) / static_cast<f64>(*m_data.lengthUs); // Percent
+      }
+
+      if (m_data.trackNumber)
+        fields["track_number"] = std::to_string(*m_data.trackNumber);
+
+      if (m_data.trackId)
+        fields["track_id"] = *m_data.trackId;
+
+      if (m_data.artUrl)
+        fields["art_url"] = *m_data.artUrl;
+
+      if (m_data.url)
+        fields["url"] = *m_data.url;
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+      if (m_art) {
+        fields["art_path"]   = m_art->path.string();
+        fields["art_width"]  = std::to_string(m_art->info.width);
+        fields["art_height"] = std::to_string(m_art->info.height);
+      }
+#endif
+
+      // A host can sleep in poll() on change_fd (events mode only) and re-render when
+      // generation moves; collectData clears the fd
+      fields["generation"] = std::to_string(m_generation);
+#if !defined(_WIN32) && !defined(__APPLE__)
+      if (Option<i32> changeFd = m_config.backend == now_playing::Backend::Mpd ? m_mpdWatcher.changeFd() : m_listener.changeFd())
+        fields["change_fd"] = std::to_string(*changeFd);
+#endif
+
+      // Every player in rank order: "players" lists their names, player_<n>_* their details
+      fields["player_count"] = std::to_string(m_players.size());
+
+      String playerNames;
+      for (usize index = 0; index < m_players.size(); ++index) {
+        const now_playing::MediaData& player = m_players[index];
+        const String                  prefix = std::format("player_{}_", index + 1);
+
+        if (player.playerName) {
+          if (!playerNames.empty())
+            playerNames += ", ";
+          playerNames += *player.playerName;
+          fields[prefix + "name"] = *player.playerName;
+        }
+
+        if (player.title)
+          fields[prefix + "title"] = *player.title;
+
+        if (player.artist)
+          fields[prefix + "artist"] = *player.artist;
+
+        if (Option<StringView> status = now_playing::PlaybackStatusName(player.status))
+          fields[prefix + "status"] = String(*status);
+      }
+
+      if (!playerNames.empty())
+        fields["players"] = std::move(playerNames);
+
       return fields;
     }
 
@@ -777,10 +2063,12 @@ namespace {
       if (!m_data.title)
         ERR(NotFound, "No media currently playing");
 
-      if (m_data.artist)
-        return std::format("{} - {}", *m_data.artist, *m_data.title);
+      String value = m_data.artist ? std::format("{} - {}", *m_data.artist, *m_data.title) : *m_data.title;
+
+      if (m_config.maxWidth > 0)
+        return now_playing::text::Truncate(value, m_config.maxWidth);
 
-      return *m_data.title;
+      return value;
     }
 
     [[nodiscard]] auto getDisplayIcon() const -> String override {
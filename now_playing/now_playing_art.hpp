@@ -0,0 +1,786 @@
+/**
+ * @file now_playing_art.hpp
+ * @brief On-disk album art cache for the Now Playing plugin (Linux/BSD)
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details MPRIS players publish cover art as an `mpris:artUrl`, either a
+ * file:// path (often a temporary file the player deletes later) or an
+ * http(s):// URL. The cache copies the image once per track into
+ * `<cacheDir>/now_playing_art/<key>.<ext>` and from then on hands out that
+ * stable path. The key covers the thumbnail size and the source: the URL for
+ * remote art, and path, size and modification time for local files, so a
+ * player that rewrites a fixed file:// path gets a new entry.
+ *
+ * A miss is filled on a background thread - the local file is read, or the
+ * URL fetched with libcurl, then downscaled and stored - and resolve()
+ * reports the art as not ready until it is done, so collection never waits
+ * on the network or on image decoding. Resolving the art of the track that
+ * is already playing costs a stat() of the cached file, plus one of the
+ * source for local art.
+ *
+ * Images larger than the thumbnail size are decoded with stb_image, shrunk
+ * with a box filter and re-encoded (JPEG stays JPEG, everything else becomes
+ * PNG). WebP, which stb_image cannot decode, and images within the size are
+ * stored as published. The directory is kept under a size budget by evicting
+ * the least recently used files (by modification time, which is refreshed on
+ * use), so several Draconis++ processes can share it without coordination.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <curl/curl.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <stop_token>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+// stb is compiled into this translation unit with internal linkage, limited to
+// the formats ProbeImage() recognises that it can decode
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_GIF
+#define STBI_ONLY_BMP
+#include <stb_image.h>
+
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STBI_WRITE_NO_STDIO
+#include <stb_image_write.h>
+
+#include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+namespace now_playing::art {
+  using namespace draconis::utils::types;
+  using draconis::utils::error::DracError;
+  using enum draconis::utils::error::DracErrorCode;
+
+  namespace fs = std::filesystem;
+
+  inline constexpr usize MAX_IMAGE_BYTES        = 16 * 1024 * 1024; // Larger art is refused rather than cached
+  inline constexpr u64   DEFAULT_CACHE_BYTES    = 64 * 1024 * 1024;
+  inline constexpr u32   DEFAULT_THUMBNAIL_SIZE = 512;              // Longest edge, in pixels
+  inline constexpr i64   FETCH_TIMEOUT_SECS     = 3;
+  inline constexpr u64   MAX_DECODE_PIXELS      = 16ULL * 1024 * 1024; // 4096x4096; larger art is stored without downscaling
+  inline constexpr i32   THUMBNAIL_JPEG_QUALITY = 90;
+
+  // Refreshing the LRU timestamp on every hit would cost a syscall per render;
+  // once per interval is precise enough for eviction
+  inline constexpr auto TOUCH_INTERVAL = std::chrono::minutes(10);
+
+  // A temporary file younger than this may still be written by another
+  // process; older ones were left behind by a crash and are fair game
+  inline constexpr auto TEMPORARY_GRACE = std::chrono::minutes(1);
+
+  enum class ImageFormat : u8 {
+    Png,
+    Jpeg,
+    Gif,
+    WebP,
+    Bmp,
+  };
+
+  struct ImageInfo {
+    ImageFormat format;
+    u32         width;
+    u32         height;
+  };
+
+  constexpr auto Extension(const ImageFormat format) -> StringView {
+    switch (format) {
+      case ImageFormat::Png:  return "png";
+      case ImageFormat::Jpeg: return "jpg";
+      case ImageFormat::Gif:  return "gif";
+      case ImageFormat::WebP: return "webp";
+      case ImageFormat::Bmp:  return "bmp";
+    }
+    return "img";
+  }
+
+  inline constexpr Array<ImageFormat, 5> ALL_FORMATS = {
+    ImageFormat::Png, ImageFormat::Jpeg, ImageFormat::Gif, ImageFormat::WebP, ImageFormat::Bmp,
+  };
+
+  namespace detail {
+    constexpr auto LoadBE16(Span<const u8> bytes, const usize at) -> u32 {
+      return (static_cast<u32>(bytes[at]) << 8) | bytes[at + 1];
+    }
+
+    constexpr auto LoadBE32(Span<const u8> bytes, const usize at) -> u32 {
+      return (LoadBE16(bytes, at) << 16) | LoadBE16(bytes, at + 2);
+    }
+
+    constexpr auto LoadLE16(Span<const u8> bytes, const usize at) -> u32 {
+      return bytes[at] | (static_cast<u32>(bytes[at + 1]) << 8);
+    }
+
+    constexpr auto LoadLE24(Span<const u8> bytes, const usize at) -> u32 {
+      return LoadLE16(bytes, at) | (static_cast<u32>(bytes[at + 2]) << 16);
+    }
+
+    constexpr auto LoadLE32(Span<const u8> bytes, const usize at) -> u32 {
+      return LoadLE16(bytes, at) | (LoadLE16(bytes, at + 2) << 16);
+    }
+
+    constexpr auto StartsWith(Span<const u8> bytes, const StringView magic, const usize at = 0) -> bool {
+      if (bytes.size() < at + magic.size())
+        return false;
+      for (usize index = 0; index < magic.size(); ++index)
+        if (bytes[at + index] != static_cast<u8>(magic[index]))
+          return false;
+      return true;
+    }
+
+    // Walk the JPEG marker segments up to the first start-of-frame
+    constexpr auto ProbeJpeg(Span<const u8> bytes) -> Option<ImageInfo> {
+      usize cursor = 2;
+
+      while (cursor + 4 <= bytes.size()) {
+        if (bytes[cursor] != 0xFF)
+          return None;
+
+        const u8 marker = bytes[cursor + 1];
+
+        // Fill bytes and markers without a length field
+        if (marker == 0xFF) {
+          ++cursor;
+          continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+          cursor += 2;
+          continue;
+        }
+
+        const u32 length = LoadBE16(bytes, cursor + 2);
+        if (length < 2)
+          return None;
+
+        // SOF0..SOF15, except DHT (C4), JPG (C8) and DAC (CC)
+        const bool isFrame = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        if (isFrame) {
+          if (cursor + 9 > bytes.size())
+            return None;
+          return ImageInfo { .format = ImageFormat::Jpeg, .width = LoadBE16(bytes, cursor + 7), .height = LoadBE16(bytes, cursor + 5) };
+        }
+
+        cursor += 2 + length;
+      }
+
+      return None;
+    }
+
+    constexpr auto ProbeWebP(Span<const u8> bytes) -> Option<ImageInfo> {
+      if (bytes.size() < 30)
+        return None;
+
+      if (StartsWith(bytes, "VP8 ", 12))
+        return ImageInfo { .format = ImageFormat::WebP, .width = LoadLE16(bytes, 26) & 0x3FFF, .height = LoadLE16(bytes, 28) & 0x3FFF };
+
+      if (StartsWith(bytes, "VP8L", 12)) {
+        const u32 bits = LoadLE32(bytes, 21);
+        return ImageInfo { .format = ImageFormat::WebP, .width = (bits & 0x3FFF) + 1, .height = ((bits >> 14) & 0x3FFF) + 1 };
+      }
+
+      if (StartsWith(bytes, "VP8X", 12))
+        return ImageInfo { .format = ImageFormat::WebP, .width = LoadLE24(bytes, 24) + 1, .height = LoadLE24(bytes, 27) + 1 };
+
+      return None;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Identify an image and read its dimensions from the header alone
+   */
+  constexpr auto ProbeImage(Span<const u8> bytes) -> Option<ImageInfo> {
+    using namespace detail;
+
+    if (StartsWith(bytes, "\x89PNG\r\n\x1a\n") && bytes.size() >= 24 && StartsWith(bytes, "IHDR", 12))
+      return ImageInfo { .format = ImageFormat::Png, .width = LoadBE32(bytes, 16), .height = LoadBE32(bytes, 20) };
+
+    if (bytes.size() >= 4 && bytes[0] == 0xFF && bytes[1] == 0xD8)
+      return ProbeJpeg(bytes);
+
+    if ((StartsWith(bytes, "GIF87a") || StartsWith(bytes, "GIF89a")) && bytes.size() >= 10)
+      return ImageInfo { .format = ImageFormat::Gif, .width = LoadLE16(bytes, 6), .height = LoadLE16(bytes, 8) };
+
+    if (StartsWith(bytes, "RIFF") && StartsWith(bytes, "WEBP", 8))
+      return ProbeWebP(bytes);
+
+    if (StartsWith(bytes, "BM") && bytes.size() >= 26) {
+      // Height is negative for top-down bitmaps
+      const auto height = static_cast<i32>(LoadLE32(bytes, 22));
+      return ImageInfo { .format = ImageFormat::Bmp, .width = LoadLE32(bytes, 18), .height = static_cast<u32>(height < 0 ? -height : height) };
+    }
+
+    return None;
+  }
+
+  namespace reference {
+    // A 256x200 PNG header and a baseline JPEG with a 640x480 SOF0 after an APP0 segment
+    inline constexpr Array<u8, 24> PNG_HEADER = {
+      0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 13, 'I', 'H', 'D', 'R', 0, 0, 1, 0, 0, 0, 0, 200,
+    };
+    inline constexpr Array<u8, 17> JPEG_HEADER = {
+      0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x04, 0x00, 0x00, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x01, 0xE0, 0x02, 0x80,
+    };
+
+    static_assert(ProbeImage(PNG_HEADER)->width == 256 && ProbeImage(PNG_HEADER)->height == 200);
+    static_assert(ProbeImage(JPEG_HEADER)->width == 640 && ProbeImage(JPEG_HEADER)->height == 480);
+  } // namespace reference
+
+  /**
+   * @brief Read-only memory map of a whole file
+   */
+  class MappedFile {
+    const u8* m_data = nullptr;
+    usize     m_size = 0;
+
+    MappedFile(const u8* data, const usize size) : m_data(data), m_size(size) {}
+
+   public:
+    MappedFile() = default;
+
+    ~MappedFile() {
+      if (m_data)
+        ::munmap(const_cast<u8*>(m_data), m_size);
+    }
+
+    MappedFile(const MappedFile&)                    = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+    auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+      if (this != &other) {
+        if (m_data)
+          ::munmap(const_cast<u8*>(m_data), m_size);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+      }
+      return *this;
+    }
+
+    [[nodiscard]] auto bytes() const -> Span<const u8> {
+      return { m_data, m_size };
+    }
+
+    static auto open(const fs::path& path) -> Result<MappedFile> {
+      const i32 descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (descriptor < 0)
+        ERR_FMT(NotFound, "Failed to open {}: {}", path.string(), std::strerror(errno));
+
+      struct stat info {};
+      if (::fstat(descriptor, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(descriptor);
+        ERR_FMT(InvalidArgument, "{} is not a regular file", path.string());
+      }
+
+      const auto size = static_cast<usize>(info.st_size);
+      if (size == 0 || size > MAX_IMAGE_BYTES) {
+        ::close(descriptor);
+        ERR_FMT(InvalidArgument, "{} has an unsupported size ({} bytes)", path.string(), size);
+      }
+
+      RawPointer mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      ::close(descriptor);
+
+      if (mapping == MAP_FAILED)
+        ERR_FMT(IoError, "Failed to map {}: {}", path.string(), std::strerror(errno));
+
+      return MappedFile(static_cast<const u8*>(mapping), size);
+    }
+  };
+
+  namespace detail {
+    constexpr auto HexValue(const char digit) -> i32 {
+      if (digit >= '0' && digit <= '9')
+        return digit - '0';
+      if (digit >= 'a' && digit <= 'f')
+        return digit - 'a' + 10;
+      if (digit >= 'A' && digit <= 'F')
+        return digit - 'A' + 10;
+      return -1;
+    }
+
+    // file:// URLs percent-encode everything outside the unreserved set
+    inline auto FileUrlToPath(StringView url) -> Option<fs::path> {
+      constexpr StringView SCHEME = "file://";
+      if (!url.starts_with(SCHEME))
+        return None;
+
+      url = url.substr(SCHEME.size());
+      if (!url.starts_with('/')) {
+        // file://localhost/path is the only host form that refers to this machine
+        if (!url.starts_with("localhost/"))
+          return None;
+        url = url.substr(9);
+      }
+
+      String path;
+      path.reserve(url.size());
+      for (usize index = 0; index < url.size(); ++index) {
+        if (url[index] == '%' && index + 2 < url.size()) {
+          const i32 high = HexValue(url[index + 1]);
+          const i32 low  = HexValue(url[index + 2]);
+          if (high >= 0 && low >= 0) {
+            path.push_back(static_cast<char>((high << 4) | low));
+            index += 2;
+            continue;
+          }
+        }
+        path.push_back(url[index]);
+      }
+
+      return fs::path(std::move(path));
+    }
+
+    inline constexpr u64 FNV_OFFSET = 14695981039346656037ULL;
+
+    constexpr auto Hash(const StringView text, u64 hash = FNV_OFFSET) -> u64 {
+      for (const char character : text) {
+        hash ^= static_cast<u8>(character);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    constexpr auto Hash(u64 value, u64 hash) -> u64 {
+      for (usize byte = 0; byte < sizeof(value); ++byte, value >>= 8) {
+        hash ^= value & 0xFF;
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    /**
+     * @brief Shrink interleaved 8-bit pixels by averaging each output pixel's source area
+     * @details Box filtering is exact for integer factors and close enough
+     * otherwise; every source pixel contributes to exactly one output pixel.
+     */
+    constexpr auto DownscaleBox(Span<const u8> pixels, const u32 width, const u32 height, const u32 channels, const u32 outWidth, const u32 outHeight)
+      -> Vec<u8> {
+      Vec<u8>  out(static_cast<usize>(outWidth) * outHeight * channels);
+      Vec<u64> sums(static_cast<usize>(outWidth) * channels);
+
+      for (u32 outY = 0; outY < outHeight; ++outY) {
+        const u32 firstRow = static_cast<u32>(static_cast<u64>(outY) * height / outHeight);
+        const u32 lastRow  = std::max(firstRow + 1, static_cast<u32>(static_cast<u64>(outY + 1) * height / outHeight));
+
+        std::ranges::fill(sums, 0);
+        Vec<u32> counts(outWidth, 0);
+
+        for (u32 row = firstRow; row < lastRow; ++row) {
+          for (u32 outX = 0; outX < outWidth; ++outX) {
+            const u32 firstColumn = static_cast<u32>(static_cast<u64>(outX) * width / outWidth);
+            const u32 lastColumn  = std::max(firstColumn + 1, static_cast<u32>(static_cast<u64>(outX + 1) * width / outWidth));
+
+            for (u32 column = firstColumn; column < lastColumn; ++column)
+              for (u32 channel = 0; channel < channels; ++channel)
+                sums[(static_cast<usize>(outX) * channels) + channel] += pixels[((static_cast<usize>(row) * width + column) * channels) + channel];
+
+            counts[outX] += lastColumn - firstColumn;
+          }
+        }
+
+        for (u32 outX = 0; outX < outWidth; ++outX)
+          for (u32 channel = 0; channel < channels; ++channel) {
+            const u64 sum = sums[(static_cast<usize>(outX) * channels) + channel];
+            out[((static_cast<usize>(outY) * outWidth + outX) * channels) + channel] = static_cast<u8>((sum + (counts[outX] / 2)) / counts[outX]);
+          }
+      }
+
+      return out;
+    }
+
+    /**
+     * @brief Decode, shrink to fit `maxEdge` and re-encode an image
+     * @return None when the image cannot be decoded or encoded here
+     */
+    inline auto MakeThumbnail(Span<const u8> bytes, const ImageInfo& info, const u32 maxEdge) -> Option<Vec<u8>> {
+      if (info.format == ImageFormat::WebP || static_cast<u64>(info.width) * info.height > MAX_DECODE_PIXELS)
+        return None;
+
+      i32 width    = 0;
+      i32 height   = 0;
+      i32 channels = 0;
+
+      const std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixels(
+        stbi_load_from_memory(bytes.data(), static_cast<i32>(bytes.size()), &width, &height, &channels, 0), &stbi_image_free
+      );
+      if (!pixels || width <= 0 || height <= 0)
+        return None;
+
+      const f64 scale     = static_cast<f64>(maxEdge) / static_cast<f64>(std::max(width, height));
+      const u32 outWidth  = std::max<u32>(1, static_cast<u32>(std::lround(width * scale)));
+      const u32 outHeight = std::max<u32>(1, static_cast<u32>(std::lround(height * scale)));
+
+      const Vec<u8> resized = DownscaleBox(
+        { pixels.get(), static_cast<usize>(width) * height * channels },
+        static_cast<u32>(width),
+        static_cast<u32>(height),
+        static_cast<u32>(channels),
+        outWidth,
+        outHeight
+      );
+
+      Vec<u8>    encoded;
+      const auto append = [](void* context, void* data, const i32 size) {
+        auto*       out   = static_cast<Vec<u8>*>(context);
+        const auto* begin = static_cast<const u8*>(data);
+        out->insert(out->end(), begin, begin + size);
+      };
+
+      // JPEG has no alpha channel, so only opaque JPEG sources stay JPEG
+      const bool written = info.format == ImageFormat::Jpeg && (channels == 1 || channels == 3)
+        ? stbi_write_jpg_to_func(append, &encoded, static_cast<i32>(outWidth), static_cast<i32>(outHeight), channels, resized.data(), THUMBNAIL_JPEG_QUALITY) != 0
+        : stbi_write_png_to_func(append, &encoded, static_cast<i32>(outWidth), static_cast<i32>(outHeight), channels, resized.data(), static_cast<i32>(outWidth) * channels) != 0;
+
+      if (!written || encoded.empty())
+        return None;
+
+      return encoded;
+    }
+
+    inline auto WriteCallback(const char* contents, const usize size, const usize nmemb, Vec<u8>* buffer) -> usize {
+      const usize total = size * nmemb;
+      // Returning short aborts the transfer once the image is too large to cache
+      if (buffer->size() + total > MAX_IMAGE_BYTES)
+        return 0;
+      buffer->insert(buffer->end(), contents, contents + total);
+      return total;
+    }
+
+    // Aborts the transfer once the owning cache is shutting down
+    inline auto ProgressCallback(void* stopToken, curl_off_t /*dltotal*/, curl_off_t /*dlnow*/, curl_off_t /*ultotal*/, curl_off_t /*ulnow*/)
+      -> i32 {
+      return static_cast<const std::stop_token*>(stopToken)->stop_requested() ? 1 : 0;
+    }
+
+    inline auto FetchHttp(const String& url, const std::stop_token& stopToken) -> Result<Vec<u8>> {
+      const std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> curl(curl_easy_init(), &curl_easy_cleanup);
+      if (!curl)
+        ERR(ApiUnavailable, "curl_easy_init() failed");
+
+      Vec<u8> buffer;
+
+      curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+      curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, WriteCallback);
+      curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &buffer);
+      curl_easy_setopt(curl.get(), CURLOPT_FOLLOWLOCATION, 1L);
+      curl_easy_setopt(curl.get(), CURLOPT_MAXREDIRS, 5L);
+      curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT, FETCH_TIMEOUT_SECS);
+      curl_easy_setopt(curl.get(), CURLOPT_FAILONERROR, 1L);
+      curl_easy_setopt(curl.get(), CURLOPT_NOSIGNAL, 1L);
+      curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 0L);
+      curl_easy_setopt(curl.get(), CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+      curl_easy_setopt(curl.get(), CURLOPT_XFERINFODATA, &stopToken);
+
+      if (const CURLcode res = curl_easy_perform(curl.get()); res != CURLE_OK)
+        ERR_FMT(ApiUnavailable, "Failed to fetch album art: {}", curl_easy_strerror(res));
+
+      return buffer;
+    }
+  } // namespace detail
+
+  /**
+   * @brief The cache directory and its limits
+   * @details Holds no mutable state, so the fill thread works on its own copy.
+   */
+  class CacheDirectory {
+   public:
+    struct Entry {
+      fs::path  path;
+      ImageInfo info;
+    };
+
+   private:
+    fs::path m_directory;
+    u64      m_maxBytes;
+    u32      m_thumbnailSize; // 0: store images as published
+
+    [[nodiscard]] auto pathFor(const u64 key, const ImageFormat format) const -> fs::path {
+      return m_directory / std::format("{:016x}.{}", key, Extension(format));
+    }
+
+    // Bump the modification time that eviction orders by, at most once per TOUCH_INTERVAL
+    static auto touch(const fs::path& path, const fs::file_time_type modified) -> void {
+      const fs::file_time_type now = fs::file_time_type::clock::now();
+      if (now - modified < TOUCH_INTERVAL)
+        return;
+
+      std::error_code errc;
+      fs::last_write_time(path, now, errc);
+    }
+
+    static auto describe(const fs::path& path) -> Result<Entry> {
+      const MappedFile        file = TRY(MappedFile::open(path));
+      const Option<ImageInfo> info = ProbeImage(file.bytes());
+      if (!info)
+        ERR_FMT(ParseError, "{} is not a recognised image", path.string());
+      return Entry { .path = path, .info = *info };
+    }
+
+    /**
+     * @brief Remove the least recently used files until the cache fits its budget
+     * @details Temporary files still within TEMPORARY_GRACE count towards the
+     * budget but are left for the store that is writing them.
+     */
+    auto evict(const fs::path& keep) const -> void {
+      struct File {
+        fs::path           path;
+        u64                size;
+        fs::file_time_type modified;
+      };
+
+      Vec<File>       files;
+      u64             total = 0;
+      std::error_code errc;
+
+      for (const fs::directory_entry& entry : fs::directory_iterator(m_directory, errc)) {
+        if (!entry.is_regular_file(errc))
+          continue;
+
+        File file { .path = entry.path(), .size = entry.file_size(errc), .modified = entry.last_write_time(errc) };
+        if (errc)
+          continue;
+
+        total += file.size;
+        files.push_back(std::move(file));
+      }
+
+      if (total <= m_maxBytes)
+        return;
+
+      std::ranges::sort(files, {}, &File::modified);
+
+      const fs::file_time_type graceStart = fs::file_time_type::clock::now() - TEMPORARY_GRACE;
+
+      for (const File& file : files) {
+        if (total <= m_maxBytes)
+          break;
+        if (file.path == keep || (file.path.extension() == ".tmp" && file.modified > graceStart))
+          continue;
+        if (fs::remove(file.path, errc))
+          total -= file.size;
+      }
+    }
+
+   public:
+    CacheDirectory(fs::path directory, const u64 maxBytes, const u32 thumbnailSize)
+      : m_directory(std::move(directory)), m_maxBytes(maxBytes), m_thumbnailSize(thumbnailSize) {}
+
+    [[nodiscard]] auto thumbnailSize() const -> u32 {
+      return m_thumbnailSize;
+    }
+
+    // Look for an entry another process (or an earlier run) already stored
+    [[nodiscard]] auto findStored(const u64 key) const -> Option<Entry> {
+      for (const ImageFormat format : ALL_FORMATS) {
+        const fs::path path = pathFor(key, format);
+
+        std::error_code          errc;
+        const fs::file_time_type modified = fs::last_write_time(path, errc);
+        if (errc)
+          continue;
+
+        if (Result<Entry> entry = describe(path)) {
+          touch(path, modified);
+          return std::move(*entry);
+        }
+      }
+      return None;
+    }
+
+    auto store(const u64 key, Span<const u8> bytes) const -> Result<Entry> {
+      Option<ImageInfo> info = ProbeImage(bytes);
+      if (!info)
+        ERR(ParseError, "Album art is not a recognised image");
+
+      Option<Vec<u8>> thumbnail;
+      if (m_thumbnailSize > 0 && (info->width > m_thumbnailSize || info->height > m_thumbnailSize))
+        if ((thumbnail = detail::MakeThumbnail(bytes, *info, m_thumbnailSize)))
+          if (const Option<ImageInfo> scaled = ProbeImage(*thumbnail)) {
+            bytes = *thumbnail;
+            info  = scaled;
+          }
+
+      const fs::path target    = pathFor(key, info->format);
+      const fs::path temporary = target.string() + std::format(".{}.{}.tmp", ::getpid(), std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+      std::error_code errc;
+
+      {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        out.close();
+
+        if (!out) {
+          fs::remove(temporary, errc);
+          ERR_FMT(IoError, "Failed to write {}", temporary.string());
+        }
+      }
+
+      // Rename is atomic, so concurrent readers never see a partial image
+      fs::rename(temporary, target, errc);
+      if (errc) {
+        const String reason = errc.message();
+        fs::remove(temporary, errc);
+        ERR_FMT(IoError, "Failed to store {}: {}", target.string(), reason);
+      }
+
+      evict(target);
+      return Entry { .path = target, .info = *info };
+    }
+  };
+
+  /**
+   * @brief Album art cache, resolving art URLs to cached files
+   */
+  class ArtCache {
+   public:
+    using Entry = CacheDirectory::Entry;
+
+   private:
+    // Where a URL's art comes from, and the cache key that identifies that version of it
+    struct Source {
+      u64              key;
+      Option<fs::path> file; // Local art; None for http(s)
+      String           url;
+    };
+
+    // A miss being filled on the worker; `result` is written before `done` is set
+    struct Fill {
+      u64                   key;
+      std::atomic<bool>     done = false;
+      Option<Result<Entry>> result;
+    };
+
+    CacheDirectory m_directory;
+
+    // The key resolved last and its outcome, so a failing URL is not retried on every collection
+    u64                   m_key = 0;
+    Option<Result<Entry>> m_last;
+
+    std::shared_ptr<Fill> m_fill;
+    std::jthread          m_worker;
+
+    [[nodiscard]] auto identify(const StringView url) const -> Result<Source> {
+      const u64 seed = detail::Hash(m_directory.thumbnailSize(), detail::FNV_OFFSET);
+
+      if (Option<fs::path> local = detail::FileUrlToPath(url)) {
+        struct stat info {};
+        if (::stat(local->c_str(), &info) != 0)
+          ERR_FMT(NotFound, "Album art {} is not readable: {}", local->string(), std::strerror(errno));
+
+        const i64 modified = (static_cast<i64>(info.st_mtim.tv_sec) * 1'000'000'000) + info.st_mtim.tv_nsec;
+
+        u64 key = detail::Hash(local->native(), seed);
+        key     = detail::Hash(static_cast<u64>(info.st_size), key);
+        key     = detail::Hash(static_cast<u64>(modified), key);
+        return Source { .key = key, .file = std::move(*local), .url = {} };
+      }
+
+      if (url.starts_with("http://") || url.starts_with("https://"))
+        return Source { .key = detail::Hash(url, seed), .file = None, .url = String(url) };
+
+      ERR_FMT(NotSupported, "Unsupported album art URL: {}", url);
+    }
+
+    static auto load(const CacheDirectory& directory, const Source& source, const std::stop_token& stopToken) -> Result<Entry> {
+      if (source.file) {
+        const MappedFile file = TRY(MappedFile::open(*source.file));
+        return directory.store(source.key, file.bytes());
+      }
+
+      const Vec<u8> bytes = TRY(detail::FetchHttp(source.url, stopToken));
+      return directory.store(source.key, bytes);
+    }
+
+    auto startFill(Source source) -> void {
+      m_fill = std::make_shared<Fill>();
+      m_fill->key = source.key;
+
+      m_worker = std::jthread([fill = m_fill, directory = m_directory, source = std::move(source)](const std::stop_token& stopToken) {
+        fill->result = load(directory, source, stopToken);
+        fill->done.store(true, std::memory_order_release);
+      });
+    }
+
+    auto remember(const u64 key, Result<Entry> entry) -> Result<Entry> {
+      m_key  = key;
+      m_last = std::move(entry);
+      return *m_last;
+    }
+
+   public:
+    ArtCache(fs::path directory, const u64 maxBytes, const u32 thumbnailSize = DEFAULT_THUMBNAIL_SIZE)
+      : m_directory(directory, maxBytes, thumbnailSize) {
+      std::error_code errc;
+      fs::create_directories(directory, errc);
+    }
+
+    ArtCache(const ArtCache&)                    = delete;
+    auto operator=(const ArtCache&) -> ArtCache& = delete;
+    ArtCache(ArtCache&&)                         = delete;
+    auto operator=(ArtCache&&) -> ArtCache&      = delete;
+
+    // The jthread requests stop, which aborts a download in progress, then joins
+    ~ArtCache() = default;
+
+    /**
+     * @brief Cached copy of the art behind `url`
+     * @details A miss starts filling the cache in the background and returns
+     * NotFound; a later call picks up the result. Asking again for the
+     * current art only checks that its file is still there. One fill runs at
+     * a time, so a track change during a download waits for it to finish.
+     */
+    auto resolve(const StringView url) -> Result<Entry> {
+      Result<Source> source = identify(url);
+      if (!source)
+        return Err(source.error());
+
+      if (m_last && source->key == m_key) {
+        if (!*m_last)
+          return *m_last;
+
+        std::error_code errc;
+        if (fs::exists((*m_last)->path, errc))
+          return *m_last;
+      }
+
+      if (m_fill && m_fill->done.load(std::memory_order_acquire)) {
+        const std::shared_ptr<Fill> fill = std::exchange(m_fill, nullptr);
+        m_worker.join();
+
+        if (fill->key == source->key)
+          return remember(source->key, std::move(*fill->result));
+      }
+
+      if (Option<Entry> stored = m_directory.findStored(source->key))
+        return remember(source->key, std::move(*stored));
+
+      if (!m_fill)
+        startFill(std::move(*source));
+
+      ERR_FMT(NotFound, "Album art for {} is still being prepared", url);
+    }
+  };
+} // namespace now_playing::art
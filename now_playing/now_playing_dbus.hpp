@@ -0,0 +1,1424 @@
+/**
+ * @file now_playing_dbus.hpp
+ * @brief Minimal built-in DBus client for the Now Playing plugin (Linux/BSD)
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Speaks just enough of the DBus wire protocol for MPRIS: SASL
+ * EXTERNAL authentication over the bus's Unix socket, marshalling of method
+ * calls whose arguments are all strings, and unmarshalling of any reply or
+ * signal. Received messages are parsed in place: iterators and string views
+ * point straight into the message frame, and the socket is drained through
+ * one receive buffer that lives as long as the connection.
+ *
+ * The classes keep the interface of the libdbus wrappers they replace, so
+ * the MPRIS code on top is unchanged. A Connection is not thread-safe; every
+ * thread that talks to the bus opens its own.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <initializer_list>
+#include <memory>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+#include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Logging.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+namespace now_playing::dbus {
+  using namespace draconis::utils::types;
+  using draconis::utils::error::DracError;
+  using enum draconis::utils::error::DracErrorCode;
+
+  // Argument type codes, as reported by MessageIter::getArgType()
+  inline constexpr i32 TYPE_INVALID     = 0;
+  inline constexpr i32 TYPE_BYTE        = 'y';
+  inline constexpr i32 TYPE_BOOLEAN     = 'b';
+  inline constexpr i32 TYPE_INT16       = 'n';
+  inline constexpr i32 TYPE_UINT16      = 'q';
+  inline constexpr i32 TYPE_INT32       = 'i';
+  inline constexpr i32 TYPE_UINT32      = 'u';
+  inline constexpr i32 TYPE_INT64       = 'x';
+  inline constexpr i32 TYPE_UINT64      = 't';
+  inline constexpr i32 TYPE_DOUBLE      = 'd';
+  inline constexpr i32 TYPE_STRING      = 's';
+  inline constexpr i32 TYPE_OBJECT_PATH = 'o';
+  inline constexpr i32 TYPE_SIGNATURE   = 'g';
+  inline constexpr i32 TYPE_UNIX_FD     = 'h';
+  inline constexpr i32 TYPE_ARRAY       = 'a';
+  inline constexpr i32 TYPE_VARIANT     = 'v';
+  inline constexpr i32 TYPE_STRUCT      = 'r';
+  inline constexpr i32 TYPE_DICT_ENTRY  = 'e';
+
+  enum class BusType : u8 {
+    Session,
+    System,
+  };
+
+  enum class MessageType : u8 {
+    Invalid      = 0,
+    MethodCall   = 1,
+    MethodReturn = 2,
+    Error        = 3,
+    Signal       = 4,
+  };
+
+  namespace wire {
+    using Clock = std::chrono::steady_clock;
+
+    inline constexpr u8    PROTOCOL_VERSION  = 1;
+    inline constexpr usize FIXED_HEADER_SIZE = 16;
+    inline constexpr usize MAX_MESSAGE_SIZE  = 1U << 27; // 128 MiB, the limit set by the specification
+    inline constexpr u32   MAX_DEPTH         = 64;
+    inline constexpr usize RECEIVE_CHUNK     = 16384;
+    inline constexpr usize MAX_STRING_ARGS   = 8;
+
+    // Signature of a call with N string arguments is the first N characters
+    inline constexpr StringView STRING_ARGS_SIGNATURE = "ssssssss";
+    static_assert(STRING_ARGS_SIGNATURE.size() == MAX_STRING_ARGS);
+
+    enum class HeaderField : u8 {
+      Path        = 1,
+      Interface   = 2,
+      Member      = 3,
+      ErrorName   = 4,
+      ReplySerial = 5,
+      Destination = 6,
+      Sender      = 7,
+      Signature   = 8,
+    };
+
+    constexpr auto AlignUp(const usize offset, const usize alignment) -> usize {
+      return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    constexpr auto Alignment(const char code) -> usize {
+      switch (code) {
+        case 'n':
+        case 'q': return 2;
+        case 'b':
+        case 'i':
+        case 'u':
+        case 'h':
+        case 's':
+        case 'o':
+        case 'a': return 4;
+        case 'x':
+        case 't':
+        case 'd':
+        case '(':
+        case '{': return 8;
+        default:  return 1;
+      }
+    }
+
+    // Size of a fixed-width basic type, 0 for everything else
+    constexpr auto FixedSize(const char code) -> usize {
+      switch (code) {
+        case 'y': return 1;
+        case 'n':
+        case 'q': return 2;
+        case 'b':
+        case 'i':
+        case 'u':
+        case 'h': return 4;
+        case 'x':
+        case 't':
+        case 'd': return 8;
+        default:  return 0;
+      }
+    }
+
+    /**
+     * @brief Length of the single complete type starting at `pos`
+     * @return 0 if the signature is malformed there
+     */
+    constexpr auto CompleteTypeLength(const StringView signature, const usize pos) -> usize {
+      if (pos >= signature.size())
+        return 0;
+
+      const char code = signature[pos];
+
+      if (code == 'a') {
+        const usize element = CompleteTypeLength(signature, pos + 1);
+        return element == 0 ? 0 : element + 1;
+      }
+
+      if (code == '(' || code == '{') {
+        const char close  = code == '(' ? ')' : '}';
+        usize      cursor = pos + 1;
+
+        while (cursor < signature.size() && signature[cursor] != close) {
+          const usize field = CompleteTypeLength(signature, cursor);
+          if (field == 0)
+            return 0;
+          cursor += field;
+        }
+
+        // Empty structs are not allowed
+        return cursor < signature.size() && cursor > pos + 1 ? cursor - pos + 1 : 0;
+      }
+
+      return FixedSize(code) != 0 || code == 's' || code == 'o' || code == 'g' || code == 'v' ? 1 : 0;
+    }
+
+    static_assert(CompleteTypeLength("a{sv}", 0) == 5);
+    static_assert(CompleteTypeLength("a(yv)s", 0) == 5);
+    static_assert(CompleteTypeLength("()", 0) == 0);
+    static_assert(CompleteTypeLength("a", 0) == 0);
+
+    template <typename T>
+    constexpr auto Load(const u8* bytes, const bool bigEndian) -> T {
+      using Bits = std::conditional_t<sizeof(T) == 8, u64, std::conditional_t<sizeof(T) == 4, u32, u16>>;
+
+      Bits value = 0;
+      for (usize index = 0; index < sizeof(T); ++index) {
+        const usize shift = bigEndian ? (sizeof(T) - 1 - index) * 8 : index * 8;
+        value |= static_cast<Bits>(static_cast<Bits>(bytes[index]) << shift);
+      }
+      return std::bit_cast<T>(value);
+    }
+
+    /**
+     * @brief Appends little-endian DBus values to a buffer
+     * @details Alignment is relative to `base`, the offset at which the current
+     * message starts, so several messages can be queued into one buffer.
+     */
+    class Writer {
+      Vec<u8>& m_out;
+      usize    m_base;
+
+     public:
+      explicit Writer(Vec<u8>& out) : m_out(out), m_base(out.size()) {}
+
+      [[nodiscard]] auto offset() const -> usize {
+        return m_out.size() - m_base;
+      }
+
+      auto pad(const usize alignment) -> void {
+        m_out.resize(m_base + AlignUp(offset(), alignment), 0);
+      }
+
+      auto byte(const u8 value) -> void {
+        m_out.push_back(value);
+      }
+
+      auto uint32(const u32 value) -> void {
+        pad(4);
+        for (usize index = 0; index < 4; ++index)
+          m_out.push_back(static_cast<u8>(value >> (index * 8)));
+      }
+
+      auto patchUint32(const usize at, const u32 value) -> void {
+        for (usize index = 0; index < 4; ++index)
+          m_out[m_base + at + index] = static_cast<u8>(value >> (index * 8));
+      }
+
+      auto string(const StringView value) -> void {
+        uint32(static_cast<u32>(value.size()));
+        m_out.insert(m_out.end(), value.begin(), value.end());
+        m_out.push_back(0);
+      }
+
+      auto signature(const StringView value) -> void {
+        byte(static_cast<u8>(value.size()));
+        m_out.insert(m_out.end(), value.begin(), value.end());
+        m_out.push_back(0);
+      }
+    };
+
+    /**
+     * @brief Total size of the message whose fixed header starts at `header`
+     */
+    inline auto FrameSize(const u8* header) -> Result<usize> {
+      if (header[0] != 'l' && header[0] != 'B')
+        ERR(ParseError, "DBus message has an invalid byte order marker");
+      if (header[3] != PROTOCOL_VERSION)
+        ERR(ParseError, "DBus message uses an unsupported protocol version");
+
+      const bool  bigEndian = header[0] == 'B';
+      const usize bodySize  = Load<u32>(header + 4, bigEndian);
+      const usize fieldSize = Load<u32>(header + 12, bigEndian);
+
+      if (bodySize > MAX_MESSAGE_SIZE || fieldSize > MAX_MESSAGE_SIZE)
+        ERR(ParseError, "DBus message exceeds the maximum message size");
+
+      const usize total = AlignUp(FIXED_HEADER_SIZE + fieldSize, 8) + bodySize;
+      if (total > MAX_MESSAGE_SIZE)
+        ERR(ParseError, "DBus message exceeds the maximum message size");
+
+      return total;
+    }
+
+    /**
+     * @brief One Unix socket endpoint from a DBus address
+     */
+    struct Endpoint {
+      String path;
+      bool   isAbstract = false; // Linux abstract namespace socket
+    };
+
+    constexpr auto HexValue(const char digit) -> i32 {
+      if (digit >= '0' && digit <= '9')
+        return digit - '0';
+      if (digit >= 'a' && digit <= 'f')
+        return digit - 'a' + 10;
+      if (digit >= 'A' && digit <= 'F')
+        return digit - 'A' + 10;
+      return -1;
+    }
+
+    inline auto Unescape(const StringView value) -> String {
+      String result;
+      result.reserve(value.size());
+
+      for (usize index = 0; index < value.size(); ++index) {
+        if (value[index] == '%' && index + 2 < value.size()) {
+          const i32 high = HexValue(value[index + 1]);
+          const i32 low  = HexValue(value[index + 2]);
+          if (high >= 0 && low >= 0) {
+            result.push_back(static_cast<char>((high << 4) | low));
+            index += 2;
+            continue;
+          }
+        }
+        result.push_back(value[index]);
+      }
+
+      return result;
+    }
+
+    /**
+     * @brief Extract the Unix socket endpoints from a DBus server address list
+     * @details Addresses look like `unix:path=/run/user/1000/bus`, several of
+     * them separated by ';'. Transports other than `unix` are skipped.
+     */
+    inline auto ParseAddress(const StringView addresses) -> Vec<Endpoint> {
+      Vec<Endpoint> endpoints;
+
+      for (usize start = 0; start <= addresses.size();) {
+        const usize      end   = std::min(addresses.find(';', start), addresses.size());
+        const StringView entry = addresses.substr(start, end - start);
+        start                  = end + 1;
+
+        const usize colon = entry.find(':');
+        if (colon == StringView::npos || entry.substr(0, colon) != "unix")
+          continue;
+
+        Option<Endpoint> endpoint;
+        const StringView params = entry.substr(colon + 1);
+
+        for (usize paramStart = 0; paramStart <= params.size();) {
+          const usize      paramEnd = std::min(params.find(',', paramStart), params.size());
+          const StringView param    = params.substr(paramStart, paramEnd - paramStart);
+          paramStart                = paramEnd + 1;
+
+          if (param.starts_with("path="))
+            endpoint = Endpoint { .path = Unescape(param.substr(5)), .isAbstract = false };
+#ifdef __linux__
+          else if (param.starts_with("abstract="))
+            endpoint = Endpoint { .path = Unescape(param.substr(9)), .isAbstract = true };
+#endif
+        }
+
+        if (endpoint && !endpoint->path.empty())
+          endpoints.push_back(std::move(*endpoint));
+      }
+
+      return endpoints;
+    }
+
+    inline auto ConnectUnix(const Endpoint& endpoint) -> Result<i32> {
+      sockaddr_un address {};
+      address.sun_family = AF_UNIX;
+
+      // Abstract names start with a NUL byte and are not NUL terminated
+      const usize prefix = endpoint.isAbstract ? 1 : 0;
+      const usize suffix = endpoint.isAbstract ? 0 : 1;
+      if (prefix + endpoint.path.size() + suffix > sizeof(address.sun_path))
+        ERR_FMT(InvalidArgument, "DBus socket path is too long: {}", endpoint.path);
+
+      std::memcpy(address.sun_path + prefix, endpoint.path.data(), endpoint.path.size());
+      const auto length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + prefix + endpoint.path.size() + suffix);
+
+      const i32 socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (socket < 0)
+        ERR_FMT(IoError, "Failed to create DBus socket: {}", std::strerror(errno));
+
+      if (::connect(socket, reinterpret_cast<const sockaddr*>(&address), length) != 0) {
+        const i32 error = errno;
+        ::close(socket);
+        ERR_FMT(ApiUnavailable, "Failed to connect to DBus socket {}: {}", endpoint.path, std::strerror(error));
+      }
+
+      return socket;
+    }
+  } // namespace wire
+
+  /**
+   * @brief Cursor over the values of a received message
+   * @details Iterates one container level: the top-level arguments, the fields
+   * of a struct or dict entry, the elements of an array, or the single value
+   * of a variant. Every read is bounds-checked against the message; malformed
+   * data makes the iterator report TYPE_INVALID instead of reading past it.
+   */
+  class MessageIter {
+    const u8*  m_data      = nullptr; // Start of the region the offsets are relative to (8-byte aligned)
+    usize      m_size      = 0;       // Size of that region
+    bool       m_bigEndian = false;
+    StringView m_signature;           // Types at this level; the element type for arrays
+    usize      m_sigPos  = 0;
+    usize      m_offset  = 0; // Offset of the current value
+    usize      m_end     = 0; // End of the element data (arrays only)
+    bool       m_isArray = false;
+    bool       m_isValid = false;
+
+    friend class Message;
+
+    MessageIter() = default;
+
+    MessageIter(
+      const u8*        data,
+      const usize      size,
+      const bool       bigEndian,
+      const StringView signature,
+      const usize      offset,
+      const usize      end,
+      const bool       isArray
+    )
+      : m_data(data), m_size(size), m_bigEndian(bigEndian), m_signature(signature), m_offset(offset), m_end(end), m_isArray(isArray), m_isValid(true) {
+      settle();
+    }
+
+    [[nodiscard]] auto atEnd() const -> bool {
+      return m_isArray ? m_offset >= m_end : m_sigPos >= m_signature.size();
+    }
+
+    // Skip the alignment padding in front of the current value
+    auto settle() -> void {
+      if (atEnd())
+        return;
+
+      m_offset = wire::AlignUp(m_offset, wire::Alignment(m_signature[m_sigPos]));
+      if (m_offset > m_size)
+        m_isValid = false;
+    }
+
+    [[nodiscard]] auto current() const -> char {
+      return m_isValid && !atEnd() ? m_signature[m_sigPos] : '\0';
+    }
+
+    template <typename T>
+    [[nodiscard]] auto load(const usize offset) const -> Option<T> {
+      if (offset > m_size || m_size - offset < sizeof(T))
+        return None;
+      return wire::Load<T>(m_data + offset, m_bigEndian);
+    }
+
+    [[nodiscard]] auto variantSignature(const usize offset) const -> Option<StringView> {
+      if (offset >= m_size)
+        return None;
+
+      const usize length = m_data[offset];
+      if (m_size - offset < length + 2)
+        return None;
+
+      const StringView signature(reinterpret_cast<const char*>(m_data + offset + 1), length);
+      if (length == 0 || wire::CompleteTypeLength(signature, 0) != length)
+        return None;
+      return signature;
+    }
+
+    /**
+     * @brief Offset just past the value of type `signature[pos]` starting at `offset`
+     */
+    [[nodiscard]] auto valueEnd(const StringView signature, const usize pos, usize offset, const u32 depth) const -> Option<usize> {
+      if (pos >= signature.size() || depth > wire::MAX_DEPTH)
+        return None;
+
+      const char code = signature[pos];
+      offset          = wire::AlignUp(offset, wire::Alignment(code));
+
+      if (const usize fixed = wire::FixedSize(code)) {
+        if (offset > m_size || m_size - offset < fixed)
+          return None;
+        return offset + fixed;
+      }
+
+      switch (code) {
+        case 's':
+        case 'o': {
+          const Option<u32> length = load<u32>(offset);
+          if (!length || m_size - offset - 4 < static_cast<usize>(*length) + 1)
+            return None;
+          return offset + 4 + *length + 1;
+        }
+
+        case 'g': {
+          if (offset >= m_size || m_size - offset < static_cast<usize>(m_data[offset]) + 2)
+            return None;
+          return offset + m_data[offset] + 2;
+        }
+
+        case 'a': {
+          const Option<u32> length = load<u32>(offset);
+          if (!length || pos + 1 >= signature.size())
+            return None;
+
+          const usize start = wire::AlignUp(offset + 4, wire::Alignment(signature[pos + 1]));
+          if (start > m_size || m_size - start < *length)
+            return None;
+          return start + *length;
+        }
+
+        case 'v': {
+          const Option<StringView> inner = variantSignature(offset);
+          if (!inner)
+            return None;
+          return valueEnd(*inner, 0, offset + inner->size() + 2, depth + 1);
+        }
+
+        case '(':
+        case '{': {
+          const char close  = code == '(' ? ')' : '}';
+          usize      cursor = offset;
+
+          for (usize field = pos + 1; field < signature.size() && signature[field] != close;) {
+            const Option<usize> fieldEnd = valueEnd(signature, field, cursor, depth + 1);
+            const usize         length   = wire::CompleteTypeLength(signature, field);
+            if (!fieldEnd || length == 0)
+              return None;
+
+            cursor = *fieldEnd;
+            field += length;
+          }
+
+          return cursor;
+        }
+
+        default: return None;
+      }
+    }
+
+   public:
+    MessageIter(const MessageIter&)                    = delete;
+    auto operator=(const MessageIter&) -> MessageIter& = delete;
+    MessageIter(MessageIter&&)                         = delete;
+    auto operator=(MessageIter&&) -> MessageIter&      = delete;
+    ~MessageIter()                                     = default;
+
+    [[nodiscard]] auto isValid() const -> bool {
+      return m_isValid;
+    }
+
+    [[nodiscard]] auto getArgType() const -> i32 {
+      switch (const char code = current()) {
+        case '(': return TYPE_STRUCT;
+        case '{': return TYPE_DICT_ENTRY;
+        default:  return code;
+      }
+    }
+
+    [[nodiscard]] auto getElementType() const -> i32 {
+      if (current() != 'a' || m_sigPos + 1 >= m_signature.size())
+        return TYPE_INVALID;
+
+      switch (const char code = m_signature[m_sigPos + 1]) {
+        case '(': return TYPE_STRUCT;
+        case '{': return TYPE_DICT_ENTRY;
+        default:  return code;
+      }
+    }
+
+    /**
+     * @brief Move to the next value at this level
+     * @return false once there are no more values
+     */
+    auto next() -> bool {
+      if (current() == '\0')
+        return false;
+
+      const Option<usize> end = valueEnd(m_signature, m_sigPos, m_offset, 0);
+      if (!end) {
+        m_isValid = false;
+        return false;
+      }
+
+      m_offset = *end;
+      if (!m_isArray)
+        m_sigPos += wire::CompleteTypeLength(m_signature, m_sigPos);
+
+      settle();
+      return current() != '\0';
+    }
+
+    /**
+     * @brief Iterate the contents of the current array, variant, struct or dict entry
+     */
+    [[nodiscard]] auto recurse() const -> MessageIter {
+      switch (current()) {
+        case 'a': {
+          const usize       elementLength = wire::CompleteTypeLength(m_signature, m_sigPos + 1);
+          const Option<u32> length        = load<u32>(m_offset);
+          if (elementLength == 0 || !length)
+            break;
+
+          const StringView element = m_signature.substr(m_sigPos + 1, elementLength);
+          const usize      start   = wire::AlignUp(m_offset + 4, wire::Alignment(element.front()));
+          if (start > m_size || m_size - start < *length)
+            break;
+
+          return { m_data, m_size, m_bigEndian, element, start, start + *length, true };
+        }
+
+        case 'v': {
+          const Option<StringView> inner = variantSignature(m_offset);
+          if (!inner)
+            break;
+
+          return { m_data, m_size, m_bigEndian, *inner, m_offset + inner->size() + 2, 0, false };
+        }
+
+        case '(':
+        case '{': {
+          const usize length = wire::CompleteTypeLength(m_signature, m_sigPos);
+          if (length < 3)
+            break;
+
+          return { m_data, m_size, m_bigEndian, m_signature.substr(m_sigPos + 1, length - 2), m_offset, 0, false };
+        }
+
+        default: break;
+      }
+
+      return {};
+    }
+
+    [[nodiscard]] auto getString() const -> Option<String> {
+      if (getArgType() == TYPE_STRING)
+        if (Option<StringView> value = getStringView(); value && !value->empty())
+          return String(*value);
+      return None;
+    }
+
+    /**
+     * @brief View a string, object-path or signature argument without copying it
+     * @note The view is only valid while the owning Message is alive.
+     */
+    [[nodiscard]] auto getStringView() const -> Option<StringView> {
+      switch (current()) {
+        case 's':
+        case 'o': {
+          const Option<u32> length = load<u32>(m_offset);
+          if (!length || m_size - m_offset - 4 < static_cast<usize>(*length) + 1)
+            return None;
+          return StringView(reinterpret_cast<const char*>(m_data + m_offset + 4), *length);
+        }
+
+        case 'g': {
+          if (m_offset >= m_size || m_size - m_offset < static_cast<usize>(m_data[m_offset]) + 2)
+            return None;
+          return StringView(reinterpret_cast<const char*>(m_data + m_offset + 1), m_data[m_offset]);
+        }
+
+        default: return None;
+      }
+    }
+
+    /**
+     * @brief Read any integer-typed argument (players disagree on the exact width)
+     */
+    [[nodiscard]] auto getInteger() const -> Option<i64> {
+      switch (current()) {
+        case 'y': return m_offset < m_size ? Option<i64>(m_data[m_offset]) : None;
+        case 'n': return load<i16>(m_offset);
+        case 'q': return load<u16>(m_offset);
+        case 'i': return load<i32>(m_offset);
+        case 'u': return load<u32>(m_offset);
+        case 'x': return load<i64>(m_offset);
+        case 't': return load<u64>(m_offset).transform([](const u64 value) { return static_cast<i64>(value); });
+        case 'd': return load<f64>(m_offset).transform([](const f64 value) { return static_cast<i64>(value); });
+        default:  return None;
+      }
+    }
+
+    /**
+     * @brief Read a double argument, accepting integers from players that send those instead
+     */
+    [[nodiscard]] auto getDouble() const -> Option<f64> {
+      if (current() == 'd')
+        return load<f64>(m_offset);
+      return getInteger().transform([](const i64 value) { return static_cast<f64>(value); });
+    }
+  };
+
+  /**
+   * @brief A received message, or a method call being built
+   * @details A parsed message borrows its frame: the body and header strings
+   * are views into the receive buffer. detach() copies just those into storage
+   * the message owns, which moving a Message keeps valid. Method calls only
+   * ever carry string arguments, which is all MPRIS needs.
+   */
+  class Message {
+    struct Call {
+      String      destination;
+      String      path;
+      String      interface;
+      String      member;
+      Vec<String> args;
+    };
+
+    Vec<u8>      m_storage; // Body, then header strings; empty while borrowing the frame
+    const u8*    m_body        = nullptr;
+    usize        m_bodySize    = 0;
+    bool         m_bigEndian   = false;
+    MessageType  m_type        = MessageType::Invalid;
+    u32          m_serial      = 0;
+    u32          m_replySerial = 0;
+    StringView   m_interface;
+    StringView   m_member;
+    StringView   m_errorName;
+    StringView   m_sender;
+    StringView   m_signature;
+    Option<Call> m_call;
+
+   public:
+    Message() = default;
+
+    Message(const Message&)                    = delete;
+    auto operator=(const Message&) -> Message& = delete;
+    Message(Message&&)                         = default;
+    auto operator=(Message&&) -> Message&      = default;
+    ~Message()                                 = default;
+
+    /**
+     * @brief Parse a complete frame, as delimited by wire::FrameSize()
+     * @note The message borrows `frame` until detach() is called.
+     */
+    static auto parse(const Span<const u8> frame) -> Result<Message> {
+      Message message;
+
+      const u8*   data       = frame.data();
+      const bool  bigEndian  = data[0] == 'B';
+      const usize fieldSize  = wire::Load<u32>(data + 12, bigEndian);
+      const usize bodyOffset = wire::AlignUp(wire::FIXED_HEADER_SIZE + fieldSize, 8);
+
+      message.m_bigEndian = bigEndian;
+      message.m_type      = data[1] >= 1 && data[1] <= 4 ? static_cast<MessageType>(data[1]) : MessageType::Invalid;
+      message.m_serial    = wire::Load<u32>(data + 8, bigEndian);
+      message.m_body      = data + bodyOffset;
+      message.m_bodySize  = frame.size() - bodyOffset;
+
+      // The header fields are the a(yv) that follows the fixed header
+      const MessageIter headerIter(data, wire::FIXED_HEADER_SIZE + fieldSize, bigEndian, "a(yv)", 12, 0, false);
+
+      MessageIter fieldIter = headerIter.recurse();
+      if (!fieldIter.isValid())
+        ERR(ParseError, "DBus message has a malformed header");
+
+      for (; fieldIter.getArgType() == TYPE_STRUCT; fieldIter.next()) {
+        MessageIter       entryIter = fieldIter.recurse();
+        const Option<i64> code      = entryIter.getInteger();
+
+        if (!code || !entryIter.next() || entryIter.getArgType() != TYPE_VARIANT)
+          ERR(ParseError, "DBus message has a malformed header field");
+
+        const MessageIter  valueIter = entryIter.recurse();
+        const StringView   text      = valueIter.getStringView().value_or("");
+        const Option<i64>  number    = valueIter.getInteger();
+
+        switch (static_cast<wire::HeaderField>(*code)) {
+          case wire::HeaderField::Interface:   message.m_interface = text; break;
+          case wire::HeaderField::Member:      message.m_member = text; break;
+          case wire::HeaderField::ErrorName:   message.m_errorName = text; break;
+          case wire::HeaderField::Sender:      message.m_sender = text; break;
+          case wire::HeaderField::Signature:   message.m_signature = text; break;
+          case wire::HeaderField::ReplySerial: message.m_replySerial = static_cast<u32>(number.value_or(0)); break;
+          default:                             break; // Path and destination are not needed on received messages
+        }
+      }
+
+      if (!fieldIter.isValid() || message.m_type == MessageType::Invalid)
+        ERR(ParseError, "DBus message has a malformed header");
+
+      return message;
+    }
+
+    /**
+     * @brief Stop borrowing the frame, keeping only what the accessors return
+     * @details The body is copied to offset 0 of the new storage. It starts
+     * 8-aligned in the frame, so offsets inside it keep their alignment.
+     * Path, destination and padding are not copied.
+     */
+    auto detach() -> void {
+      const std::initializer_list<StringView*> strings = { &m_interface, &m_member, &m_errorName, &m_sender, &m_signature };
+
+      usize size = m_bodySize;
+      for (const StringView* text : strings)
+        size += text->size();
+
+      Vec<u8> storage(size);
+      u8*     out = storage.data();
+
+      if (m_bodySize > 0)
+        std::memcpy(out, m_body, m_bodySize);
+      m_body = out;
+      out += m_bodySize;
+
+      for (StringView* text : strings) {
+        if (!text->empty())
+          std::memcpy(out, text->data(), text->size());
+        *text = StringView(reinterpret_cast<const char*>(out), text->size());
+        out += text->size();
+      }
+
+      m_storage = std::move(storage);
+    }
+
+    static auto newMethodCall(const char* destination, const char* path, const char* interface, const char* method)
+      -> Result<Message> {
+      if (!path || !method)
+        ERR(InvalidArgument, "DBus method calls need a path and a member");
+
+      Message message;
+      message.m_type = MessageType::MethodCall;
+      message.m_call = Call {
+        .destination = destination ? destination : "",
+        .path        = path,
+        .interface   = interface ? interface : "",
+        .member      = method,
+        .args        = {},
+      };
+      return message;
+    }
+
+    template <typename... Args>
+    [[nodiscard]] auto appendArgs(Args&&... args) -> bool {
+      if (!m_call || m_call->args.size() + sizeof...(Args) > wire::MAX_STRING_ARGS)
+        return false;
+
+      bool success = true;
+      ((success = success && appendArgInternal(std::forward<Args>(args))), ...);
+      return success;
+    }
+
+    /**
+     * @brief Append this method call, little-endian, to an output buffer
+     */
+    auto marshal(const u32 serial, Vec<u8>& out) const -> void {
+      using wire::HeaderField;
+
+      wire::Writer writer(out);
+
+      writer.byte('l');
+      writer.byte(std::to_underlying(MessageType::MethodCall));
+      writer.byte(0); // Flags
+      writer.byte(wire::PROTOCOL_VERSION);
+      writer.uint32(0); // Body length, patched below
+      writer.uint32(serial);
+      writer.uint32(0); // Header field array length, patched below
+
+      const auto field = [&](const HeaderField code, const char type, const StringView value) {
+        writer.pad(8);
+        writer.byte(std::to_underlying(code));
+        writer.signature(StringView(&type, 1));
+        if (type == 'g')
+          writer.signature(value);
+        else
+          writer.string(value);
+      };
+
+      field(HeaderField::Path, 'o', m_call->path);
+      field(HeaderField::Member, 's', m_call->member);
+      if (!m_call->interface.empty())
+        field(HeaderField::Interface, 's', m_call->interface);
+      if (!m_call->destination.empty())
+        field(HeaderField::Destination, 's', m_call->destination);
+      if (!m_call->args.empty())
+        field(HeaderField::Signature, 'g', wire::STRING_ARGS_SIGNATURE.substr(0, m_call->args.size()));
+
+      writer.patchUint32(12, static_cast<u32>(writer.offset() - wire::FIXED_HEADER_SIZE));
+      writer.pad(8);
+
+      const usize bodyStart = writer.offset();
+      for (const String& arg : m_call->args)
+        writer.string(arg);
+
+      writer.patchUint32(4, static_cast<u32>(writer.offset() - bodyStart));
+    }
+
+    [[nodiscard]] auto isMethodCall() const -> bool {
+      return m_call.has_value();
+    }
+
+    [[nodiscard]] auto type() const -> MessageType {
+      return m_type;
+    }
+
+    [[nodiscard]] auto replySerial() const -> u32 {
+      return m_replySerial;
+    }
+
+    [[nodiscard]] auto errorName() const -> StringView {
+      return m_errorName;
+    }
+
+    [[nodiscard]] auto isSignal(const StringView interface, const StringView member) const -> bool {
+      return m_type == MessageType::Signal && m_interface == interface && m_member == member;
+    }
+
+    [[nodiscard]] auto sender() const -> Option<StringView> {
+      if (m_sender.empty())
+        return None;
+      return m_sender;
+    }
+
+    [[nodiscard]] auto iterInit() const -> MessageIter {
+      if (m_signature.empty() || !m_body)
+        return {};
+
+      return { m_body, m_bodySize, m_bigEndian, m_signature, 0, 0, false };
+    }
+
+   private:
+    template <typename T>
+    auto appendArgInternal(T&& arg) -> bool {
+      using DecayedT = std::decay_t<T>;
+      if constexpr (std::is_convertible_v<DecayedT, const char*>) {
+        const char* value = static_cast<const char*>(std::forward<T>(arg));
+        if (!value)
+          return false;
+        m_call->args.emplace_back(value);
+        return true;
+      } else if constexpr (std::is_convertible_v<DecayedT, StringView>) {
+        m_call->args.emplace_back(StringView(std::forward<T>(arg)));
+        return true;
+      } else {
+        static_assert(!sizeof(T*), "Unsupported type passed to appendArgs");
+        return false;
+      }
+    }
+  };
+
+  namespace detail {
+    /**
+     * @brief Socket, buffers and message queue behind a Connection
+     * @details Kept on the heap so PendingCall can refer to it while the
+     * owning Connection is moved around.
+     */
+    class Transport {
+      i32                 m_socket     = -1;
+      u32                 m_nextSerial = 1;
+      Vec<u8>             m_readBuffer; // Unread bytes are [m_readBegin, m_readEnd)
+      usize               m_readBegin = 0;
+      usize               m_readEnd   = 0;
+      Vec<u8>             m_writeBuffer; // Calls queued since the last flush
+      Vec<u32>            m_outstanding; // Serials of calls whose reply is still wanted
+      std::deque<Message> m_incoming;
+      bool                m_keepSignals = false; // Signals are only queued once a match rule was added
+
+      // Make room for at least RECEIVE_CHUNK more bytes at the end of the buffer
+      auto reserveTail() -> void {
+        if (m_readBegin > 0 && m_readBuffer.size() - m_readEnd < wire::RECEIVE_CHUNK) {
+          std::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readBegin, m_readEnd - m_readBegin);
+          m_readEnd -= m_readBegin;
+          m_readBegin = 0;
+        }
+
+        if (m_readBuffer.size() - m_readEnd < wire::RECEIVE_CHUNK)
+          m_readBuffer.resize(m_readEnd + wire::RECEIVE_CHUNK);
+      }
+
+      /**
+       * @brief Wait for the socket to become readable and read what is available
+       */
+      auto fill(const wire::Clock::time_point deadline) -> Result<Unit> {
+        if (!isOpen())
+          ERR(ApiUnavailable, "DBus connection is closed");
+
+        using std::chrono::duration_cast, std::chrono::milliseconds;
+
+        const i64 remaining = std::max<i64>(0, duration_cast<milliseconds>(deadline - wire::Clock::now()).count());
+        pollfd    request { .fd = m_socket, .events = POLLIN, .revents = 0 };
+
+        const i32 ready = ::poll(&request, 1, static_cast<i32>(std::min<i64>(remaining, INT_MAX)));
+        if (ready < 0) {
+          if (errno == EINTR)
+            return {};
+          const i32 error = errno;
+          close();
+          ERR_FMT(IoError, "Failed to poll the DBus socket: {}", std::strerror(error));
+        }
+        if (ready == 0)
+          ERR(Timeout, "Timed out waiting for the bus");
+
+        reserveTail();
+
+        const isize received = ::recv(m_socket, m_readBuffer.data() + m_readEnd, m_readBuffer.size() - m_readEnd, 0);
+        if (received == 0) {
+          close();
+          ERR(ApiUnavailable, "The bus closed the connection");
+        }
+        if (received < 0) {
+          if (errno == EINTR || errno == EAGAIN)
+            return {};
+          const i32 error = errno;
+          close();
+          ERR_FMT(IoError, "Failed to read from the DBus socket: {}", std::strerror(error));
+        }
+
+        m_readEnd += static_cast<usize>(received);
+        return {};
+      }
+
+      /**
+       * @brief Consume every complete frame in the receive buffer
+       */
+      auto extractFrames() -> Result<Unit> {
+        while (m_readEnd - m_readBegin >= wire::FIXED_HEADER_SIZE) {
+          const u8* start = m_readBuffer.data() + m_readBegin;
+
+          Result<usize> frameSize = wire::FrameSize(start);
+          if (!frameSize) {
+            close();
+            return Err(frameSize.error());
+          }
+
+          if (m_readEnd - m_readBegin < *frameSize)
+            break;
+
+          // Parsed in place; only messages that are kept are copied out of the buffer
+          Result<Message> message = Message::parse(Span<const u8>(start, *frameSize));
+          m_readBegin += *frameSize;
+
+          if (!message) {
+            close();
+            return Err(message.error());
+          }
+
+          if (wants(*message)) {
+            message->detach();
+            m_incoming.push_back(std::move(*message));
+          }
+        }
+
+        if (m_readBegin == m_readEnd)
+          m_readBegin = m_readEnd = 0;
+
+        return {};
+      }
+
+      static auto isReplyTo(const Message& message, const u32 serial) -> bool {
+        return message.replySerial() == serial && (message.type() == MessageType::MethodReturn || message.type() == MessageType::Error);
+      }
+
+      [[nodiscard]] auto wants(const Message& message) const -> bool {
+        switch (message.type()) {
+          case MessageType::MethodReturn:
+          case MessageType::Error:        return std::ranges::find(m_outstanding, message.replySerial()) != m_outstanding.end();
+          case MessageType::Signal:       return m_keepSignals;
+          default:                        return false; // Nobody calls methods on us
+        }
+      }
+
+      auto writeAll(const u8* data, usize size) -> Result<Unit> {
+        while (size > 0) {
+          const isize sent = ::send(m_socket, data, size, MSG_NOSIGNAL);
+          if (sent < 0) {
+            if (errno == EINTR)
+              continue;
+            const i32 error = errno;
+            close();
+            ERR_FMT(IoError, "Failed to write to the DBus socket: {}", std::strerror(error));
+          }
+          data += sent;
+          size -= static_cast<usize>(sent);
+        }
+        return {};
+      }
+
+      auto readLine(const wire::Clock::time_point deadline) -> Result<String> {
+        constexpr StringView CRLF = "\r\n";
+
+        while (true) {
+          const auto begin = m_readBuffer.begin() + static_cast<isize>(m_readBegin);
+          const auto end   = m_readBuffer.begin() + static_cast<isize>(m_readEnd);
+
+          if (const auto newline = std::search(begin, end, CRLF.begin(), CRLF.end()); newline != end) {
+            String line(begin, newline);
+            m_readBegin = static_cast<usize>(newline - m_readBuffer.begin()) + 2;
+            return line;
+          }
+
+          TRY_VOID(fill(deadline));
+        }
+      }
+
+      // The protocol opens with a single NUL byte, which on FreeBSD must carry our credentials
+      auto sendCredentialsByte() -> Result<Unit> {
+#if defined(__FreeBSD__) || defined(__DragonFly__)
+        char  nul = '\0';
+        iovec data { .iov_base = &nul, .iov_len = 1 };
+
+        alignas(cmsghdr) Array<char, CMSG_SPACE(sizeof(cmsgcred))> control {};
+
+        msghdr header {};
+        header.msg_iov        = &data;
+        header.msg_iovlen     = 1;
+        header.msg_control    = control.data();
+        header.msg_controllen = control.size();
+
+        cmsghdr* credentials    = CMSG_FIRSTHDR(&header);
+        credentials->cmsg_level = SOL_SOCKET;
+        credentials->cmsg_type  = SCM_CREDS;
+        credentials->cmsg_len   = CMSG_LEN(sizeof(cmsgcred));
+
+        if (::sendmsg(m_socket, &header, MSG_NOSIGNAL) != 1) {
+          const i32 error = errno;
+          close();
+          ERR_FMT(IoError, "Failed to send DBus credentials: {}", std::strerror(error));
+        }
+        return {};
+#else
+        const u8 nul = 0;
+        return writeAll(&nul, 1);
+#endif
+      }
+
+     public:
+      explicit Transport(const i32 socket) : m_socket(socket) {}
+
+      ~Transport() {
+        close();
+      }
+
+      Transport(const Transport&)                    = delete;
+      auto operator=(const Transport&) -> Transport& = delete;
+      Transport(Transport&&)                         = delete;
+      auto operator=(Transport&&) -> Transport&      = delete;
+
+      [[nodiscard]] auto isOpen() const -> bool {
+        return m_socket >= 0;
+      }
+
+      auto close() -> void {
+        if (m_socket >= 0)
+          ::close(m_socket);
+        m_socket = -1;
+      }
+
+      /**
+       * @brief SASL EXTERNAL handshake: prove our uid through the socket credentials
+       */
+      auto authenticate(const wire::Clock::time_point deadline) -> Result<Unit> {
+        TRY_VOID(sendCredentialsByte());
+
+        String command = "AUTH EXTERNAL ";
+        for (const char digit : std::to_string(::geteuid()))
+          command += std::format("{:02x}", static_cast<u8>(digit));
+        command += "\r\n";
+
+        TRY_VOID(writeAll(reinterpret_cast<const u8*>(command.data()), command.size()));
+
+        const String reply = TRY(readLine(deadline));
+        if (!reply.starts_with("OK "))
+          ERR_FMT(PermissionDenied, "DBus authentication rejected: {}", reply);
+
+        constexpr StringView BEGIN = "BEGIN\r\n";
+        return writeAll(reinterpret_cast<const u8*>(BEGIN.data()), BEGIN.size());
+      }
+
+      auto keepSignals() -> void {
+        m_keepSignals = true;
+      }
+
+      /**
+       * @brief Marshal a method call into the output buffer; flush() sends it
+       */
+      auto queue(const Message& message) -> Result<u32> {
+        if (!isOpen())
+          ERR(ApiUnavailable, "DBus connection is closed");
+
+        const u32 serial = m_nextSerial++;
+        if (m_nextSerial == 0)
+          m_nextSerial = 1;
+
+        message.marshal(serial, m_writeBuffer);
+        m_outstanding.push_back(serial);
+        return serial;
+      }
+
+      auto flush() -> Result<Unit> {
+        if (m_writeBuffer.empty())
+          return {};
+
+        Result<Unit> written = isOpen() ? writeAll(m_writeBuffer.data(), m_writeBuffer.size()) : Result<Unit> {};
+        m_writeBuffer.clear();
+        return written;
+      }
+
+      // Forget a call whose reply is no longer wanted: a reply already queued is
+      // dropped now, and one that arrives later is never queued
+      auto forget(const u32 serial) -> void {
+        std::erase(m_outstanding, serial);
+        std::erase_if(m_incoming, [serial](const Message& message) { return isReplyTo(message, serial); });
+      }
+
+      /**
+       * @brief Read whatever arrives before the deadline and queue complete messages
+       */
+      auto receive(const wire::Clock::time_point deadline) -> Result<Unit> {
+        TRY_VOID(flush());
+        TRY_VOID(fill(deadline));
+        return extractFrames();
+      }
+
+      auto waitReply(const u32 serial, const wire::Clock::time_point deadline) -> Result<Message> {
+        TRY_VOID(flush());
+
+        while (true) {
+          const auto reply = std::ranges::find_if(m_incoming, [serial](const Message& message) { return isReplyTo(message, serial); });
+
+          if (reply != m_incoming.end()) {
+            Message message = std::move(*reply);
+            m_incoming.erase(reply);
+            return message;
+          }
+
+          TRY_VOID(receive(deadline));
+        }
+      }
+
+      [[nodiscard]] auto hasSignals() const -> bool {
+        return std::ranges::any_of(m_incoming, [](const Message& message) { return message.type() == MessageType::Signal; });
+      }
+
+      auto popSignal() -> Option<Message> {
+        const auto signal = std::ranges::find(m_incoming, MessageType::Signal, &Message::type);
+        if (signal == m_incoming.end())
+          return None;
+
+        Message message = std::move(*signal);
+        m_incoming.erase(signal);
+        return message;
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief Reply to a method call that has been queued but not yet awaited
+   * @note Must not outlive the Connection it was sent on.
+   */
+  class PendingCall {
+    detail::Transport*       m_transport = nullptr;
+    u32                      m_serial    = 0;
+    wire::Clock::time_point  m_deadline;
+
+   public:
+    PendingCall() = default;
+
+    PendingCall(detail::Transport* transport, const u32 serial, const wire::Clock::time_point deadline)
+      : m_transport(transport), m_serial(serial), m_deadline(deadline) {}
+
+    ~PendingCall() {
+      if (m_transport)
+        m_transport->forget(m_serial);
+    }
+
+    PendingCall(const PendingCall&)                    = delete;
+    auto operator=(const PendingCall&) -> PendingCall& = delete;
+
+    PendingCall(PendingCall&& other) noexcept
+      : m_transport(std::exchange(other.m_transport, nullptr)), m_serial(other.m_serial), m_deadline(other.m_deadline) {}
+
+    auto operator=(PendingCall&& other) noexcept -> PendingCall& {
+      if (this != &other) {
+        if (m_transport)
+          m_transport->forget(m_serial);
+        m_transport = std::exchange(other.m_transport, nullptr);
+        m_serial    = other.m_serial;
+        m_deadline  = other.m_deadline;
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Block until the reply (or timeout) arrives and take ownership of it
+     */
+    [[nodiscard]] auto wait() -> Result<Message> {
+      if (!m_transport)
+        ERR(InvalidArgument, "Invalid pending call");
+
+      detail::Transport* transport = std::exchange(m_transport, nullptr);
+      Result<Message>    reply     = transport->waitReply(m_serial, m_deadline);
+      transport->forget(m_serial);
+
+      if (reply && reply->type() == MessageType::Error) {
+        const MessageIter errorIter = reply->iterInit();
+        ERR_FMT(PlatformSpecific, "DBus error: {}: {}", reply->errorName(), errorIter.getStringView().value_or(""));
+      }
+
+      return reply;
+    }
+  };
+
+  /**
+   * @brief Connection to a message bus
+   */
+  class Connection {
+    static constexpr i32 CONNECT_TIMEOUT_MS = 1000;
+
+    UniquePointer<detail::Transport> m_transport;
+
+    explicit Connection(UniquePointer<detail::Transport> transport) : m_transport(std::move(transport)) {}
+
+    static auto connect(Span<const wire::Endpoint> endpoints) -> Result<Connection> {
+      const auto deadline = wire::Clock::now() + std::chrono::milliseconds(CONNECT_TIMEOUT_MS);
+
+      Option<DracError> lastError;
+
+      for (const wire::Endpoint& endpoint : endpoints) {
+        Result<i32> socket = wire::ConnectUnix(endpoint);
+        if (!socket) {
+          lastError = socket.error();
+          continue;
+        }
+
+        auto transport = std::make_unique<detail::Transport>(*socket);
+        if (Result<Unit> authenticated = transport->authenticate(deadline); !authenticated) {
+          lastError = authenticated.error();
+          continue;
+        }
+
+        // Hello must be the first call on a bus connection; it assigns our unique name
+        Connection connection(std::move(transport));
+        Message    hello = TRY(Message::newMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "Hello"));
+
+        if (Result<Message> reply = connection.sendWithReplyAndBlock(hello, CONNECT_TIMEOUT_MS); !reply) {
+          lastError = reply.error();
+          continue;
+        }
+
+        return connection;
+      }
+
+      if (lastError)
+        return Err(std::move(*lastError));
+
+      ERR(NotSupported, "DBus address has no usable unix transport");
+    }
+
+   public:
+    Connection() = default;
+
+    [[nodiscard]] auto isConnected() const -> bool {
+      return m_transport && m_transport->isOpen();
+    }
+
+    [[nodiscard]] auto addMatch(const char* rule) const -> Result<Unit> {
+      if (!isConnected())
+        ERR(InvalidArgument, "Invalid connection");
+
+      Message msg = TRY(Message::newMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "AddMatch"));
+      if (!msg.appendArgs(rule))
+        ERR(InternalError, "Failed to append arguments to AddMatch message");
+
+      m_transport->keepSignals();
+      TRY(sendWithReplyAndBlock(msg));
+      return {};
+    }
+
+    /**
+     * @brief Block until a signal is available or the timeout expires
+     * @return false once the connection has been closed
+     */
+    auto readWrite(const i32 timeout_milliseconds) const -> bool {
+      if (!isConnected())
+        return false;
+
+      // Timing out is the normal case; a lost connection shows up in isConnected()
+      if (!m_transport->hasSignals())
+        if (Result<Unit> received = m_transport->receive(wire::Clock::now() + std::chrono::milliseconds(timeout_milliseconds));
+            !received && received.error().code != Timeout)
+          debug_log("Now Playing: DBus read failed: {}", received.error().message);
+
+      return isConnected();
+    }
+
+    [[nodiscard]] auto popMessage() const -> Option<Message> {
+      return m_transport ? m_transport->popSignal() : None;
+    }
+
+    [[nodiscard]] auto sendWithReplyAndBlock(const Message& message, const i32 timeout_milliseconds = 1000) const
+      -> Result<Message> {
+      PendingCall call = TRY(sendWithReply(message, timeout_milliseconds));
+      return call.wait();
+    }
+
+    /**
+     * @brief Queue a method call without waiting for its reply
+     * @details Several calls can be in flight at once: they are written to the
+     * socket together on flush() (or the first wait()), and the replies are
+     * matched to their PendingCall by serial number as they arrive.
+     */
+    [[nodiscard]] auto sendWithReply(const Message& message, const i32 timeout_milliseconds = 1000) const -> Result<PendingCall> {
+      if (!isConnected() || !message.isMethodCall())
+        ERR(InvalidArgument, "Invalid connection or message");
+
+      const u32 serial = TRY(m_transport->queue(message));
+      return PendingCall(m_transport.get(), serial, wire::Clock::now() + std::chrono::milliseconds(timeout_milliseconds));
+    }
+
+    auto flush() const -> void {
+      if (m_transport)
+        if (Result<Unit> flushed = m_transport->flush(); !flushed)
+          m_transport->close();
+    }
+
+    /**
+     * @brief Connect to the bus at a DBus server address, e.g. `unix:path=/run/user/1000/bus`
+     */
+    static auto open(const StringView address) -> Result<Connection> {
+      return connect(wire::ParseAddress(address));
+    }
+
+    /**
+     * @brief Open a connection that is owned exclusively by the caller
+     * @details Uses DBUS_SESSION_BUS_ADDRESS (or DBUS_SYSTEM_BUS_ADDRESS),
+     * falling back to the standard socket locations. Losing the bus is
+     * reported through isConnected().
+     */
+    static auto busOpenPrivate(const BusType bus_type) -> Result<Connection> {
+      const bool  isSession = bus_type == BusType::Session;
+      const char* address   = std::getenv(isSession ? "DBUS_SESSION_BUS_ADDRESS" : "DBUS_SYSTEM_BUS_ADDRESS");
+
+      if (address && *address)
+        return open(address);
+
+      if (!isSession)
+        return connect(Array<wire::Endpoint, 1> { { { .path = "/var/run/dbus/system_bus_socket", .isAbstract = false } } });
+
+      const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+      if (!runtimeDir || !*runtimeDir)
+        ERR(ApiUnavailable, "Neither DBUS_SESSION_BUS_ADDRESS nor XDG_RUNTIME_DIR is set");
+
+      return connect(Array<wire::Endpoint, 1> { { { .path = std::format("{}/bus", runtimeDir), .isAbstract = false } } });
+    }
+  };
+} // namespace now_playing::dbus
@@ -0,0 +1,496 @@
+/**
+ * @file now_playing_mpd.hpp
+ * @brief Music Player Daemon client for the Now Playing plugin (Linux/BSD)
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Speaks the line-based MPD protocol over TCP or a Unix socket.
+ * A Connection is opened once and reused: every response is read through one
+ * receive buffer, and `key: value` pairs are handed to the caller as views
+ * into it, so decoding `status` and `currentsong` allocates only for the
+ * strings kept in MediaData. Both are requested in a single command list, so
+ * a refresh is one round trip.
+ *
+ * Any failure - a timeout, an ACK, a line that does not parse - closes the
+ * connection: after one, the stream position is unknown, and reading on
+ * could pair a late response with the next command. Callers reopen it.
+ *
+ * Endpoints follow MPD's own client conventions (MPD_HOST / MPD_PORT): a host
+ * starting with '/' is a socket path, one starting with '@' an abstract
+ * socket (Linux), and "password@host" sends the password after connecting.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+#include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+#include "now_playing_types.hpp"
+
+namespace now_playing::mpd {
+  using namespace draconis::utils::types;
+  using draconis::utils::error::DracError;
+  using enum draconis::utils::error::DracErrorCode;
+
+  using Clock = std::chrono::steady_clock;
+
+  inline constexpr u16   DEFAULT_PORT       = 6600;
+  inline constexpr i32   CONNECT_TIMEOUT_MS = 1000;
+  inline constexpr i32   COMMAND_TIMEOUT_MS = 500;
+  inline constexpr usize RECEIVE_CHUNK      = 4096;
+  inline constexpr usize MAX_LINE_LENGTH    = 1024 * 1024; // Longer lines mean a confused peer, not a song tag
+
+  /**
+   * @brief Where the MPD server listens
+   */
+  struct Endpoint {
+    String         host = "localhost"; // Hostname, or a socket path ('/...') or abstract name ('@...')
+    u16            port = DEFAULT_PORT;
+    Option<String> password;
+  };
+
+  /**
+   * @brief Fill in an endpoint from the config, then MPD_HOST / MPD_PORT, then the defaults
+   */
+  inline auto ResolveEndpoint(Option<String> host, Option<u16> port, Option<String> password) -> Endpoint {
+    Endpoint endpoint;
+
+    if (!host)
+      if (const char* envHost = std::getenv("MPD_HOST"); envHost && *envHost)
+        host = String(envHost);
+
+    if (host) {
+      // "password@host"; a leading '@' is an abstract socket, not an empty password
+      if (const usize separator = host->find('@'); separator != String::npos && separator > 0 && !host->starts_with('/')) {
+        if (!password)
+          password = host->substr(0, separator);
+        host->erase(0, separator + 1);
+      }
+      endpoint.host = std::move(*host);
+    }
+
+    if (!port)
+      if (const char* envPort = std::getenv("MPD_PORT"); envPort && *envPort) {
+        u16 parsed = 0;
+        if (const auto [end, errc] = std::from_chars(envPort, envPort + std::strlen(envPort), parsed); errc == std::errc {} && *end == '\0')
+          port = parsed;
+      }
+
+    endpoint.port     = port.value_or(DEFAULT_PORT);
+    endpoint.password = std::move(password);
+    return endpoint;
+  }
+
+  namespace detail {
+    inline auto RemainingMs(const Clock::time_point deadline) -> i32 {
+      using std::chrono::duration_cast, std::chrono::milliseconds;
+      return static_cast<i32>(std::clamp<i64>(duration_cast<milliseconds>(deadline - Clock::now()).count(), 0, INT_MAX));
+    }
+
+    inline auto ConnectUnix(const StringView path) -> Result<i32> {
+      sockaddr_un address {};
+      address.sun_family = AF_UNIX;
+
+      // Abstract names start with a NUL byte (written as '@') and are not NUL terminated
+      const bool  isAbstract = path.starts_with('@');
+      const usize suffix     = isAbstract ? 0 : 1;
+      if (path.size() + suffix > sizeof(address.sun_path))
+        ERR_FMT(InvalidArgument, "MPD socket path is too long: {}", path);
+
+      std::memcpy(address.sun_path, path.data(), path.size());
+      if (isAbstract)
+        address.sun_path[0] = '\0';
+      const auto length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + suffix);
+
+      const i32 socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (socket < 0)
+        ERR_FMT(IoError, "Failed to create MPD socket: {}", std::strerror(errno));
+
+      if (::connect(socket, reinterpret_cast<const sockaddr*>(&address), length) != 0) {
+        const i32 error = errno;
+        ::close(socket);
+        ERR_FMT(ApiUnavailable, "Failed to connect to MPD at {}: {}", path, std::strerror(error));
+      }
+
+      return socket;
+    }
+
+    /**
+     * @brief Connect one non-blocking TCP socket, bounded by the deadline
+     * @return The socket, switched back to blocking mode
+     */
+    inline auto ConnectAddress(const addrinfo& info, const Clock::time_point deadline) -> Result<i32> {
+      const i32 socket = ::socket(info.ai_family, info.ai_socktype | SOCK_CLOEXEC | SOCK_NONBLOCK, info.ai_protocol);
+      if (socket < 0)
+        ERR_FMT(IoError, "Failed to create MPD socket: {}", std::strerror(errno));
+
+      i32 error = 0;
+      if (::connect(socket, info.ai_addr, info.ai_addrlen) != 0) {
+        error = errno;
+
+        if (error == EINPROGRESS) {
+          pollfd request { .fd = socket, .events = POLLOUT, .revents = 0 };
+          socklen_t length = sizeof(error);
+
+          if (const i32 ready = ::poll(&request, 1, RemainingMs(deadline)); ready <= 0)
+            error = ready == 0 ? ETIMEDOUT : errno;
+          else if (::getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &length) != 0)
+            error = errno;
+        }
+      }
+
+      if (error != 0) {
+        ::close(socket);
+        ERR_FMT(ApiUnavailable, "Failed to connect to MPD: {}", std::strerror(error));
+      }
+
+      ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) & ~O_NONBLOCK);
+      return socket;
+    }
+
+    inline auto ConnectTcp(const String& host, const u16 port, const Clock::time_point deadline) -> Result<i32> {
+      addrinfo hints {};
+      hints.ai_family   = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+
+      addrinfo* results = nullptr;
+      if (const i32 status = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &results); status != 0)
+        ERR_FMT(ApiUnavailable, "Failed to resolve MPD host {}: {}", host, ::gai_strerror(status));
+
+      Result<i32> socket = Err(DracError(ApiUnavailable, std::format("No address for MPD host {}", host)));
+      for (const addrinfo* info = results; info; info = info->ai_next)
+        if ((socket = ConnectAddress(*info, deadline)))
+          break;
+
+      ::freeaddrinfo(results);
+      return socket;
+    }
+
+    // Arguments are double-quoted with backslash escapes
+    inline auto Quote(const StringView argument) -> String {
+      String quoted = "\"";
+      for (const char character : argument) {
+        if (character == '"' || character == '\\')
+          quoted += '\\';
+        quoted += character;
+      }
+      quoted += '"';
+      return quoted;
+    }
+
+    // "3/12" -> 3
+    inline auto ParseLeadingInt(const StringView value) -> Option<i32> {
+      i32 number = 0;
+      if (const auto [end, errc] = std::from_chars(value.data(), value.data() + value.size(), number); errc != std::errc {})
+        return None;
+      return number;
+    }
+
+    // "123.456" seconds -> microseconds
+    inline auto ParseSecondsUs(const StringView value) -> Option<i64> {
+      f64 seconds = 0;
+      if (const auto [end, errc] = std::from_chars(value.data(), value.data() + value.size(), seconds); errc != std::errc {})
+        return None;
+      return static_cast<i64>(seconds * 1'000'000.0);
+    }
+  } // namespace detail
+
+  /**
+   * @brief One connection to an MPD server
+   * @details Not thread-safe; each thread that talks to MPD opens its own.
+   */
+  class Connection {
+    i32       m_socket = -1;
+    Vec<char> m_buffer; // Receive buffer, reused for every response
+    usize     m_begin = 0;
+    usize     m_end   = 0;
+    String    m_version; // Protocol version from the greeting
+
+    explicit Connection(const i32 socket) : m_socket(socket) {}
+
+    auto fill(const Clock::time_point deadline) -> Result<Unit> {
+      if (!isOpen())
+        ERR(ApiUnavailable, "MPD connection is closed");
+
+      pollfd request { .fd = m_socket, .events = POLLIN, .revents = 0 };
+
+      const i32 ready = ::poll(&request, 1, detail::RemainingMs(deadline));
+      if (ready < 0) {
+        if (errno == EINTR)
+          return {};
+        const i32 error = errno;
+        close();
+        ERR_FMT(IoError, "Failed to poll the MPD socket: {}", std::strerror(error));
+      }
+      // A late response would be read as the answer to the next command
+      if (ready == 0) {
+        close();
+        ERR(Timeout, "Timed out waiting for MPD");
+      }
+
+      // Keep the unread tail at the front so the buffer never grows past one line plus a chunk
+      if (m_begin > 0) {
+        std::copy(m_buffer.begin() + static_cast<isize>(m_begin), m_buffer.begin() + static_cast<isize>(m_end), m_buffer.begin());
+        m_end -= m_begin;
+        m_begin = 0;
+      }
+      if (m_buffer.size() - m_end < RECEIVE_CHUNK)
+        m_buffer.resize(m_end + RECEIVE_CHUNK);
+
+      const isize received = ::recv(m_socket, m_buffer.data() + m_end, m_buffer.size() - m_end, 0);
+      if (received == 0) {
+        close();
+        ERR(ApiUnavailable, "MPD closed the connection");
+      }
+      if (received < 0) {
+        if (errno == EINTR || errno == EAGAIN)
+          return {};
+        const i32 error = errno;
+        close();
+        ERR_FMT(IoError, "Failed to read from MPD: {}", std::strerror(error));
+      }
+
+      m_end += static_cast<usize>(received);
+      return {};
+    }
+
+    /**
+     * @brief Next line without its newline; valid until the next read
+     */
+    auto readLine(const Clock::time_point deadline) -> Result<StringView> {
+      while (true) {
+        const StringView pending(m_buffer.data() + m_begin, m_end - m_begin);
+
+        if (const usize newline = pending.find('\n'); newline != StringView::npos) {
+          m_begin += newline + 1;
+          return pending.substr(0, newline);
+        }
+
+        if (pending.size() > MAX_LINE_LENGTH) {
+          close();
+          ERR(ParseError, "MPD sent an overlong line");
+        }
+
+        TRY_VOID(fill(deadline));
+      }
+    }
+
+    auto writeAll(StringView data) -> Result<Unit> {
+      while (!data.empty()) {
+        const isize sent = ::send(m_socket, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+          if (errno == EINTR)
+            continue;
+          const i32 error = errno;
+          close();
+          ERR_FMT(IoError, "Failed to write to MPD: {}", std::strerror(error));
+        }
+        data.remove_prefix(static_cast<usize>(sent));
+      }
+      return {};
+    }
+
+   public:
+    /**
+     * @brief Connect, read the greeting and authenticate if a password is set
+     */
+    static auto open(const Endpoint& endpoint) -> Result<Connection> {
+      const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(CONNECT_TIMEOUT_MS);
+
+      const bool isSocket = endpoint.host.starts_with('/') || endpoint.host.starts_with('@');
+      Connection connection(TRY(isSocket ? detail::ConnectUnix(endpoint.host) : detail::ConnectTcp(endpoint.host, endpoint.port, deadline)));
+
+      const StringView greeting = TRY(connection.readLine(deadline));
+      if (!greeting.starts_with("OK MPD ")) {
+        connection.close();
+        ERR_FMT(ParseError, "Unexpected MPD greeting: {}", greeting);
+      }
+      connection.m_version = String(greeting.substr(7));
+
+      if (endpoint.password)
+        TRY_VOID(connection.command("password " + detail::Quote(*endpoint.password), [](StringView, StringView) {}));
+
+      return connection;
+    }
+
+    [[nodiscard]] auto isOpen() const -> bool {
+      return m_socket >= 0;
+    }
+
+    [[nodiscard]] auto socket() const -> i32 {
+      return m_socket;
+    }
+
+    [[nodiscard]] auto version() const -> StringView {
+      return m_version;
+    }
+
+    auto close() -> void {
+      if (m_socket >= 0)
+        ::close(m_socket);
+      m_socket = -1;
+      m_begin = m_end = 0;
+    }
+
+    /**
+     * @brief Send one command line (or a newline-separated command list)
+     */
+    auto send(const StringView command) -> Result<Unit> {
+      if (!isOpen())
+        ERR(ApiUnavailable, "MPD connection is closed");
+
+      String line;
+      line.reserve(command.size() + 1);
+      line.append(command);
+      line += '\n';
+      return writeAll(line);
+    }
+
+    /**
+     * @brief Whether a response has started arriving, waiting up to `timeoutMs`
+     */
+    auto waitReadable(const i32 timeoutMs) const -> bool {
+      if (m_begin < m_end)
+        return true;
+
+      pollfd request { .fd = m_socket, .events = POLLIN, .revents = 0 };
+      return ::poll(&request, 1, timeoutMs) > 0;
+    }
+
+    /**
+     * @brief Read one response, passing each `key: value` pair to `onPair`
+     * @details The views are only valid during the call. An ACK becomes an
+     * error. Like every other failure it closes the connection, so nothing
+     * left of this response can be mistaken for the next one.
+     */
+    template <typename OnPair>
+    auto receive(OnPair&& onPair, const i32 timeoutMs = COMMAND_TIMEOUT_MS) -> Result<Unit> {
+      const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+      while (true) {
+        const StringView line = TRY(readLine(deadline));
+
+        if (line == "OK")
+          return {};
+
+        if (line.starts_with("ACK ")) {
+          close(); // Leaves the buffer, and so `line`, intact
+          ERR_FMT(PlatformSpecific, "MPD error: {}", line.substr(4));
+        }
+
+        if (line == "list_OK")
+          continue;
+
+        const usize separator = line.find(": ");
+        if (separator == StringView::npos) {
+          close();
+          ERR_FMT(ParseError, "Malformed MPD response line: {}", line);
+        }
+
+        onPair(line.substr(0, separator), line.substr(separator + 2));
+      }
+    }
+
+    template <typename OnPair>
+    auto command(const StringView command, OnPair&& onPair) -> Result<Unit> {
+      TRY_VOID(send(command));
+      return receive(std::forward<OnPair>(onPair));
+    }
+
+    Connection(const Connection&)                    = delete;
+    auto operator=(const Connection&) -> Connection& = delete;
+
+    Connection(Connection&& other) noexcept
+      : m_socket(std::exchange(other.m_socket, -1)),
+        m_buffer(std::move(other.m_buffer)),
+        m_begin(std::exchange(other.m_begin, 0)),
+        m_end(std::exchange(other.m_end, 0)),
+        m_version(std::move(other.m_version)) {}
+
+    auto operator=(Connection&& other) noexcept -> Connection& {
+      if (this != &other) {
+        close();
+        m_socket  = std::exchange(other.m_socket, -1);
+        m_buffer  = std::move(other.m_buffer);
+        m_begin   = std::exchange(other.m_begin, 0);
+        m_end     = std::exchange(other.m_end, 0);
+        m_version = std::move(other.m_version);
+      }
+      return *this;
+    }
+
+    ~Connection() {
+      close();
+    }
+  };
+
+  /**
+   * @brief Read the player status and current song in one round trip
+   */
+  inline auto FetchMedia(Connection& connection) -> Result<MediaData> {
+    MediaData      data;
+    Option<String> name; // Stream name, used when a stream has no title
+    Option<String> file;
+
+    data.playerName = "mpd";
+
+    TRY_VOID(connection.command("command_list_begin\nstatus\ncurrentsong\ncommand_list_end", [&](const StringView key, const StringView value) {
+      if (key == "state")
+        data.status = value == "play" ? PlaybackStatus::Playing : value == "pause" ? PlaybackStatus::Paused : PlaybackStatus::Stopped;
+      else if (key == "elapsed")
+        data.positionUs = detail::ParseSecondsUs(value);
+      else if (key == "duration")
+        data.lengthUs = detail::ParseSecondsUs(value);
+      else if (key == "Title")
+        data.title = String(value);
+      else if (key == "Artist")
+        data.artists.emplace_back(value);
+      else if (key == "Album")
+        data.album = String(value);
+      else if (key == "Track")
+        data.trackNumber = detail::ParseLeadingInt(value);
+      else if (key == "Id")
+        data.trackId = String(value);
+      else if (key == "Name")
+        name = String(value);
+      else if (key == "file")
+        file = String(value);
+    }));
+
+    data.positionSampledAt = MonotonicClock::now();
+
+    for (const String& artist : data.artists) {
+      if (data.artist)
+        *data.artist += ", ";
+      else
+        data.artist = String();
+      *data.artist += artist;
+    }
+
+    if (file && file->contains("://"))
+      data.url = *file;
+
+    // Untagged files show their name, as MPD clients do
+    if (!data.title && file)
+      data.title = name ? *name : file->substr(file->rfind('/') + 1);
+
+    return data;
+  }
+} // namespace now_playing::mpd
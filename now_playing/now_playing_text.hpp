@@ -0,0 +1,340 @@
+/**
+ * @file now_playing_text.hpp
+ * @brief UTF-8 repair and terminal width handling for media strings
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Players hand over titles and artists verbatim: invalid UTF-8,
+ * embedded newlines, and wide CJK or emoji characters all show up in
+ * practice. Sanitize() repairs a string in place, replacing each maximal
+ * invalid sequence with U+FFFD and control characters with spaces, and
+ * leaves valid text untouched without allocating. DisplayWidth() and
+ * Truncate() measure text in terminal columns using a compile-time table of
+ * East Asian wide and zero-width ranges.
+ *
+ * Most media strings are plain ASCII, so every entry point first skips the
+ * printable ASCII prefix eight bytes at a time (SWAR) before decoding.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <Drac++/Utils/Types.hpp>
+
+namespace now_playing::text {
+  using namespace draconis::utils::types;
+
+  inline constexpr char32_t   REPLACEMENT_CHARACTER = U'\uFFFD';
+  inline constexpr StringView REPLACEMENT_UTF8      = "\xEF\xBF\xBD";
+  inline constexpr StringView ELLIPSIS              = "\xE2\x80\xA6"; // U+2026, one column wide
+
+  namespace detail {
+    inline constexpr u64 ONES  = 0x0101010101010101;
+    inline constexpr u64 HIGHS = 0x8080808080808080;
+
+    constexpr auto IsPrintableAscii(const char byte) -> bool {
+      return byte >= 0x20 && byte < 0x7F;
+    }
+
+    /**
+     * @brief Whether any of the eight bytes is outside 0x20..0x7E
+     * @details The three terms flag bytes below 0x20, at or above 0x80, and
+     * 0x7F respectively. Borrows and carries between lanes can only add false
+     * positives, which the scalar loop then resolves.
+     */
+    constexpr auto HasNonPrintable(const u64 word) -> bool {
+      return ((((word - (ONES * 0x20)) & ~word) | word | (word + ONES)) & HIGHS) != 0;
+    }
+
+    static_assert(!HasNonPrintable(0x2020202020202020) && !HasNonPrintable(0x7E7E7E7E7E7E7E7E));
+    static_assert(HasNonPrintable(0x2020202020201F20) && HasNonPrintable(0x7F20202020202020));
+    static_assert(HasNonPrintable(0x20202020C3202020) && HasNonPrintable(0x0A20202020202020));
+
+    struct CodepointRange {
+      char32_t first;
+      char32_t last;
+    };
+
+    // Combining marks, joiners, variation selectors and other characters that
+    // occupy no column of their own (the common ranges, not every Mn/Me/Cf)
+    inline constexpr Array ZERO_WIDTH = {
+      CodepointRange { 0x0300, 0x036F },   CodepointRange { 0x0483, 0x0489 },   CodepointRange { 0x0591, 0x05BD },
+      CodepointRange { 0x0610, 0x061A },   CodepointRange { 0x064B, 0x065F },   CodepointRange { 0x0900, 0x0902 },
+      CodepointRange { 0x093C, 0x093C },   CodepointRange { 0x0941, 0x0948 },   CodepointRange { 0x094D, 0x094D },
+      CodepointRange { 0x0E31, 0x0E31 },   CodepointRange { 0x0E34, 0x0E3A },   CodepointRange { 0x0E47, 0x0E4E },
+      CodepointRange { 0x1160, 0x11FF },   CodepointRange { 0x1AB0, 0x1AFF },   CodepointRange { 0x1DC0, 0x1DFF },
+      CodepointRange { 0x200B, 0x200F },   CodepointRange { 0x202A, 0x202E },   CodepointRange { 0x2060, 0x2064 },
+      CodepointRange { 0x20D0, 0x20FF },   CodepointRange { 0x302A, 0x302D },   CodepointRange { 0x3099, 0x309A },
+      CodepointRange { 0xFE00, 0xFE0F },   CodepointRange { 0xFE20, 0xFE2F },   CodepointRange { 0xFEFF, 0xFEFF },
+      CodepointRange { 0x1F3FB, 0x1F3FF }, CodepointRange { 0xE0000, 0xE007F }, CodepointRange { 0xE0100, 0xE01EF },
+    };
+
+    // East Asian Wide and Fullwidth characters plus emoji with default emoji
+    // presentation. Emoji blocks are taken whole, which also widens the few
+    // text-presentation symbols inside them.
+    inline constexpr Array WIDE = {
+      CodepointRange { 0x1100, 0x115F },   CodepointRange { 0x231A, 0x231B },   CodepointRange { 0x2329, 0x232A },
+      CodepointRange { 0x23E9, 0x23EC },   CodepointRange { 0x23F0, 0x23F0 },   CodepointRange { 0x23F3, 0x23F3 },
+      CodepointRange { 0x25FD, 0x25FE },   CodepointRange { 0x2614, 0x2615 },   CodepointRange { 0x2648, 0x2653 },
+      CodepointRange { 0x267F, 0x267F },   CodepointRange { 0x2693, 0x2693 },   CodepointRange { 0x26A1, 0x26A1 },
+      CodepointRange { 0x26AA, 0x26AB },   CodepointRange { 0x26BD, 0x26BE },   CodepointRange { 0x26C4, 0x26C5 },
+      CodepointRange { 0x26CE, 0x26CE },   CodepointRange { 0x26D4, 0x26D4 },   CodepointRange { 0x26EA, 0x26EA },
+      CodepointRange { 0x26F2, 0x26F3 },   CodepointRange { 0x26F5, 0x26F5 },   CodepointRange { 0x26FA, 0x26FA },
+      CodepointRange { 0x26FD, 0x26FD },   CodepointRange { 0x2705, 0x2705 },   CodepointRange { 0x270A, 0x270B },
+      CodepointRange { 0x2728, 0x2728 },   CodepointRange { 0x274C, 0x274C },   CodepointRange { 0x274E, 0x274E },
+      CodepointRange { 0x2753, 0x2755 },   CodepointRange { 0x2757, 0x2757 },   CodepointRange { 0x2795, 0x2797 },
+      CodepointRange { 0x27B0, 0x27B0 },   CodepointRange { 0x27BF, 0x27BF },   CodepointRange { 0x2B1B, 0x2B1C },
+      CodepointRange { 0x2B50, 0x2B50 },   CodepointRange { 0x2B55, 0x2B55 },   CodepointRange { 0x2E80, 0x3029 },
+      CodepointRange { 0x302E, 0x303E },   CodepointRange { 0x3041, 0x3098 },   CodepointRange { 0x309B, 0x33FF },
+      CodepointRange { 0x3400, 0x4DBF },   CodepointRange { 0x4E00, 0xA4CF },   CodepointRange { 0xA960, 0xA97F },
+      CodepointRange { 0xAC00, 0xD7A3 },   CodepointRange { 0xF900, 0xFAFF },   CodepointRange { 0xFE10, 0xFE19 },
+      CodepointRange { 0xFE30, 0xFE6F },   CodepointRange { 0xFF00, 0xFF60 },   CodepointRange { 0xFFE0, 0xFFE6 },
+      CodepointRange { 0x16FE0, 0x16FE4 }, CodepointRange { 0x17000, 0x18CFF }, CodepointRange { 0x1B000, 0x1B2FF },
+      CodepointRange { 0x1F004, 0x1F004 }, CodepointRange { 0x1F0CF, 0x1F0CF }, CodepointRange { 0x1F18E, 0x1F18E },
+      CodepointRange { 0x1F191, 0x1F19A }, CodepointRange { 0x1F200, 0x1F251 }, CodepointRange { 0x1F260, 0x1F265 },
+      CodepointRange { 0x1F300, 0x1F3FA }, CodepointRange { 0x1F400, 0x1F64F }, CodepointRange { 0x1F680, 0x1F6FF },
+      CodepointRange { 0x1F7E0, 0x1F7F0 }, CodepointRange { 0x1F900, 0x1F9FF }, CodepointRange { 0x1FA70, 0x1FAFF },
+      CodepointRange { 0x20000, 0x2FFFD }, CodepointRange { 0x30000, 0x3FFFD },
+    };
+
+    template <usize N>
+    constexpr auto IsSortedDisjoint(const Array<CodepointRange, N>& ranges) -> bool {
+      for (usize index = 0; index < N; ++index) {
+        if (ranges[index].first > ranges[index].last)
+          return false;
+        if (index > 0 && ranges[index - 1].last >= ranges[index].first)
+          return false;
+      }
+      return true;
+    }
+
+    static_assert(IsSortedDisjoint(ZERO_WIDTH), "ZERO_WIDTH must be sorted and non-overlapping");
+    static_assert(IsSortedDisjoint(WIDE), "WIDE must be sorted and non-overlapping");
+
+    template <usize N>
+    constexpr auto InRanges(const Array<CodepointRange, N>& ranges, const char32_t codepoint) -> bool {
+      if (codepoint < ranges.front().first || codepoint > ranges.back().last)
+        return false;
+
+      // First range ending at or after the codepoint
+      const auto range = std::ranges::lower_bound(ranges, codepoint, {}, &CodepointRange::last);
+      return range != ranges.end() && range->first <= codepoint;
+    }
+
+    struct Decoded {
+      char32_t codepoint;
+      u8       length; // Bytes consumed; for an invalid sequence, its maximal subpart
+      bool     valid;
+    };
+
+    constexpr auto IsContinuation(const u8 byte, const u8 low = 0x80, const u8 high = 0xBF) -> bool {
+      return byte >= low && byte <= high;
+    }
+
+    /**
+     * @brief Decode one codepoint starting at `pos`
+     * @details Follows the Unicode "maximal subpart" rule, so overlong forms,
+     * surrogates and values past U+10FFFF are rejected and each invalid
+     * sequence is replaced by exactly one U+FFFD.
+     */
+    constexpr auto Decode(const StringView text, const usize pos) -> Decoded {
+      const usize remaining = text.size() - pos;
+      const auto  byte      = [&](const usize offset) -> u8 { return static_cast<u8>(text[pos + offset]); };
+
+      const u8 lead = byte(0);
+      if (lead < 0x80)
+        return { .codepoint = lead, .length = 1, .valid = true };
+
+      u8       length = 0;
+      char32_t value  = 0;
+      u8       low    = 0x80; // Bounds of the second byte, which rule out overlongs and surrogates
+      u8       high   = 0xBF;
+
+      if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        value  = lead & 0x1F;
+      } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        value  = lead & 0x0F;
+        low    = lead == 0xE0 ? 0xA0 : 0x80;
+        high   = lead == 0xED ? 0x9F : 0xBF;
+      } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        value  = lead & 0x07;
+        low    = lead == 0xF0 ? 0x90 : 0x80;
+        high   = lead == 0xF4 ? 0x8F : 0xBF;
+      } else {
+        return { .codepoint = REPLACEMENT_CHARACTER, .length = 1, .valid = false };
+      }
+
+      for (u8 index = 1; index < length; ++index) {
+        const bool inRange = index < remaining && (index == 1 ? IsContinuation(byte(index), low, high) : IsContinuation(byte(index)));
+        if (!inRange)
+          return { .codepoint = REPLACEMENT_CHARACTER, .length = index, .valid = false };
+        value = (value << 6) | (byte(index) & 0x3F);
+      }
+
+      return { .codepoint = value, .length = length, .valid = true };
+    }
+
+    static_assert(Decode("\xC3\xA9", 0).codepoint == U'\u00E9' && Decode("\xC3\xA9", 0).length == 2);
+    static_assert(Decode("\xF0\x9F\x8E\xB5", 0).codepoint == U'\U0001F3B5');
+    static_assert(!Decode("\xC0\xAF", 0).valid && Decode("\xC0\xAF", 0).length == 1);         // Overlong
+    static_assert(!Decode("\xED\xA0\x80", 0).valid && Decode("\xED\xA0\x80", 0).length == 1); // Surrogate
+    static_assert(!Decode("\xE2\x82", 0).valid && Decode("\xE2\x82", 0).length == 2);         // Truncated
+
+    constexpr auto IsControl(const char32_t codepoint) -> bool {
+      return codepoint < 0x20 || (codepoint >= 0x7F && codepoint < 0xA0);
+    }
+  } // namespace detail
+
+  /**
+   * @brief Length of the leading run of printable ASCII
+   */
+  inline auto PrintableAsciiPrefix(const StringView text) -> usize {
+    usize pos = 0;
+
+    for (; pos + sizeof(u64) <= text.size(); pos += sizeof(u64)) {
+      u64 word = 0;
+      std::memcpy(&word, text.data() + pos, sizeof(word));
+      if (detail::HasNonPrintable(word))
+        break;
+    }
+
+    while (pos < text.size() && detail::IsPrintableAscii(text[pos]))
+      ++pos;
+
+    return pos;
+  }
+
+  /**
+   * @brief Columns a codepoint occupies in a terminal: 0, 1 or 2
+   */
+  constexpr auto CodepointWidth(const char32_t codepoint) -> usize {
+    if (codepoint < 0x300)
+      return detail::IsControl(codepoint) ? 0 : 1;
+    if (detail::InRanges(detail::ZERO_WIDTH, codepoint))
+      return 0;
+    return detail::InRanges(detail::WIDE, codepoint) ? 2 : 1;
+  }
+
+  static_assert(CodepointWidth(U'a') == 1 && CodepointWidth(U'\u00E9') == 1);
+  static_assert(CodepointWidth(U'\u3042') == 2 && CodepointWidth(U'\uAC00') == 2 && CodepointWidth(U'\U0001F3B5') == 2);
+  static_assert(CodepointWidth(U'\u0301') == 0 && CodepointWidth(U'\u200D') == 0 && CodepointWidth(U'\uFE0F') == 0);
+
+  /**
+   * @brief Repair a string in place so it is valid UTF-8 without control characters
+   * @details Invalid sequences become U+FFFD and control characters (tabs,
+   * newlines, C1 controls) become spaces. Text that needs no repair is left
+   * as is, without allocating.
+   * @return true if the string was changed
+   */
+  inline auto Sanitize(String& text) -> bool {
+    usize pos = PrintableAsciiPrefix(text);
+
+    // Find the first byte that needs repair, if any
+    while (pos < text.size()) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      if (!decoded.valid || detail::IsControl(decoded.codepoint))
+        break;
+      pos += decoded.length;
+      pos += PrintableAsciiPrefix(StringView(text).substr(pos));
+    }
+
+    if (pos == text.size())
+      return false;
+
+    String repaired;
+    repaired.reserve(text.size() + REPLACEMENT_UTF8.size());
+    repaired.append(text, 0, pos);
+
+    while (pos < text.size()) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+
+      if (!decoded.valid)
+        repaired += REPLACEMENT_UTF8;
+      else if (detail::IsControl(decoded.codepoint))
+        repaired += ' ';
+      else
+        repaired.append(text, pos, decoded.length);
+
+      pos += decoded.length;
+
+      const usize run = PrintableAsciiPrefix(StringView(text).substr(pos));
+      repaired.append(text, pos, run);
+      pos += run;
+    }
+
+    text = std::move(repaired);
+    return true;
+  }
+
+  /**
+   * @brief Columns a string occupies in a terminal
+   */
+  inline auto DisplayWidth(const StringView text) -> usize {
+    usize pos   = PrintableAsciiPrefix(text);
+    usize width = pos;
+
+    while (pos < text.size()) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      width += decoded.valid ? CodepointWidth(decoded.codepoint) : 1;
+      pos += decoded.length;
+
+      // Printable ASCII is one column per byte
+      const usize run = PrintableAsciiPrefix(text.substr(pos));
+      width += run;
+      pos += run;
+    }
+
+    return width;
+  }
+
+  /**
+   * @brief Fit a string into `columns` terminal columns
+   * @details Text that fits is returned unchanged; otherwise it is cut at a
+   * codepoint boundary and ends in an ellipsis. Zero-width characters stay
+   * with the character they follow, and a wide character that would straddle
+   * the limit is dropped rather than split. Only about `columns` columns of
+   * the input are examined, however long it is.
+   */
+  inline auto Truncate(const StringView text, const usize columns) -> String {
+    const usize budget = columns == 0 ? 0 : columns - 1; // The ellipsis takes the last column
+
+    usize         pos   = 0;
+    usize         width = 0;
+    Option<usize> cut; // Where the text ends once it is known not to fit
+
+    while (pos < text.size() && width <= columns) {
+      // Printable ASCII is one column per byte; no need to look past the limit
+      if (const usize run = PrintableAsciiPrefix(text.substr(pos, columns + 1 - width)); run > 0) {
+        if (!cut && width + run > budget)
+          cut = pos + (budget - width);
+        width += run;
+        pos += run;
+        continue;
+      }
+
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      const usize           cost    = decoded.valid ? CodepointWidth(decoded.codepoint) : 1;
+      if (!cut && width + cost > budget)
+        cut = pos;
+      width += cost;
+      pos += decoded.length;
+    }
+
+    if (width <= columns)
+      return String(text);
+
+    if (columns == 0)
+      return {};
+
+    String truncated;
+    truncated.reserve(*cut + ELLIPSIS.size());
+    truncated.append(text.substr(0, *cut));
+    truncated += ELLIPSIS;
+    return truncated;
+  }
+} // namespace now_playing::text
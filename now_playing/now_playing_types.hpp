@@ -5,25 +5,131 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+
 #include <Drac++/Utils/Types.hpp>
 
 namespace now_playing {
   using namespace draconis::utils::types;
 
+  using MonotonicClock = std::chrono::steady_clock;
+
+  /**
+   * @brief Playback state reported by the player
+   */
+  enum class PlaybackStatus : u8 {
+    Unknown,
+    Playing,
+    Paused,
+    Stopped,
+  };
+
   /**
    * @brief Media information data structure
    */
   struct MediaData {
     Option<String> title;
-    Option<String> artist;
+    Option<String> artist; // Display string; every credited artist, comma separated
     Option<String> album;
     Option<String> playerName;
+    PlaybackStatus status = PlaybackStatus::Unknown;
+    Option<i64>    lengthUs; // Track length in microseconds
+    Option<String> trackId;
+    Option<String> artUrl;
+    Option<i32>    trackNumber;
+    Vec<String>    artists;
+    Option<String> url;
+
+    // Position is sampled occasionally and extrapolated in between (see ExtrapolatePosition)
+    Option<i64>                positionUs;        // Position at positionSampledAt, in microseconds
+    f64                        rate = 1.0;        // Playback rate since positionSampledAt
+    MonotonicClock::time_point positionSampledAt; // When positionUs was taken
+  };
+
+  /**
+   * @brief Playback position at `now`, extrapolated from the last sample
+   * @details The position only advances while playing, scaled by the playback
+   * rate, and is clamped to the track length.
+   */
+  inline auto ExtrapolatePosition(const MediaData& data, const MonotonicClock::time_point now) -> Option<i64> {
+    if (!data.positionUs)
+      return None;
+
+    i64 position = *data.positionUs;
+
+    if (data.status == PlaybackStatus::Playing) {
+      const i64 elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - data.positionSampledAt).count();
+      position += static_cast<i64>(static_cast<f64>(elapsedUs) * data.rate);
+    }
+
+    if (data.lengthUs && *data.lengthUs > 0)
+      position = std::min(position, *data.lengthUs);
+
+    return std::max<i64>(position, 0);
+  }
+
+  /**
+   * @brief Fold the time elapsed since the last sample into the position
+   * @details Called before the status or rate changes, so the time up to now
+   * is credited at the old rate.
+   */
+  inline auto AnchorPosition(MediaData& data, const MonotonicClock::time_point now) -> void {
+    data.positionUs        = ExtrapolatePosition(data, now);
+    data.positionSampledAt = now;
+  }
+
+  /**
+   * @brief Whether a host showing `before` has to re-render to show `after`
+   * @details Only the player, the track and the playback status count; the
+   * position advances on its own and is not a change.
+   */
+  inline auto IsVisibleChange(const MediaData& before, const MediaData& after) -> bool {
+    return before.playerName != after.playerName || before.status != after.status || before.trackId != after.trackId ||
+      before.title != after.title || before.artist != after.artist || before.album != after.album;
+  }
+
+  constexpr auto PlaybackStatusName(const PlaybackStatus status) -> Option<StringView> {
+    switch (status) {
+      case PlaybackStatus::Playing: return "playing";
+      case PlaybackStatus::Paused:  return "paused";
+      case PlaybackStatus::Stopped: return "stopped";
+      case PlaybackStatus::Unknown: return None;
+    }
+    return None;
+  }
+
+  /**
+   * @brief How the plugin obtains player state
+   */
+  enum class CollectionMode : u8 {
+    Poll,   // Query the player on every collection
+    Events, // Keep a snapshot up to date from change notifications; collection reads it
+  };
+
+  /**
+   * @brief Where media information comes from on Linux/BSD
+   */
+  enum class Backend : u8 {
+    Mpris, // Every MPRIS player on the session bus
+    Mpd,   // One Music Player Daemon server
   };
 
   /**
    * @brief Plugin configuration
    */
   struct NowPlayingConfig {
-    bool enabled = true;
+    bool           enabled = true;
+    CollectionMode mode    = CollectionMode::Poll;
+    Vec<String>    playerPriority; // Preferred player names, most preferred first
+    bool           artCache      = false;            // Copy album art into the plugin cache directory
+    u64            artCacheBytes = 64 * 1024 * 1024; // Size budget for the art cache
+    u32            artSize       = 512;              // Longest edge of cached art in pixels, 0 to keep the original
+    Option<String> busAddress;                       // DBus address to use instead of the session bus
+    u64            maxWidth = 0;                     // Display value width in terminal columns, 0 for no limit
+    Backend        backend  = Backend::Mpris;
+    Option<String> mpdHost;     // Falls back to MPD_HOST, then localhost
+    Option<u16>    mpdPort;     // Falls back to MPD_PORT, then 6600
+    Option<String> mpdPassword; // Falls back to the password in MPD_HOST, if any
   };
 } // namespace now_playing
@@ -0,0 +1,270 @@
+/**
+ * @file template_format.cpp
+ * @brief User-template output format plugin for Draconis++
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details This plugin renders system information through a template that
+ * the user edits, so a layout change needs no rebuild. It supports a single
+ * output mode:
+ * - "template": The user's template, rendered against the current data
+ *
+ * The template is read from <configDir>/template.tmpl when the plugin is
+ * initialized and compiled once into an instruction list (see
+ * template_program.hpp for the tag syntax). A missing file is created with
+ * the default template below. A template that does not compile makes
+ * initialize() fail with the file, line and column of the problem.
+ *
+ * Output files get the extension set in the plugin's config:
+ *   extension = "html"
+ * Without one, the default template's output is saved as ".md" and that of
+ * any other template as ".txt".
+ *
+ * This file supports both dynamic (shared library) and static compilation.
+ * When compiled as a static plugin (DRAC_STATIC_PLUGIN_BUILD defined),
+ * it exports factory functions in a namespace instead of extern "C".
+ */
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+
+#include <Drac++/Core/Plugin.hpp>
+
+#include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Logging.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+#include "template_program.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+  using namespace draconis::utils::types;
+
+  // Written to <configDir>/template.tmpl on first use. Lays out the markdown
+  // format's document; tests/template_format/template_test.cpp compares the two.
+  constexpr StringView DEFAULT_TEMPLATE = R"({{! Layout of the "template" output format. Tags are described in template_program.hpp. }}
+# System Information
+
+{{#if date or weather_temperature | round}}
+## General
+
+{{#if date}}
+- **Date**: {{date}}
+{{/if}}
+{{#if weather_temperature | round}}
+- **Weather**: {{weather_temperature | round}}°{{#if weather_town}} in {{weather_town}}{{else}}{{#if weather_description}}, {{weather_description}}{{/if}}{{/if}}
+{{/if}}
+
+{{/if}}
+{{#if host or os or kernel}}
+## System
+
+{{#if host}}
+- **Host**: {{host}}
+{{/if}}
+{{#if os}}
+- **OS**: {{os}}
+{{/if}}
+{{#if kernel}}
+- **Kernel**: {{kernel}}
+{{/if}}
+
+{{/if}}
+{{#if ram or disk or cpu or gpu or uptime}}
+## Hardware
+
+{{#if ram}}
+- **RAM**: {{ram}}
+{{/if}}
+{{#if disk}}
+- **Disk**: {{disk}}
+{{/if}}
+{{#if cpu}}
+- **CPU**: {{cpu}}
+{{/if}}
+{{#if gpu}}
+- **GPU**: {{gpu}}
+{{/if}}
+{{#if uptime}}
+- **Uptime**: {{uptime}}
+{{/if}}
+
+{{/if}}
+{{#if shell or packages | nonzero}}
+## Software
+
+{{#if shell}}
+- **Shell**: {{shell}}
+{{/if}}
+{{#if packages | nonzero}}
+- **Packages**: {{packages}}
+{{/if}}
+
+{{/if}}
+{{#if de or wm}}
+## Environment
+
+{{#if de}}
+- **Desktop Environment**: {{de}}
+{{/if}}
+{{#if wm}}
+- **Window Manager**: {{wm}}
+{{/if}}
+
+{{/if}}
+{{#if plugins}}
+## Plugin Data
+
+{{#each plugins}}
+### {{@id}}
+
+{{#each fields}}
+- **{{@name}}**: {{@value}}
+{{/each}}
+
+{{/each}}
+{{/if}}
+)";
+
+  auto Trim(const StringView text) -> StringView {
+    const usize first = text.find_first_not_of(" \t\r");
+    if (first == StringView::npos)
+      return {};
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+  }
+
+  class TemplateFormatPlugin : public draconis::core::plugin::IOutputFormatPlugin {
+   private:
+    draconis::core::plugin::PluginMetadata m_metadata;
+    bool                                   m_ready = false;
+    Option<template_format::Program>       m_program;
+    Option<String>                         m_extension; // From setConfig()
+    bool                                   m_defaultTemplate = false;
+
+    static constexpr auto FORMAT_TEMPLATE = "template";
+
+    static auto loadTemplate(const fs::path& templatePath) -> Result<String> {
+      if (!fs::exists(templatePath)) {
+        createDefaultTemplate(templatePath);
+        return String(DEFAULT_TEMPLATE);
+      }
+
+      std::ifstream file(templatePath, std::ios::binary);
+      if (!file)
+        return Err(draconis::utils::error::DracError {
+          draconis::utils::error::DracErrorCode::IoError,
+          std::format("Failed to open template {}", templatePath.string()),
+        });
+
+      return String(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    static auto createDefaultTemplate(const fs::path& templatePath) -> void {
+      std::error_code errc;
+      fs::create_directories(templatePath.parent_path(), errc);
+
+      std::ofstream file(templatePath, std::ios::binary);
+      if (!file)
+        return;
+
+      file << DEFAULT_TEMPLATE;
+    }
+
+   public:
+    TemplateFormatPlugin() {
+      m_metadata = {
+        .name         = "Template Format",
+        .version      = "1.0.0",
+        .author       = "Draconis++ Team",
+        .description  = "Provides output formatting from a user-editable template",
+        .type         = draconis::core::plugin::PluginType::OutputFormat,
+        .dependencies = {}
+      };
+    }
+
+    [[nodiscard]] auto getMetadata() const -> const draconis::core::plugin::PluginMetadata& override {
+      return m_metadata;
+    }
+
+    auto setConfig(StringView tomlConfig) -> Result<Unit> override {
+      // Only `extension = "..."` is read; a leading dot is dropped
+      for (StringView rest = tomlConfig; !rest.empty();) {
+        const usize lineEnd = rest.find('\n');
+        StringView  line    = rest.substr(0, lineEnd);
+        rest                = lineEnd == StringView::npos ? StringView {} : rest.substr(lineEnd + 1);
+
+        line = line.substr(0, line.find('#'));
+
+        const usize equals = line.find('=');
+        if (equals == StringView::npos || Trim(line.substr(0, equals)) != "extension")
+          continue;
+
+        StringView value = Trim(line.substr(equals + 1));
+        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+          value = value.substr(1, value.size() - 2);
+        const StringView extension = value.starts_with('.') ? value.substr(1) : value;
+
+        if (extension.empty() || extension.find_first_of("/\\") != StringView::npos) {
+          warn_log("Template format: '{}' is not a file extension, ignoring it", value);
+          continue;
+        }
+
+        m_extension = String(extension);
+      }
+
+      return {};
+    }
+
+    auto initialize(const draconis::core::plugin::PluginContext& ctx, ::PluginCache& /*cache*/) -> Result<Unit> override {
+      const fs::path templatePath = ctx.configDir / "template.tmpl";
+      const String   source       = TRY(loadTemplate(templatePath));
+
+      m_defaultTemplate = source == DEFAULT_TEMPLATE;
+
+      m_program = TRY(template_format::Program::Compile(source, templatePath.string()));
+      debug_log("Template format compiled {} ({} instructions)", templatePath.string(), m_program->instructions().size());
+
+      m_ready = true;
+      return {};
+    }
+
+    auto shutdown() -> Unit override {
+      m_ready = false;
+      m_program.reset();
+    }
+
+    [[nodiscard]] auto isReady() const -> bool override {
+      return m_ready;
+    }
+
+    auto formatOutput(
+      const String& /*formatName*/,
+      const Map<String, String>&              data,
+      const draconis::core::plugin::PluginData& pluginData
+    ) const -> Result<String> override {
+      if (!m_ready)
+        return Err(
+          draconis::utils::error::DracError { draconis::utils::error::DracErrorCode::Other, "TemplateFormatPlugin is not ready." }
+        );
+
+      String output;
+      m_program->render(data, pluginData, output);
+      return output;
+    }
+
+    [[nodiscard]] auto getFormatNames() const -> Span<const String> override {
+      static const Array<String, 1> names = { FORMAT_TEMPLATE };
+      return names;
+    }
+
+    [[nodiscard]] auto getFileExtension(const String& /*formatName*/) const -> String override {
+      return m_extension.value_or(m_defaultTemplate ? "md" : "txt");
+    }
+  };
+
+} // anonymous namespace
+
+DRAC_PLUGIN(TemplateFormatPlugin)
@@ -0,0 +1,600 @@
+/**
+ * @file template_program.hpp
+ * @brief Template compiler and renderer for the template format plugin
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Templates are plain text with tags in double braces:
+ * - `{{host}}` inserts a value from the core's data map. Keys of the shared
+ *   field schema are read through format_fields::FieldValues; any other key
+ *   is looked up in the map directly.
+ * - `{{now_playing.title}}` inserts a field of one plugin's data.
+ * - `{{#if key}} ... {{else}} ... {{/if}}` and `{{#unless key}} ... {{/unless}}`
+ *   test whether a value is present and non-empty. `{{#if a or b}}` holds
+ *   when either value is, and `{{#if plugins}}` when any plugin has data.
+ * - `{{key | round}}` is the value rounded to the nearest integer, and
+ *   `{{key | nonzero}}` the value unless it is zero. Both read as empty when
+ *   the value is not a number, in insertions and conditions alike.
+ * - `{{#each plugins}} ... {{/each}}` repeats for every plugin with data, where
+ *   `{{@id}}` is the plugin's ID. Inside it, `{{#each fields}} ... {{/each}}`
+ *   repeats for each of that plugin's fields, with `{{@name}}` and `{{@value}}`.
+ * - `{{! ... }}` is a comment.
+ *
+ * A line holding only a block tag or comment is left out of the output
+ * entirely, so block tags can sit on their own lines.
+ *
+ * Program::Compile() parses the template once into a flat list of
+ * instructions: text runs, value insertions with their lookups resolved
+ * ahead of time, and jumps for conditionals and loops. Rendering walks that
+ * list once into a buffer reserved up front, with no parsing, and reports no
+ * errors. Everything that can fail is reported by Compile(), as
+ * "<name>:<line>:<column>: <message>".
+ */
+
+#pragma once
+
+#include <cmath>
+#include <format>
+#include <variant>
+
+#include <Drac++/Core/Plugin.hpp>
+
+#include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+#include "../common/format_fields.hpp"
+
+namespace template_format {
+  using namespace draconis::utils::types;
+
+  enum class OpCode : u8 {
+    Text,         // Append TEXT[first, first + second)
+    Insert,       // Append the value
+    JumpIfEmpty,  // Jump to target if the value is empty ({{#if}})
+    JumpIfSet,    // Jump to target if the value is non-empty ({{#unless}})
+    Jump,         // Jump to target ({{else}})
+    BeginPlugins, // Start the plugin loop; jump to target if there is no plugin data
+    NextPlugin,   // Advance the plugin loop; jump back to target while plugins remain
+    BeginFields,  // Start the field loop of the current plugin; jump to target if it has none
+    NextField,    // Advance the field loop; jump back to target while fields remain
+  };
+
+  enum class ValueKind : u8 {
+    None,
+    SchemaField, // FieldId first
+    DataKey,     // Data map key NAMES[first]
+    PluginField, // Field NAMES[second] of plugin NAMES[first]
+    PluginId,    // {{@id}}
+    FieldName,   // {{@name}}
+    FieldValue,  // {{@value}}
+    Plugins,     // Set when there is any plugin data; conditions only
+  };
+
+  enum class Filter : u8 {
+    None,
+    Round,   // The number rounded to the nearest integer
+    NonZero, // The value unless it is the number zero
+  };
+
+  namespace detail {
+    class Compiler;
+  } // namespace detail
+
+  struct Instruction {
+    OpCode    op;
+    ValueKind value  = ValueKind::None;
+    Filter    filter = Filter::None;
+    u32       first  = 0;
+    u32       second = 0;
+    u32       target = 0;
+  };
+
+  /**
+   * @brief A compiled template
+   */
+  class Program {
+   public:
+    /**
+     * @brief Compile template source
+     * @param source The template text
+     * @param name Name used as the location prefix of error messages, usually the file path
+     */
+    static auto Compile(StringView source, StringView name) -> Result<Program>;
+
+    /**
+     * @brief Run the program against one set of data, appending to out
+     */
+    auto render(const Map<String, String>& data, const draconis::core::plugin::PluginData& pluginData, String& out) const -> void {
+      RenderState state {
+        .fields     = format_fields::FieldValues::Extract(data),
+        .data       = data,
+        .pluginData = pluginData,
+      };
+
+      out.reserve(out.size() + m_reserveBytes);
+
+      usize counter = 0;
+
+      while (counter < m_code.size()) {
+        const Instruction& instr = m_code[counter++];
+
+        switch (instr.op) {
+          case OpCode::Text:        out.append(m_text, instr.first, instr.second); break;
+          case OpCode::Insert:      out += resolve(instr, state); break;
+          case OpCode::JumpIfEmpty:
+            if (!isSet(instr, state))
+              counter = instr.target;
+            break;
+          case OpCode::JumpIfSet:
+            if (isSet(instr, state))
+              counter = instr.target;
+            break;
+          case OpCode::Jump: counter = instr.target; break;
+          case OpCode::BeginPlugins:
+            state.plugin = pluginData.begin();
+            if (state.plugin == pluginData.end())
+              counter = instr.target;
+            break;
+          case OpCode::NextPlugin:
+            if (++state.plugin != pluginData.end())
+              counter = instr.target;
+            break;
+          case OpCode::BeginFields:
+            state.field = state.plugin->second.begin();
+            if (state.field == state.plugin->second.end())
+              counter = instr.target;
+            break;
+          case OpCode::NextField:
+            if (++state.field != state.plugin->second.end())
+              counter = instr.target;
+            break;
+        }
+      }
+    }
+
+    [[nodiscard]] auto instructions() const -> Span<const Instruction> {
+      return m_code;
+    }
+
+   private:
+    friend class detail::Compiler;
+
+    // Output reserved per inserted value, on top of the template's own text
+    static constexpr usize INSERT_RESERVE_BYTES = 32;
+
+    Vec<Instruction> m_code;
+    String           m_text;  // Every text run, back to back
+    Vec<String>      m_names; // Data map keys, plugin IDs and plugin field names
+    usize            m_reserveBytes = 0;
+
+    struct RenderState {
+      format_fields::FieldValues                           fields;
+      const Map<String, String>&                           data;
+      const draconis::core::plugin::PluginData&            pluginData;
+      draconis::core::plugin::PluginData::const_iterator   plugin {};
+      draconis::core::plugin::PluginFields::const_iterator field {};
+      String                                               scratch {}; // Text of the last non-string plugin value
+    };
+
+    static auto FieldText(const draconis::core::plugin::PluginFieldValue& value, String& scratch) -> StringView {
+      if (const String* text = std::get_if<String>(&value))
+        return *text;
+
+      scratch = draconis::core::plugin::PluginFieldToString(value);
+      return scratch;
+    }
+
+    static auto ApplyFilter(const Filter filter, const StringView text, String& scratch) -> StringView {
+      const format_fields::NumberResult<f64> number = format_fields::ParseNumber<f64>(text);
+      if (!number)
+        return {};
+
+      switch (filter) {
+        // Adding zero turns the -0 of values just below zero into 0, as std::lround would
+        case Filter::Round:
+          scratch = std::format("{:.0f}", std::round(*number) + 0.0);
+          return scratch;
+        case Filter::NonZero: return *number == 0 ? StringView {} : text;
+        case Filter::None:    break;
+      }
+      return text;
+    }
+
+    auto isSet(const Instruction& instr, RenderState& state) const -> bool {
+      return instr.value == ValueKind::Plugins ? !state.pluginData.empty() : !resolve(instr, state).empty();
+    }
+
+    // The returned view is valid until the next call
+    auto resolve(const Instruction& instr, RenderState& state) const -> StringView {
+      const StringView text = lookup(instr, state);
+      return instr.filter == Filter::None ? text : ApplyFilter(instr.filter, text, state.scratch);
+    }
+
+    auto lookup(const Instruction& instr, RenderState& state) const -> StringView {
+      switch (instr.value) {
+        case ValueKind::SchemaField: return state.fields.get(static_cast<format_fields::FieldId>(instr.first));
+        case ValueKind::DataKey: {
+          const auto entry = state.data.find(m_names[instr.first]);
+          return entry == state.data.end() ? StringView {} : StringView(entry->second);
+        }
+        case ValueKind::PluginField: {
+          const auto plugin = state.pluginData.find(m_names[instr.first]);
+          if (plugin == state.pluginData.end())
+            return {};
+
+          const auto field = plugin->second.find(m_names[instr.second]);
+          return field == plugin->second.end() ? StringView {} : FieldText(field->second, state.scratch);
+        }
+        case ValueKind::PluginId:   return state.plugin->first;
+        case ValueKind::FieldName:  return state.field->first;
+        case ValueKind::FieldValue: return FieldText(state.field->second, state.scratch);
+        case ValueKind::Plugins:
+        case ValueKind::None:       break;
+      }
+      return {};
+    }
+  };
+  namespace detail {
+    /**
+     * @brief Single-pass parser that emits instructions as it reads tags
+     */
+    class Compiler {
+     public:
+      Compiler(const StringView source, const StringView name) : m_source(source), m_name(name) {}
+
+      auto run() -> Result<Unit> {
+        usize textStart = 0;
+        usize cursor    = 0;
+
+        while ((cursor = m_source.find("{{", cursor)) != StringView::npos) {
+          const usize tagStart = cursor;
+          const usize tagEnd   = m_source.find("}}", tagStart + 2);
+
+          if (tagEnd == StringView::npos)
+            return error(tagStart, "tag is never closed with '}}'");
+
+          const StringView tag     = Trim(m_source.substr(tagStart + 2, tagEnd - tagStart - 2));
+          usize            next    = tagEnd + 2;
+          usize            textEnd = tagStart;
+
+          // A block tag or comment alone on its line takes the whole line with it
+          if (IsBlockTag(tag)) {
+            const usize lineStart = LineStart(m_source, tagStart);
+            const usize lineEnd   = m_source.find('\n', next);
+
+            if (lineStart >= textStart && IsBlank(m_source.substr(lineStart, tagStart - lineStart)) &&
+                IsBlank(m_source.substr(next, (lineEnd == StringView::npos ? m_source.size() : lineEnd) - next))) {
+              textEnd = lineStart;
+              next    = lineEnd == StringView::npos ? m_source.size() : lineEnd + 1;
+            }
+          }
+
+          appendText(textStart, textEnd);
+          TRY_VOID(compileTag(tag, tagStart));
+
+          textStart = next;
+          cursor    = next;
+        }
+
+        appendText(textStart, m_source.size());
+
+        if (!m_blocks.empty())
+          return error(m_blocks.back().tagOffset, std::format("'{{{{{}}}}}' is never closed", BlockOpener(m_blocks.back().kind)));
+
+        return {};
+      }
+
+      auto program() && -> Program {
+        return std::move(m_program);
+      }
+
+     private:
+      enum class BlockKind : u8 {
+        If,
+        Unless,
+        EachPlugins,
+        EachFields,
+      };
+
+      struct Block {
+        BlockKind     kind;
+        usize         tagOffset;  // Opening tag, for errors
+        usize         firstIndex; // First conditional jump; openIndex for every other block
+        usize         openIndex;  // Last conditional jump or Begin* instruction
+        Option<usize> elseIndex;  // Jump emitted by {{else}}
+      };
+
+      StringView m_source;
+      StringView m_name;
+      Program    m_program;
+      Vec<Block> m_blocks;
+      bool       m_inPlugins = false;
+      bool       m_inFields  = false;
+
+      static auto Trim(StringView text) -> StringView {
+        const usize first = text.find_first_not_of(" \t");
+        if (first == StringView::npos)
+          return {};
+        return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+      }
+
+      static auto IsBlank(const StringView text) -> bool {
+        return text.find_first_not_of(" \t\r") == StringView::npos;
+      }
+
+      static auto LineStart(const StringView text, const usize offset) -> usize {
+        const usize newline = text.rfind('\n', offset == 0 ? 0 : offset - 1);
+        return newline == StringView::npos || offset == 0 ? 0 : newline + 1;
+      }
+
+      static auto IsBlockTag(const StringView tag) -> bool {
+        return tag.starts_with('#') || tag.starts_with('/') || tag.starts_with('!') || tag == "else";
+      }
+
+      static auto BlockOpener(const BlockKind kind) -> StringView {
+        switch (kind) {
+          case BlockKind::If:          return "#if";
+          case BlockKind::Unless:      return "#unless";
+          case BlockKind::EachPlugins: return "#each plugins";
+          case BlockKind::EachFields:  return "#each fields";
+        }
+        return {};
+      }
+
+      static auto IsNameChar(const char chr) -> bool {
+        return (chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z') || (chr >= '0' && chr <= '9') || chr == '_' || chr == '-';
+      }
+
+      static auto IsName(const StringView text) -> bool {
+        return !text.empty() && std::ranges::all_of(text, IsNameChar);
+      }
+
+      auto error(const usize offset, const StringView message) const -> Result<Unit> {
+        usize line   = 1;
+        usize column = 1;
+
+        for (const char chr : m_source.substr(0, offset)) {
+          if (chr == '\n') {
+            ++line;
+            column = 1;
+          } else {
+            ++column;
+          }
+        }
+
+        return Err(draconis::utils::error::DracError {
+          draconis::utils::error::DracErrorCode::ParseError,
+          std::format("{}:{}:{}: {}", m_name, line, column, message),
+        });
+      }
+
+      auto emit(const Instruction& instr) -> usize {
+        m_program.m_code.push_back(instr);
+        return m_program.m_code.size() - 1;
+      }
+
+      auto here() const -> u32 {
+        return static_cast<u32>(m_program.m_code.size());
+      }
+
+      auto appendText(const usize begin, const usize end) -> void {
+        if (end <= begin)
+          return;
+
+        emit({
+          .op     = OpCode::Text,
+          .first  = static_cast<u32>(m_program.m_text.size()),
+          .second = static_cast<u32>(end - begin),
+        });
+        m_program.m_text.append(m_source.substr(begin, end - begin));
+        m_program.m_reserveBytes += end - begin;
+      }
+
+      auto intern(const StringView name) -> u32 {
+        for (usize index = 0; index < m_program.m_names.size(); ++index)
+          if (m_program.m_names[index] == name)
+            return static_cast<u32>(index);
+
+        m_program.m_names.emplace_back(name);
+        return static_cast<u32>(m_program.m_names.size() - 1);
+      }
+
+      // Resolve "value" or "value | filter" into the value fields of an instruction
+      auto resolveOperand(const StringView expr, const usize offset, Instruction& instr) -> Result<Unit> {
+        const usize bar = expr.find('|');
+        if (bar == StringView::npos)
+          return resolveValue(expr, offset, instr);
+
+        const StringView filter = Trim(expr.substr(bar + 1));
+
+        if (filter == "round")
+          instr.filter = Filter::Round;
+        else if (filter == "nonzero")
+          instr.filter = Filter::NonZero;
+        else
+          return error(offset, std::format("unknown filter '{}'; expected 'round' or 'nonzero'", filter));
+
+        TRY_VOID(resolveValue(Trim(expr.substr(0, bar)), offset, instr));
+
+        if (instr.value == ValueKind::Plugins)
+          return error(offset, "'plugins' cannot be filtered");
+        return {};
+      }
+
+      auto resolveValue(const StringView expr, const usize offset, Instruction& instr) -> Result<Unit> {
+        if (expr == "plugins") {
+          instr.value = ValueKind::Plugins;
+          return {};
+        }
+
+        if (expr == "@id" || expr == "@name" || expr == "@value") {
+          if (expr == "@id" ? !m_inPlugins : !m_inFields)
+            return error(offset, std::format("'{}' is only available inside '{{{{#each {}}}}}'", expr, expr == "@id" ? "plugins" : "fields"));
+
+          instr.value = expr == "@id" ? ValueKind::PluginId : expr == "@name" ? ValueKind::FieldName : ValueKind::FieldValue;
+          return {};
+        }
+
+        if (const usize dot = expr.find('.'); dot != StringView::npos) {
+          const StringView plugin = expr.substr(0, dot);
+          const StringView field  = expr.substr(dot + 1);
+
+          if (!IsName(plugin) || !IsName(field))
+            return error(offset, std::format("'{}' is not a valid plugin field; expected 'plugin.field'", expr));
+
+          instr.value  = ValueKind::PluginField;
+          instr.first  = intern(plugin);
+          instr.second = intern(field);
+          return {};
+        }
+
+        if (!IsName(expr))
+          return error(offset, expr.empty() ? String("empty tag") : std::format("'{}' is not a valid name", expr));
+
+        if (const Option<format_fields::FieldId> field = format_fields::FindField(expr)) {
+          instr.value = ValueKind::SchemaField;
+          instr.first = static_cast<u32>(*field);
+        } else {
+          instr.value = ValueKind::DataKey;
+          instr.first = intern(expr);
+        }
+        return {};
+      }
+
+      auto openBlock(const BlockKind kind, const usize offset, const usize firstIndex, const usize openIndex) -> void {
+        m_blocks.push_back({ .kind = kind, .tagOffset = offset, .firstIndex = firstIndex, .openIndex = openIndex, .elseIndex = None });
+      }
+
+      // Point the jumps that skip a conditional's body at the current instruction.
+      // In {{#if a or b}} only the last one does; the others jump into the body.
+      auto skipConditionTo(const Block& block) -> void {
+        const usize first = block.kind == BlockKind::Unless ? block.firstIndex : block.openIndex;
+        for (usize index = first; index <= block.openIndex; ++index)
+          m_program.m_code[index].target = here();
+      }
+
+      auto compileTag(const StringView tag, const usize offset) -> Result<Unit> {
+        auto& code = m_program.m_code;
+
+        if (tag.starts_with('!'))
+          return {};
+
+        if (tag.starts_with("#if ") || tag.starts_with("#unless ")) {
+          const bool  isIf       = tag.starts_with("#if ");
+          StringView  rest       = Trim(tag.substr(isIf ? 4 : 8));
+          const usize firstIndex = here();
+
+          // Every operand but the last jumps into the body ({{#if}}) or past it ({{#unless}}) when set
+          for (;;) {
+            const usize      separator = rest.find(" or ");
+            const StringView operand   = Trim(rest.substr(0, separator));
+            const bool       last      = separator == StringView::npos;
+            Instruction      instr { .op = isIf && last ? OpCode::JumpIfEmpty : OpCode::JumpIfSet };
+
+            TRY_VOID(resolveOperand(operand, offset, instr));
+            const usize index = emit(instr);
+
+            if (last) {
+              for (usize earlier = firstIndex; isIf && earlier < index; ++earlier)
+                code[earlier].target = here();
+
+              openBlock(isIf ? BlockKind::If : BlockKind::Unless, offset, firstIndex, index);
+              return {};
+            }
+
+            rest = rest.substr(separator + 4);
+          }
+        }
+
+        if (tag == "else") {
+          if (m_blocks.empty() || (m_blocks.back().kind != BlockKind::If && m_blocks.back().kind != BlockKind::Unless))
+            return error(offset, "'{{else}}' outside of '{{#if}}' or '{{#unless}}'");
+          if (m_blocks.back().elseIndex)
+            return error(offset, "second '{{else}}' in the same block");
+
+          Block& block    = m_blocks.back();
+          block.elseIndex = emit({ .op = OpCode::Jump });
+          skipConditionTo(block);
+          return {};
+        }
+
+        if (tag == "/if" || tag == "/unless") {
+          const BlockKind kind = tag == "/if" ? BlockKind::If : BlockKind::Unless;
+
+          if (m_blocks.empty() || m_blocks.back().kind != kind)
+            return error(offset, std::format("'{{{{{}}}}}' does not close an open '{{{{{}}}}}'", tag, BlockOpener(kind)));
+
+          const Block block = m_blocks.back();
+          m_blocks.pop_back();
+
+          if (block.elseIndex)
+            code[*block.elseIndex].target = here();
+          else
+            skipConditionTo(block);
+          return {};
+        }
+
+        if (tag.starts_with("#each ")) {
+          const StringView subject = Trim(tag.substr(6));
+
+          if (subject == "plugins") {
+            if (m_inPlugins)
+              return error(offset, "'{{#each plugins}}' cannot be nested");
+
+            m_inPlugins = true;
+            const usize index = emit({ .op = OpCode::BeginPlugins });
+            openBlock(BlockKind::EachPlugins, offset, index, index);
+            return {};
+          }
+
+          if (subject == "fields") {
+            if (!m_inPlugins)
+              return error(offset, "'{{#each fields}}' is only available inside '{{#each plugins}}'");
+            if (m_inFields)
+              return error(offset, "'{{#each fields}}' cannot be nested");
+
+            m_inFields = true;
+            const usize index = emit({ .op = OpCode::BeginFields });
+            openBlock(BlockKind::EachFields, offset, index, index);
+            return {};
+          }
+
+          return error(offset, std::format("cannot loop over '{}'; expected 'plugins' or 'fields'", subject));
+        }
+
+        if (tag == "/each") {
+          if (m_blocks.empty() || (m_blocks.back().kind != BlockKind::EachPlugins && m_blocks.back().kind != BlockKind::EachFields))
+            return error(offset, "'{{/each}}' does not close an open '{{#each}}'");
+
+          const Block block     = m_blocks.back();
+          const bool  isPlugins = block.kind == BlockKind::EachPlugins;
+          m_blocks.pop_back();
+
+          emit({ .op = isPlugins ? OpCode::NextPlugin : OpCode::NextField, .target = static_cast<u32>(block.openIndex + 1) });
+          code[block.openIndex].target = here();
+          (isPlugins ? m_inPlugins : m_inFields) = false;
+          return {};
+        }
+
+        if (tag.starts_with('#') || tag.starts_with('/'))
+          return error(offset, std::format("unknown block tag '{}'", tag));
+
+        Instruction instr { .op = OpCode::Insert };
+        TRY_VOID(resolveOperand(tag, offset, instr));
+
+        if (instr.value == ValueKind::Plugins)
+          return error(offset, "'plugins' can only be tested with '{{#if}}' or '{{#unless}}'");
+
+        emit(instr);
+        m_program.m_reserveBytes += Program::INSERT_RESERVE_BYTES;
+        return {};
+      }
+    };
+  } // namespace detail
+
+  inline auto Program::Compile(const StringView source, const StringView name) -> Result<Program> {
+    detail::Compiler compiler(source, name);
+    TRY_VOID(compiler.run());
+    return std::move(compiler).program();
+  }
+} // namespace template_format
@@ -0,0 +1,35 @@
+/**
+ * @file check.hpp
+ * @brief Minimal assertion helpers for the plugin unit tests
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details CHECK records a failure and keeps going, so one run reports every
+ * broken expectation. A test's main() returns tests::Finish().
+ */
+
+#pragma once
+
+#include <cstdio>
+
+namespace tests {
+  inline int failures = 0;
+
+  inline auto Check(const bool passed, const char* expression, const char* file, const int line) -> bool {
+    if (!passed) {
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+      ++failures;
+    }
+
+    return passed;
+  }
+
+  inline auto Finish() -> int {
+    if (failures != 0)
+      std::fprintf(stderr, "%d check(s) failed\n", failures);
+
+    return failures == 0 ? 0 : 1;
+  }
+} // namespace tests
+
+#define CHECK(expr) ::tests::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
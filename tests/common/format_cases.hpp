@@ -0,0 +1,123 @@
+/**
+ * @file format_cases.hpp
+ * @brief Sample documents for the output format tests and benchmarks
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Each case is the data map and plugin data the core would hand an
+ * output format plugin: a fully populated machine, sparse and malformed maps,
+ * an empty one, and one whose plugin data alone is far larger than a
+ * streaming chunk.
+ */
+
+#pragma once
+
+#include <format>
+
+#include <Drac++/Core/Plugin.hpp>
+
+#include <Drac++/Utils/Types.hpp>
+
+namespace tests::formats {
+  using namespace draconis::utils::types;
+  using draconis::core::plugin::PluginData;
+
+  struct Case {
+    String              name;
+    Map<String, String> data;
+    PluginData          pluginData;
+  };
+
+  inline auto FullData() -> Map<String, String> {
+    return {
+      { "date", "October 17th" },
+      { "host", "MacBookPro18,3" },
+      { "kernel", "6.8.0" },
+      { "os", "NixOS 24.05" },
+      { "os_name", "NixOS" },
+      { "os_version", "24.05" },
+      { "os_id", "nixos" },
+      { "ram", "7.5 GiB/31.2 GiB" },
+      { "memory_used_bytes", "8053063680" },
+      { "memory_total_bytes", "33500000000" },
+      { "de", "KDE" },
+      { "wm", "KWin" },
+      { "disk", "100 GiB/500 GiB" },
+      { "disk_used_bytes", "107374182400" },
+      { "disk_total_bytes", "536870912000" },
+      { "shell", "zsh" },
+      { "cpu", "AMD Ryzen 9" },
+      { "cpu_cores_physical", "8" },
+      { "cpu_cores_logical", "16" },
+      { "gpu", "RTX 4090" },
+      { "uptime", "3d 4h" },
+      { "uptime_seconds", "273600" },
+      { "packages", "1234" },
+      { "weather_temperature", "21.6" },
+      { "weather_description", "clear sky" },
+      { "weather_town", "Berlin" },
+      { "unknown_key", "x" },
+    };
+  }
+
+  inline auto MakeCases() -> Vec<Case> {
+    Vec<Case> cases;
+
+    PluginData plugins;
+    plugins["now_playing"]["title"]  = String("Song");
+    plugins["now_playing"]["length"] = 12.5;
+    plugins["weather"]["temp"]       = String("21");
+    cases.push_back({ .name = "full", .data = FullData(), .pluginData = plugins });
+
+    cases.push_back({
+      .name = "sparse",
+      .data = {
+        { "os_name", "Arch" },
+        { "packages", "0" },
+        { "weather_temperature", "abc" },
+        { "weather_description", "rain" },
+        { "gpu", "iGPU" },
+        { "disk_used_bytes", "5" },
+      },
+      .pluginData = {},
+    });
+
+    cases.push_back({
+      .name = "malformed",
+      .data = {
+        { "host", "" },
+        { "os", "X" },
+        { "weather_temperature", "-3.4" },
+        { "weather_description", "snow" },
+        { "packages", "junk" },
+        { "cpu_cores_logical", "99999999999" },
+        { "uptime_seconds", "-5" },
+      },
+      .pluginData = {},
+    });
+
+    cases.push_back({ .name = "empty", .data = {}, .pluginData = {} });
+
+    // Characters every format has to quote or escape
+    cases.push_back({
+      .name = "quoting",
+      .data = {
+        { "host", "- dash: colon # hash" },
+        { "os", "'single' \"double\" \\ back" },
+        { "kernel", "true" },
+        { "shell", "line\nbreak\ttab" },
+        { "packages", "42" },
+      },
+      .pluginData = { { "odd/plugin~id", { { "key: with colon", String("null") }, { "flag", true }, { "count", u64 { 7 } } } } },
+    });
+
+    // Plugin data spanning many streaming chunks, including one value larger than a chunk
+    PluginData large;
+    for (usize index = 0; index < 2000; ++index)
+      large[std::format("plugin{:02}", index % 40)][std::format("field{:04}", index)] = String(std::format("value {} of the large case", index));
+    large["blob"]["data"] = String(40 * 1024, 'x');
+    cases.push_back({ .name = "large", .data = FullData(), .pluginData = std::move(large) });
+
+    return cases;
+  }
+} // namespace tests::formats
@@ -0,0 +1,83 @@
+/**
+ * @file format_fields_test.cpp
+ * @brief Numeric field conversion in the shared formatter schema
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details ParseNumber() must accept exactly the values the formatters emit
+ * as numbers and tell the rest apart, whatever the process locale says about
+ * decimal separators.
+ */
+
+#include <clocale>
+
+#include "common/format_fields.hpp"
+#include "tests/check.hpp"
+
+namespace {
+  using namespace format_fields;
+
+  template <typename T>
+  auto Error(const StringView text) -> Option<NumberError> {
+    const NumberResult<T> result = ParseNumber<T>(text);
+    return result ? None : Option<NumberError>(result.error());
+  }
+
+  auto TestIntegers() -> void {
+    CHECK(ParseNumber<u64>("8053063680") == 8053063680ULL);
+    CHECK(ParseNumber<i64>("-5") == -5);
+    CHECK(ParseNumber<u32>("16") == 16U);
+
+    CHECK(Error<u64>("") == NumberError::Missing);
+    CHECK(Error<u64>("-1") == NumberError::Invalid);
+    CHECK(Error<u64>("12 GiB") == NumberError::Invalid);
+    CHECK(Error<u64>(" 12") == NumberError::Invalid);
+    CHECK(Error<u32>("99999999999") == NumberError::OutOfRange);
+  }
+
+  auto TestFloatingPoint() -> void {
+    CHECK(ParseNumber<f64>("21.6") == 21.6);
+    CHECK(ParseNumber<f64>("-3.4") == -3.4);
+    CHECK(ParseNumber<f64>("1e3") == 1000.0);
+
+    CHECK(Error<f64>("1,5") == NumberError::Invalid);
+    CHECK(Error<f64>("+5") == NumberError::Invalid);
+    CHECK(Error<f64>("5 ") == NumberError::Invalid);
+    CHECK(Error<f64>("0x10") == NumberError::Invalid);
+    CHECK(Error<f64>("abc") == NumberError::Invalid);
+    CHECK(Error<f64>("1e400") == NumberError::OutOfRange);
+    CHECK(!ParseNumber<f64>("inf") && !ParseNumber<f64>("nan"));
+  }
+
+  auto TestFieldValues() -> void {
+    const Map<String, String> data = {
+      { "packages", "junk" },
+      { "uptime_seconds", "-5" },
+      { "weather_temperature", "21.6" },
+      { "host", "box" },
+    };
+    const FieldValues fields = FieldValues::Extract(data);
+
+    // Malformed values are omitted (and logged), absent ones just omitted
+    CHECK(!fields.findNumber<u64>(FieldId::Packages));
+    CHECK(fields.number<u64>(FieldId::Packages).error() == NumberError::Invalid);
+    CHECK(!fields.findNumber<u64>(FieldId::DiskUsedBytes));
+
+    CHECK(fields.typed<FieldId::UptimeSeconds>() == -5);
+    CHECK(fields.typed<FieldId::WeatherTemperature>() == 21.6);
+    CHECK(fields.typed<FieldId::Host>() == StringView("box"));
+  }
+} // namespace
+
+auto main() -> int {
+  // A locale with ',' as the decimal separator, where available, must not change anything
+  for (const char* locale : { "de_DE.UTF-8", "fr_FR.UTF-8" })
+    if (std::setlocale(LC_ALL, locale))
+      break;
+
+  TestIntegers();
+  TestFloatingPoint();
+  TestFieldValues();
+
+  return tests::Finish();
+}
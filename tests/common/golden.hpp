@@ -0,0 +1,65 @@
+/**
+ * @file golden.hpp
+ * @brief Comparison of formatter output against checked-in expected files
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Expected outputs live next to the tests as one file per sample
+ * case. Running a test with DRAC_UPDATE_GOLDEN=1 rewrites those files from
+ * the current output instead of comparing; review the diff before committing.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <Drac++/Utils/Types.hpp>
+
+#include "tests/check.hpp"
+
+namespace tests::golden {
+  using namespace draconis::utils::types;
+
+  inline auto Updating() -> bool {
+    const char* update = std::getenv("DRAC_UPDATE_GOLDEN");
+    return update && StringView(update) == "1";
+  }
+
+  /**
+   * @brief Contents of the golden file at `path`, or None if it cannot be read
+   */
+  inline auto Read(const std::filesystem::path& path) -> Option<String> {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      return None;
+
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return std::move(contents).str();
+  }
+
+  /**
+   * @brief Check `actual` against the file at `path`, or rewrite it when updating
+   */
+  inline auto Check(const std::filesystem::path& path, const StringView actual) -> bool {
+    if (Updating()) {
+      std::ofstream(path, std::ios::binary | std::ios::trunc) << actual;
+      return true;
+    }
+
+    const Option<String> expected = Read(path);
+    if (!expected) {
+      std::fprintf(stderr, "missing golden file %s (run with DRAC_UPDATE_GOLDEN=1 to create it)\n", path.string().c_str());
+      return CHECK(false);
+    }
+
+    if (*expected == actual)
+      return true;
+
+    std::fprintf(stderr, "output differs from %s:\n%.*s\n", path.string().c_str(), static_cast<int>(actual.size()), actual.data());
+    return CHECK(false);
+  }
+} // namespace tests::golden
@@ -0,0 +1,63 @@
+/**
+ * @file decoded_output.hpp
+ * @brief Reading json_format's documents back with glaze
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details JsonOutput's text members view the caller's data map, so it cannot
+ * be decoded into. DecodedOutput has the same members and keys with owned
+ * strings. Decode() reads any document format the plugin writes, "json-delta"
+ * aside, with the options the plugin wrote it with.
+ *
+ * Include after json_format/json_format.cpp, which defines JsonOutput.
+ */
+
+#pragma once
+
+namespace tests::json_format {
+  template <typename T>
+  using Owned = std::conditional_t<std::is_same_v<T, StringView>, String, T>;
+
+  struct DecodedOutput {
+#define DECODED_OUTPUT_MEMBER(member, field) Option<Owned<format_fields::FieldType<FieldId::field>>> member;
+    JSON_OUTPUT_FIELDS(DECODED_OUTPUT_MEMBER)
+#undef DECODED_OUTPUT_MEMBER
+    PluginData pluginFields;
+  };
+} // namespace tests::json_format
+
+namespace glz {
+  template <>
+  struct meta<tests::json_format::DecodedOutput> {
+    using T = tests::json_format::DecodedOutput;
+
+#define DECODED_OUTPUT_META(member, field) #member, &T::member,
+    static constexpr detail::Object value = object(JSON_OUTPUT_FIELDS(DECODED_OUTPUT_META) "pluginFields", &T::pluginFields);
+#undef DECODED_OUTPUT_META
+  };
+} // namespace glz
+
+namespace tests::json_format {
+  template <glz::opts Opts>
+  auto DecodeAs(const String& document, DecodedOutput& decoded) -> Result<Unit> {
+    if (glz::error_ctx errorContext = glz::read<Opts>(decoded, document))
+      return Err(draconis::utils::error::DracError { ParseError, std::format("Failed to read the document back: {}", glz::format_error(errorContext, document)) });
+    return {};
+  }
+
+  inline auto Decode(const StringView formatName, const String& document, DecodedOutput& decoded) -> Result<Unit> {
+    if (formatName == "beve")
+      return DecodeAs<BEVE_OPTS>(document, decoded);
+#if JSON_FORMAT_HAS_CBOR
+    if (formatName == "cbor")
+      return DecodeAs<CBOR_OPTS>(document, decoded);
+#endif
+#if JSON_FORMAT_HAS_MSGPACK
+    if (formatName == "msgpack")
+      return DecodeAs<MSGPACK_OPTS>(document, decoded);
+#endif
+    if (formatName == "json-pretty")
+      return DecodeAs<PRETTY_OPTS>(document, decoded);
+    return DecodeAs<COMPACT_OPTS>(document, decoded);
+  }
+} // namespace tests::json_format
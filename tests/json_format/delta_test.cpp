@@ -0,0 +1,106 @@
+/**
+ * @file delta_test.cpp
+ * @brief json-delta lines across plugin instances sharing a cache directory
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details The core runs once per invocation, so every line of a json-delta
+ * stream usually comes from a fresh process. Each plugin instance here stands
+ * in for one: it must continue the sequence and diff against the line the
+ * previous instance wrote, and fall back to a keyframe when the saved state
+ * is missing or damaged.
+ */
+
+#include "json_format/json_format.cpp"
+
+#include <fstream>
+
+#include "tests/check.hpp"
+
+namespace {
+  namespace fs = std::filesystem;
+
+  /**
+   * @brief One "process": a fresh plugin that formats a single line
+   */
+  auto Run(const fs::path& cacheDir, const Map<String, String>& data, const PluginData& pluginData = {}) -> String {
+    JsonFormatPlugin                        plugin;
+    PluginCache                             cache;
+    draconis::core::plugin::PluginContext context;
+    context.cacheDir = cacheDir;
+
+    if (!CHECK(plugin.initialize(context, cache)))
+      return {};
+
+    const Result<String> line = plugin.formatOutput("json-delta", data, pluginData);
+    return CHECK(line) ? *line : String {};
+  }
+
+  auto Contains(const StringView text, const StringView part) -> bool {
+    return text.find(part) != StringView::npos;
+  }
+
+  auto TestAcrossRuns(const fs::path& cacheDir) -> void {
+    Map<String, String> data       = { { "host", "box" }, { "uptime_seconds", "100" } };
+    PluginData          pluginData = {
+      { "now_playing", { { "title", String("Song") } } },
+      { "odd id", { { "spaces and\na newline", u64 { 1 } } } }, // Saved paths may hold any byte
+    };
+
+    const String first = Run(cacheDir, data, pluginData);
+    CHECK(first.starts_with(R"({"seq":0,"type":"full","data":{)"));
+
+    // Only what changed since the previous run, under the next sequence number
+    data["uptime_seconds"] = "160";
+    const String second    = Run(cacheDir, data, pluginData);
+    CHECK(second == "{\"seq\":1,\"type\":\"delta\",\"set\":{\"/uptimeSeconds\":160}}\n");
+
+    // Plugin fields that disappear between runs are unset
+    const String third = Run(cacheDir, data);
+    CHECK(third.starts_with(R"({"seq":2,"type":"delta","unset":[)") && !Contains(third, R"("set")"));
+    CHECK(Contains(third, R"("/pluginFields/now_playing/title")"));
+    CHECK(Contains(third, R"("/pluginFields/odd id/spaces and\na newline")"));
+
+    const String fourth = Run(cacheDir, data);
+    CHECK(fourth == "{\"seq\":3,\"type\":\"delta\"}\n");
+  }
+
+  auto TestDamagedState(const fs::path& cacheDir) -> void {
+    const Map<String, String> data = { { "host", "box" } };
+    Run(cacheDir, data);
+
+    // Unreadable and truncated state both restart the stream with a keyframe
+    for (const StringView contents : { StringView("not a state file"), StringView("json-delta-v1 5 26\n1\n2\n") }) {
+      std::ofstream(cacheDir / "json_format_delta.state", std::ios::trunc) << contents;
+      CHECK(Run(cacheDir, data).starts_with(R"({"seq":0,"type":"full")"));
+      CHECK(Run(cacheDir, data) == "{\"seq\":1,\"type\":\"delta\"}\n");
+    }
+  }
+
+  auto TestWithoutCacheDirectory() -> void {
+    const Map<String, String> data = { { "host", "box" } };
+
+    // Nothing is persisted, but the sequence still continues within one process
+    JsonFormatPlugin plugin;
+    PluginCache      cache;
+    if (!CHECK(plugin.initialize({}, cache)))
+      return;
+
+    CHECK(plugin.formatOutput("json-delta", data, {})->starts_with(R"({"seq":0,"type":"full")"));
+    CHECK(plugin.formatOutput("json-delta", data, {}) == "{\"seq\":1,\"type\":\"delta\"}\n");
+    CHECK(Run({}, data).starts_with(R"({"seq":0,"type":"full")"));
+  }
+} // namespace
+
+auto main() -> int {
+  const fs::path cacheDir = fs::temp_directory_path() / std::format("json_format_delta_test.{}", std::chrono::steady_clock::now().time_since_epoch().count());
+
+  TestAcrossRuns(cacheDir / "runs");
+  TestDamagedState(cacheDir / "damaged");
+  TestWithoutCacheDirectory();
+
+  std::error_code errc;
+  fs::remove_all(cacheDir, errc);
+
+  return tests::Finish();
+}
@@ -0,0 +1,95 @@
+/**
+ * @file formats_test.cpp
+ * @brief json_format's text and binary formats on the sample documents
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details "jsonl" must be the "json" document plus a newline, and every
+ * sample document, plugin data included, has to come out of each format.
+ * Each binary encoding is read back with glaze and must hold the same
+ * object as the "json" document. A binary format left out of the build must
+ * fail rather than emit JSON.
+ */
+
+#include "json_format/json_format.cpp"
+
+#include "tests/check.hpp"
+#include "tests/common/format_cases.hpp"
+#include "tests/json_format/decoded_output.hpp"
+
+namespace {
+  auto TestTextFormats() -> void {
+    JsonFormatPlugin plugin;
+    PluginCache      cache;
+    if (!CHECK(plugin.initialize({}, cache)))
+      return;
+
+    for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+      const Result<String> compact = plugin.formatOutput("json", sample.data, sample.pluginData);
+      const Result<String> pretty  = plugin.formatOutput("json-pretty", sample.data, sample.pluginData);
+      const Result<String> lines   = plugin.formatOutput("jsonl", sample.data, sample.pluginData);
+
+      if (!CHECK(compact && pretty && lines && *lines == *compact + "\n"))
+        std::fprintf(stderr, "  %s: jsonl is not the json document plus a newline\n", sample.name.c_str());
+
+      for (const auto& [pluginId, fields] : sample.pluginData)
+        if (!CHECK(compact && pretty && compact->contains(pluginId) && pretty->contains(pluginId)))
+          std::fprintf(stderr, "  %s: plugin %s is missing\n", sample.name.c_str(), pluginId.c_str());
+    }
+  }
+
+  auto TestRoundTrip() -> void {
+    JsonFormatPlugin plugin;
+    PluginCache      cache;
+    if (!CHECK(plugin.initialize({}, cache)))
+      return;
+
+    for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+      const Result<String> expected = plugin.formatOutput("json", sample.data, sample.pluginData);
+      if (!CHECK(expected))
+        continue;
+
+      for (const String format : { "beve", "cbor", "msgpack" }) {
+        if (std::ranges::find(plugin.getFormatNames(), format) == plugin.getFormatNames().end())
+          continue;
+
+        const Result<String>             document = plugin.formatOutput(format, sample.data, sample.pluginData);
+        tests::json_format::DecodedOutput decoded;
+        String                            json;
+
+        // Written back out as JSON, the decoded object is the "json" document
+        if (!CHECK(document && tests::json_format::Decode(format, *document, decoded) && Serialize<COMPACT_OPTS>(decoded, json) && json == *expected))
+          std::fprintf(stderr, "  %s, %s: does not read back as the json document\n", sample.name.c_str(), format.c_str());
+      }
+    }
+  }
+
+  auto TestBinaryFormats() -> void {
+    JsonFormatPlugin plugin;
+    PluginCache      cache;
+    if (!CHECK(plugin.initialize({}, cache)))
+      return;
+
+    const Map<String, String> data  = tests::formats::FullData();
+    const Span<const String>  names = plugin.getFormatNames();
+
+    // A format left out of the build fails instead of quietly producing JSON
+    for (const String format : { "cbor", "msgpack" }) {
+      const bool           listed   = std::ranges::find(names, format) != names.end();
+      const Result<String> document = plugin.formatOutput(format, data, {});
+
+      if (listed)
+        CHECK(document && !document->empty());
+      else
+        CHECK(!document && document.error().code == NotSupported);
+    }
+  }
+} // namespace
+
+auto main() -> int {
+  TestTextFormats();
+  TestRoundTrip();
+  TestBinaryFormats();
+
+  return tests::Finish();
+}
@@ -0,0 +1,33 @@
+/**
+ * @file golden_test.cpp
+ * @brief markdown_format's output on the sample documents against checked-in files
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details tests/markdown_format/golden/ holds what the formatter wrote
+ * before it was driven by the shared field schema; its output has to stay
+ * byte-identical. The "large" case only adds plugin data and is skipped.
+ */
+
+#include "markdown_format/markdown_format.cpp"
+
+#include "tests/common/format_cases.hpp"
+#include "tests/common/golden.hpp"
+
+auto main() -> int {
+  MarkdownFormatPlugin plugin;
+  PluginCache          cache;
+  if (!CHECK(plugin.initialize({}, cache)))
+    return tests::Finish();
+
+  for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+    if (sample.name == "large")
+      continue;
+
+    const Result<String> document = plugin.formatOutput("markdown", sample.data, sample.pluginData);
+    if (CHECK(document))
+      tests::golden::Check(std::filesystem::path(GOLDEN_DIR) / (sample.name + ".md"), *document);
+  }
+
+  return tests::Finish();
+}
@@ -0,0 +1,188 @@
+/**
+ * @file art_test.cpp
+ * @brief now_playing's album art cache
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Covers the box filter, background fills, thumbnails, entries
+ * following a rewritten file:// source, eviction sparing another store's
+ * temporary file, and that a failed store leaves no temporary file behind.
+ */
+
+#include "now_playing/now_playing_art.hpp"
+
+#include <thread>
+
+#include "tests/check.hpp"
+
+namespace {
+  using namespace now_playing::art;
+
+  // Uncompressed bottom-up 24-bit BMP filled with one colour
+  auto WriteBmp(const fs::path& path, const u32 width, const u32 height, const u8 shade) -> void {
+    const u32 stride = ((width * 3) + 3) & ~3U;
+    const u32 size   = 54 + (stride * height);
+
+    Vec<u8>    bytes(size, shade);
+    const auto store = [&](const usize offset, const u32 value, const usize length) {
+      for (usize byte = 0; byte < length; ++byte)
+        bytes[offset + byte] = static_cast<u8>(value >> (8 * byte));
+    };
+
+    std::fill_n(bytes.begin(), 54, 0);
+    bytes[0] = 'B';
+    bytes[1] = 'M';
+    store(2, size, 4);
+    store(10, 54, 4);
+    store(14, 40, 4);
+    store(18, width, 4);
+    store(22, height, 4);
+    store(26, 1, 2);
+    store(28, 24, 2);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  // Resolves `url` until the background fill has finished or two seconds pass
+  auto ResolveReady(ArtCache& cache, const StringView url) -> Result<ArtCache::Entry> {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+    Result<ArtCache::Entry> entry = cache.resolve(url);
+    while (!entry && entry.error().code == NotFound && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      entry = cache.resolve(url);
+    }
+    return entry;
+  }
+
+  auto CountTemporaries(const fs::path& directory) -> usize {
+    usize count = 0;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory))
+      count += entry.path().extension() == ".tmp" ? 1 : 0;
+    return count;
+  }
+
+  auto TestDownscale() -> void {
+    // 4x2 RGB to 2x1: each output pixel averages a 2x2 block
+    const Array<u8, 24> pixels = {
+      0, 10, 20, 4, 10, 20, 100, 0, 0, 200, 0, 0, //
+      8, 10, 20, 4, 10, 21, 100, 0, 0, 200, 0, 1, //
+    };
+    const Vec<u8> halved = detail::DownscaleBox(pixels, 4, 2, 3, 2, 1);
+    CHECK((halved == Vec<u8> { 4, 10, 20, 150, 0, 0 }));
+
+    // Non-integer factor: 3 columns to 2 still covers every source pixel once
+    const Array<u8, 3> row    = { 30, 60, 90 };
+    const Vec<u8>      shrunk = detail::DownscaleBox(row, 3, 1, 1, 2, 1);
+    CHECK((shrunk == Vec<u8> { 30, 75 }));
+  }
+
+  auto TestThumbnails(const fs::path& root) -> void {
+    const fs::path source = root / "cover.bmp";
+    const String   url    = "file://" + source.string();
+    WriteBmp(source, 1024, 512, 0x40);
+
+    ArtCache cache(root / "thumbnails", DEFAULT_CACHE_BYTES, 256);
+
+    // The first request only starts the fill
+    Result<ArtCache::Entry> pending = cache.resolve(url);
+    CHECK(!pending && pending.error().code == NotFound);
+
+    const Result<ArtCache::Entry> first = ResolveReady(cache, url);
+    if (!CHECK(first))
+      return;
+    CHECK(first->info.format == ImageFormat::Png);
+    CHECK(first->info.width == 256 && first->info.height == 128);
+    CHECK(first->path.parent_path() == root / "thumbnails");
+
+    const Result<ArtCache::Entry> again = cache.resolve(url);
+    CHECK(again && again->path == first->path);
+
+    // A player reusing the same path, and file size, for the next track's art
+    WriteBmp(source, 512, 1024, 0x80);
+    fs::last_write_time(source, fs::last_write_time(source) + std::chrono::seconds(1));
+
+    const Result<ArtCache::Entry> second = ResolveReady(cache, url);
+    if (!CHECK(second))
+      return;
+    CHECK(second->path != first->path);
+    CHECK(second->info.width == 128 && second->info.height == 256);
+
+    // A new cache finds the stored entry without another fill
+    ArtCache                      reopened(root / "thumbnails", DEFAULT_CACHE_BYTES, 256);
+    const Result<ArtCache::Entry> stored = reopened.resolve(url);
+    CHECK(stored && stored->path == second->path);
+
+    // Art within the thumbnail size, or with thumbnails off, is kept as published
+    ArtCache                      original(root / "original", DEFAULT_CACHE_BYTES, 0);
+    const Result<ArtCache::Entry> kept = ResolveReady(original, url);
+    CHECK(kept && kept->info.format == ImageFormat::Bmp && kept->info.width == 512 && kept->info.height == 1024);
+  }
+
+  auto TestEviction(const fs::path& root) -> void {
+    const fs::path directory = root / "eviction";
+    const fs::path source    = root / "evicted.bmp";
+    fs::create_directories(directory);
+    WriteBmp(source, 16, 16, 0x20);
+
+    // Budget for a single image, and two files over it that are both older than the store
+    const MappedFile     file = *MappedFile::open(source);
+    const CacheDirectory cache(directory, file.bytes().size(), 0);
+
+    const fs::path inProgress = directory / "0000000000000001.bmp.1.1.tmp";
+    const fs::path abandoned  = directory / "0000000000000002.bmp.1.1.tmp";
+    std::ofstream(inProgress, std::ios::binary) << "partial";
+    std::ofstream(abandoned, std::ios::binary) << "partial";
+    fs::last_write_time(abandoned, fs::file_time_type::clock::now() - TEMPORARY_GRACE - std::chrono::minutes(1));
+
+    const Result<CacheDirectory::Entry> stored = cache.store(7, file.bytes());
+    CHECK(stored && fs::exists(stored->path));
+
+    // The abandoned file goes; the one another store may still be writing stays
+    CHECK(!fs::exists(abandoned));
+    CHECK(fs::exists(inProgress));
+  }
+
+  auto TestErrors(const fs::path& root) -> void {
+    ArtCache cache(root / "errors", DEFAULT_CACHE_BYTES, 0);
+
+    const Result<ArtCache::Entry> missing = cache.resolve("file://" + (root / "missing.png").string());
+    CHECK(!missing && missing.error().code == NotFound);
+
+    const Result<ArtCache::Entry> unsupported = cache.resolve("ftp://example.com/cover.png");
+    CHECK(!unsupported && unsupported.error().code == NotSupported);
+
+    // A directory in the way of the target makes the rename fail
+    const fs::path source = root / "blocked.bmp";
+    WriteBmp(source, 4, 4, 0x10);
+
+    const CacheDirectory directory(root / "errors", DEFAULT_CACHE_BYTES, 0);
+    const MappedFile     file = *MappedFile::open(source);
+    fs::create_directories(root / "errors" / std::format("{:016x}.bmp", 42));
+
+    const Result<CacheDirectory::Entry> blocked = directory.store(42, file.bytes());
+    CHECK(!blocked && blocked.error().code == IoError);
+    CHECK(CountTemporaries(root / "errors") == 0);
+
+    // No directory at all makes the write fail
+    const CacheDirectory                gone(root / "gone", DEFAULT_CACHE_BYTES, 0);
+    const Result<CacheDirectory::Entry> unwritable = gone.store(42, file.bytes());
+    CHECK(!unwritable && unwritable.error().code == IoError);
+  }
+} // namespace
+
+auto main() -> int {
+  String root = (fs::temp_directory_path() / "now_playing_art_XXXXXX").string();
+  if (!mkdtemp(root.data()))
+    return 1;
+
+  TestDownscale();
+  TestThumbnails(root);
+  TestEviction(root);
+  TestErrors(root);
+
+  std::error_code errc;
+  fs::remove_all(root, errc);
+
+  return tests::Finish();
+}
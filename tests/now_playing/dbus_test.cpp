@@ -0,0 +1,263 @@
+/**
+ * @file dbus_test.cpp
+ * @brief now_playing's DBus client against a private bus
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Covers the wire reader end to end: replies parsed in place in the
+ * receive buffer, frames larger than one receive chunk, bursts of signals
+ * that arrive in a single read, error replies, the session keeping its
+ * player names current from NameOwnerChanged, and the listener following
+ * status changes, publishing repaired titles and dropping players that exit.
+ * The extrapolated position is checked against the mock player's own clock
+ * ten times a second, across a seek and a rate change.
+ */
+
+#include "now_playing/now_playing.cpp"
+
+#include <thread>
+
+#include "tests/check.hpp"
+#include "tests/now_playing/mpris_fixture.hpp"
+
+namespace {
+  using namespace now_playing::dbus;
+
+  // Polls `condition` until it holds or two seconds pass
+  template <typename Condition>
+  auto WaitFor(Condition condition) -> bool {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!condition()) {
+      if (std::chrono::steady_clock::now() > deadline)
+        return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+  }
+
+  auto ActiveName(const Listener& listener) -> String {
+    const std::shared_ptr<const Snapshot> snapshot = listener.snapshot();
+    const PlayerState*                    active   = snapshot ? snapshot->active() : nullptr;
+    return active && active->media.playerName ? *active->media.playerName : String {};
+  }
+
+  auto ActiveTitle(const Listener& listener) -> String {
+    const std::shared_ptr<const Snapshot> snapshot = listener.snapshot();
+    const PlayerState*                    active   = snapshot ? snapshot->active() : nullptr;
+    return active && active->media.title ? *active->media.title : String {};
+  }
+
+  auto ActivePosition(const Listener& listener) -> Option<i64> {
+    const std::shared_ptr<const Snapshot> snapshot = listener.snapshot();
+    const PlayerState*                    active   = snapshot ? snapshot->active() : nullptr;
+    return active ? now_playing::ExtrapolatePosition(active->media, now_playing::MonotonicClock::now()) : None;
+  }
+
+  // The position the player itself reports, bypassing the listener
+  auto PlayerPosition(const Connection& connection, const char* busName) -> Option<i64> {
+    Result<Message> call = Message::newMethodCall(busName, MPRIS_PATH, "org.freedesktop.DBus.Properties", "Get");
+    if (!call || !call->appendArgs(MPRIS_PLAYER_IFACE, "Position"))
+      return None;
+
+    Result<Message> reply = connection.sendWithReplyAndBlock(*call, 1000);
+    if (!reply)
+      return None;
+
+    MessageIter iter = reply->iterInit();
+    return iter.getArgType() == TYPE_VARIANT ? iter.recurse().getInteger() : None;
+  }
+
+  // Compares the listener's extrapolation with the player for one second at 10 Hz
+  auto TracksPlayer(const Listener& listener, const Connection& connection, const char* busName) -> bool {
+    constexpr i64 TOLERANCE_US = 50'000;
+
+    for (int tick = 0; tick < 10; ++tick) {
+      const Option<i64> extrapolated = ActivePosition(listener);
+      const Option<i64> reported     = PlayerPosition(connection, busName);
+
+      if (!extrapolated || !reported || std::abs(*extrapolated - *reported) > TOLERANCE_US) {
+        std::fprintf(stderr, "  tick %d: extrapolated %lld, player %lld\n", tick, static_cast<long long>(extrapolated.value_or(-1)), static_cast<long long>(reported.value_or(-1)));
+        return false;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return true;
+  }
+
+  auto TestPolling(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(
+      bus, { { .name = "alpha", .status = "Paused" }, { .name = "beta" }, { .name = "large", .status = "Stopped", .titleBytes = 100'000 } }
+    );
+    if (!CHECK(players))
+      return;
+
+    Session session;
+    if (!CHECK(session.open(bus.address())))
+      return;
+
+    Result<Vec<PlayerState>> fetched = fetchPlayers(session, {});
+    if (!CHECK(fetched) || !CHECK(fetched->size() == 3))
+      return;
+
+    // Playing outranks paused, which outranks stopped
+    const now_playing::MediaData& active = fetched->front().media;
+    CHECK(active.playerName == "beta");
+    CHECK(active.status == now_playing::PlaybackStatus::Playing);
+    CHECK(active.title == "beta title xxxxx");
+    CHECK(active.artist == "beta artist");
+    CHECK(active.album == "beta album");
+    CHECK(active.lengthUs == 180'000'000);
+    CHECK((*fetched)[1].media.playerName == "alpha");
+
+    // Six receive chunks; the frame is reassembled before it is parsed
+    const now_playing::MediaData& large = fetched->back().media;
+    CHECK(large.playerName == "large");
+    CHECK(large.title && large.title->size() == 100'000);
+
+    // An error reply is matched to its call, and the connection stays usable
+    const Connection* connection = *session.get();
+    Result<Message>   call       = Message::newMethodCall("org.mpris.MediaPlayer2.beta", "/org/mpris/MediaPlayer2", "org.mpris.MediaPlayer2.Player", "Bogus");
+    if (CHECK(call))
+      CHECK(!connection->sendWithReplyAndBlock(*call, 1000));
+    CHECK(fetchPlayers(session, {}));
+  }
+
+  auto TestWatchedNames(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(bus, { { .name = "alpha" } });
+    if (!CHECK(players))
+      return;
+
+    Session session;
+    if (!CHECK(session.open(bus.address())))
+      return;
+
+    // Nothing is watched until a discovery has been recorded
+    CHECK(session.watchedPlayers() == nullptr);
+
+    Result<Vec<PlayerState>> fetched = fetchPlayers(session, {});
+    CHECK(fetched && fetched->size() == 1);
+
+    const Vec<CachedPlayer>* watched = session.watchedPlayers();
+    if (!CHECK(watched && watched->size() == 1))
+      return;
+    CHECK(watched->front().busName == "org.mpris.MediaPlayer2.alpha" && watched->front().uniqueName.starts_with(':'));
+
+    const auto count = [&] {
+      fetched = fetchPlayers(session, {});
+      return fetched ? fetched->size() : 0;
+    };
+
+    // Players that start and exit are followed from NameOwnerChanged alone
+    Option<tests::mpris::Players> later = tests::mpris::Players::Start(bus, { { .name = "beta", .status = "Paused" } });
+    if (!CHECK(later))
+      return;
+    CHECK(WaitFor([&] { return count() == 2; }));
+    CHECK(fetched && (*fetched)[1].media.playerName == "beta" && (*fetched)[1].uniqueName.starts_with(':'));
+
+    CHECK(players->command("drop alpha"));
+    CHECK(WaitFor([&] { return count() == 1; }));
+    CHECK(fetched && fetched->front().media.playerName == "beta");
+
+    CHECK(later->command("drop beta"));
+    CHECK(WaitFor([&] { return !fetchPlayers(session, {}); }));
+    watched = session.watchedPlayers();
+    CHECK(watched && watched->empty());
+  }
+
+  auto TestListener(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players =
+      tests::mpris::Players::Start(bus, { { .name = "alpha", .status = "Paused" }, { .name = "beta" } });
+    if (!CHECK(players))
+      return;
+
+    Listener listener;
+    if (!CHECK(listener.start({}, bus.address())))
+      return;
+
+    CHECK(ActiveName(listener) == "beta");
+
+    CHECK(players->command("status beta Paused"));
+    CHECK(players->command("status alpha Playing"));
+    CHECK(WaitFor([&] { return ActiveName(listener) == "alpha"; }));
+
+    // Hundreds of signals land in a handful of reads and are parsed in place
+    CHECK(players->command("storm alpha 500"));
+    CHECK(players->command("title alpha after the storm"));
+    CHECK(WaitFor([&] { return ActiveTitle(listener) == "after the storm"; }));
+
+    // Control characters are repaired before the snapshot is published
+    CHECK(players->command("title alpha bell\x07ring"));
+    CHECK(WaitFor([&] { return ActiveTitle(listener) == "bell ring"; }));
+
+    CHECK(players->command("drop alpha"));
+    CHECK(WaitFor([&] { return ActiveName(listener) == "beta"; }));
+    CHECK(listener.snapshot()->players.size() == 1);
+
+    listener.stop();
+  }
+
+  auto TestPosition(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(bus, { { .name = "alpha" } });
+    if (!CHECK(players))
+      return;
+
+    Session session;
+    if (!CHECK(session.open(bus.address())))
+      return;
+
+    Listener listener;
+    if (!CHECK(listener.start({}, bus.address())))
+      return;
+
+    const Connection* connection = *session.get();
+    constexpr auto*   busName    = "org.mpris.MediaPlayer2.alpha";
+
+    CHECK(WaitFor([&] { return ActiveName(listener) == "alpha"; }));
+    CHECK(TracksPlayer(listener, *connection, busName));
+    CHECK(ActivePosition(listener) < 10'000'000);
+
+    // Seeked re-bases the position; nothing is asked of the player
+    CHECK(players->command("seek alpha 60000000"));
+    CHECK(WaitFor([&] { return ActivePosition(listener) >= 60'000'000; }));
+    CHECK(ActivePosition(listener) < 61'000'000);
+    CHECK(TracksPlayer(listener, *connection, busName));
+
+    // Time before the rate change counts at the old rate, time after at the new one
+    CHECK(players->command("rate alpha 2.0"));
+    CHECK(WaitFor([&] {
+      const std::shared_ptr<const Snapshot> snapshot = listener.snapshot();
+      return snapshot && snapshot->active() && snapshot->active()->media.rate == 2.0;
+    }));
+    CHECK(TracksPlayer(listener, *connection, busName));
+
+    // Paused, the position holds still
+    CHECK(players->command("status alpha Paused"));
+    CHECK(WaitFor([&] {
+      const std::shared_ptr<const Snapshot> snapshot = listener.snapshot();
+      return snapshot && snapshot->active() && snapshot->active()->media.status == now_playing::PlaybackStatus::Paused;
+    }));
+    const Option<i64> paused = ActivePosition(listener);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK(paused && ActivePosition(listener) == paused);
+    CHECK(TracksPlayer(listener, *connection, busName));
+
+    listener.stop();
+  }
+} // namespace
+
+auto main() -> int {
+  if (!tests::mpris::Available())
+    return tests::mpris::SKIP;
+
+  const Option<tests::mpris::Bus> bus = tests::mpris::Bus::Start();
+  if (!CHECK(bus))
+    return tests::Finish();
+
+  TestPolling(*bus);
+  TestWatchedNames(*bus);
+  TestListener(*bus);
+  TestPosition(*bus);
+
+  return tests::Finish();
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Scripted Music Player Daemon for the now_playing tests and benchmarks.
+
+Usage: mock_mpd.py SOCKET_PATH
+
+Listens on a Unix socket and answers the commands the plugin sends:
+password, status, currentsong, command lists, and idle/noidle. It prints
+"ready" once listening, then reads commands from stdin, one per line, and
+prints "ok" after each:
+
+  title TEXT     change the current song's title and wake idle clients
+  state STATE    change the state (play, pause, stop) and wake idle clients
+  stall          never answer the next command, as a hung server would
+  garble         answer the next command with a line that is not "key: value"
+  quit           exit (closing stdin does the same)
+
+The password is "secret"; any other is rejected with an ACK.
+"""
+
+import os
+import socket
+import sys
+import threading
+
+lock = threading.Condition()
+state = {"title": "Song A", "state": "play", "version": 0, "fault": None}
+
+
+def status():
+    return f"volume: 50\nstate: {state['state']}\nsongid: 7\nelapsed: 12.500\nduration: 200.000\n"
+
+
+def currentsong():
+    return (f"file: music/a b.flac\nArtist: X\nArtist: Y\nTitle: {state['title']}\nAlbum: Alb\n"
+            "Track: 3/12\nId: 7\nduration: 200.000\n")
+
+
+def take_fault():
+    with lock:
+        fault, state["fault"] = state["fault"], None
+        return fault
+
+
+def respond(connection, reply):
+    fault = take_fault()
+    if fault == "stall":
+        return
+    if fault == "garble":
+        reply = "this is not a pair\n" + reply
+    connection.sendall(reply.encode())
+
+
+def serve(connection):
+    try:
+        session(connection)
+    except OSError:
+        pass  # The client went away
+    finally:
+        connection.close()
+
+
+def session(connection):
+    # Like MPD, changes made while the client is busy are reported by its next idle
+    with lock:
+        seen = state["version"]
+
+    connection.sendall(b"OK MPD 0.23.5\n")
+    lines = connection.makefile("r", encoding="utf-8", newline="\n")
+    batch = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if line == "command_list_begin":
+            batch = ""
+            continue
+        if line == "command_list_end":
+            respond(connection, batch + "OK\n")
+            batch = None
+            continue
+
+        if line == "status":
+            reply = status()
+        elif line == "currentsong":
+            reply = currentsong()
+        elif line.startswith("password "):
+            if line != 'password "secret"':
+                respond(connection, "ACK [3@0] {password} incorrect password\n")
+                continue
+            reply = ""
+        elif line == "idle player":
+            # The plugin never sends noidle: it closes the connection instead
+            with lock:
+                lock.wait_for(lambda: state["version"] != seen)
+                seen = state["version"]
+            connection.sendall(b"changed: player\nOK\n")
+            continue
+        else:
+            respond(connection, "ACK [5@0] {} unknown command \"%s\"\n" % line)
+            continue
+
+        if batch is not None:
+            batch += reply
+        else:
+            respond(connection, reply + "OK\n")
+
+
+def command(line):
+    words = line.split(maxsplit=1)
+    if not words:
+        return True
+    if words[0] == "quit":
+        return False
+
+    with lock:
+        if words[0] == "title":
+            state["title"] = words[1]
+        elif words[0] == "state":
+            state["state"] = words[1]
+        elif words[0] in ("stall", "garble"):
+            state["fault"] = words[0]
+            return True
+        state["version"] += 1
+        lock.notify_all()
+    return True
+
+
+def main():
+    path = sys.argv[1]
+    if os.path.exists(path):
+        os.unlink(path)
+
+    server = socket.socket(socket.AF_UNIX)
+    server.bind(path)
+    server.listen()
+
+    def accept():
+        while True:
+            connection, _ = server.accept()
+            threading.Thread(target=serve, args=(connection,), daemon=True).start()
+
+    threading.Thread(target=accept, daemon=True).start()
+    print("ready", flush=True)
+
+    for line in sys.stdin:
+        if not command(line.strip()):
+            break
+        print("ok", flush=True)
+
+
+if __name__ == "__main__":
+    main()
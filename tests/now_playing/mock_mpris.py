@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""Scripted MPRIS players for the now_playing tests and benchmarks.
+
+Usage: mock_mpris.py ADDRESS SPEC...
+
+Each SPEC is NAME:STATUS[:TITLE_BYTES[:DELAY_MS]] and becomes one player on its
+own bus connection, owning org.mpris.MediaPlayer2.NAME. The players answer
+Properties.GetAll/Get for org.mpris.MediaPlayer2.Player, DELAY_MS after the
+call arrives (replies are scheduled, so one slow player does not hold up the
+others). Position starts at 0 and advances with the monotonic clock, scaled
+by Rate, while the player is Playing. Once every name is owned the script
+prints "ready". It then reads commands from stdin, one per
+line, and prints "ok" after each:
+
+  status NAME STATUS     change PlaybackStatus and emit PropertiesChanged
+  title NAME TEXT        change the title and emit PropertiesChanged
+  seek NAME US           jump to US microseconds and emit Seeked
+  rate NAME RATE         change Rate and emit PropertiesChanged
+  storm NAME COUNT       emit COUNT PropertiesChanged signals back to back
+  delay NAME MS          answer NAME's calls MS milliseconds late from now on
+  drop NAME              close NAME's connection, as if the player exited
+  quit                   exit (closing stdin does the same)
+
+Needs jeepney (pure Python, https://pypi.org/project/jeepney/).
+"""
+
+import heapq
+import itertools
+import selectors
+import sys
+import time
+
+from jeepney import DBusAddress, HeaderFields, MessageType, new_error, new_method_return, new_signal
+from jeepney.bus_messages import message_bus
+from jeepney.io.blocking import open_dbus_connection
+
+MPRIS_PREFIX = "org.mpris.MediaPlayer2."
+LENGTH_US = 180_000_000
+MPRIS_PATH = "/org/mpris/MediaPlayer2"
+PLAYER_IFACE = "org.mpris.MediaPlayer2.Player"
+PROPERTIES_IFACE = "org.freedesktop.DBus.Properties"
+
+
+class Player:
+    def __init__(self, address, name, status, title_bytes, delay_ms):
+        self.name = name
+        self.status = status
+        self.delay = delay_ms / 1000
+        self.title = (name + " title ").ljust(title_bytes, "x")[:title_bytes]
+        self.rate = 1.0
+        self.anchor_us = 0
+        self.anchored_at = time.monotonic()
+        self.connection = open_dbus_connection(bus=address)
+        self.connection.send_and_get_reply(message_bus.RequestName(MPRIS_PREFIX + name))
+
+    def metadata(self):
+        return ("a{sv}", {
+            "mpris:trackid": ("o", "/org/mpris/MediaPlayer2/Track/1"),
+            "xesam:title": ("s", self.title),
+            "xesam:artist": ("as", [self.name + " artist"]),
+            "xesam:album": ("s", self.name + " album"),
+            "mpris:length": ("x", LENGTH_US),
+        })
+
+    def position(self):
+        position = self.anchor_us
+        if self.status == "Playing":
+            position += int((time.monotonic() - self.anchored_at) * 1_000_000 * self.rate)
+        return max(0, min(position, LENGTH_US))
+
+    def anchor(self, position_us=None):
+        """Restart the clock at POSITION_US, or at the current position, before a change."""
+        self.anchor_us = self.position() if position_us is None else position_us
+        self.anchored_at = time.monotonic()
+
+    def properties(self):
+        return {
+            "PlaybackStatus": ("s", self.status),
+            "Metadata": self.metadata(),
+            "Position": ("x", self.position()),
+            "Rate": ("d", self.rate),
+        }
+
+    def changed(self, changes):
+        signal = new_signal(DBusAddress(MPRIS_PATH, interface=PROPERTIES_IFACE), "PropertiesChanged", "sa{sv}as",
+                            (PLAYER_IFACE, changes, []))
+        self.connection.send(signal)
+
+    def reply(self, message):
+        member = message.header.fields.get(HeaderFields.member)
+        if member == "GetAll":
+            return new_method_return(message, "a{sv}", (self.properties(),))
+        if member == "Get" and message.body[1] in self.properties():
+            return new_method_return(message, "v", (self.properties()[message.body[1]],))
+        return new_error(message, "org.freedesktop.DBus.Error.UnknownMethod", "s", (str(member),))
+
+    def drain(self, pending):
+        while True:
+            try:
+                message = self.connection.receive(timeout=0)
+            except TimeoutError:
+                return
+            if message.header.message_type != MessageType.method_call:
+                continue
+            if self.delay > 0:
+                pending.schedule(time.monotonic() + self.delay, self, message)
+            else:
+                self.connection.send(self.reply(message))
+
+
+class Pending:
+    """Replies held back by a player's DELAY_MS, earliest first."""
+
+    def __init__(self):
+        self.heap = []
+        self.order = itertools.count()
+
+    def schedule(self, due, player, message):
+        heapq.heappush(self.heap, (due, next(self.order), player, message))
+
+    def timeout(self):
+        return max(0.0, self.heap[0][0] - time.monotonic()) if self.heap else None
+
+    def send_due(self, players):
+        now = time.monotonic()
+        while self.heap and self.heap[0][0] <= now:
+            _, _, player, message = heapq.heappop(self.heap)
+            # A player dropped while its reply waited has nobody to answer for
+            if players.get(player.name) is player:
+                player.connection.send(player.reply(message))
+
+
+def command(players, selector, line):
+    words = line.split(maxsplit=2)
+    if not words:
+        return True
+    if words[0] == "quit":
+        return False
+
+    player = players[words[1]]
+    if words[0] == "status":
+        player.anchor()
+        player.status = words[2]
+        player.changed({"PlaybackStatus": ("s", player.status)})
+    elif words[0] == "title":
+        player.title = words[2]
+        player.changed({"Metadata": player.metadata()})
+    elif words[0] == "seek":
+        player.anchor(int(words[2]))
+        player.connection.send(new_signal(DBusAddress(MPRIS_PATH, interface=PLAYER_IFACE), "Seeked", "x",
+                                          (player.anchor_us,)))
+    elif words[0] == "rate":
+        player.anchor()
+        player.rate = float(words[2])
+        player.changed({"Rate": ("d", player.rate)})
+    elif words[0] == "delay":
+        player.delay = int(words[2]) / 1000
+    elif words[0] == "storm":
+        for _ in range(int(words[2])):
+            player.changed({"Metadata": player.metadata(), "PlaybackStatus": ("s", player.status)})
+    elif words[0] == "drop":
+        selector.unregister(player.connection.sock)
+        player.connection.close()
+        del players[words[1]]
+    return True
+
+
+def main():
+    address, specs = sys.argv[1], sys.argv[2:]
+
+    players = {}
+    for spec in specs:
+        name, status, *extra = spec.split(":")
+        title_bytes = int(extra[0]) if extra else 16
+        delay_ms = int(extra[1]) if len(extra) > 1 else 0
+        players[name] = Player(address, name, status, title_bytes, delay_ms)
+
+    selector = selectors.DefaultSelector()
+    for player in players.values():
+        selector.register(player.connection.sock, selectors.EVENT_READ, player)
+    selector.register(sys.stdin, selectors.EVENT_READ, None)
+
+    pending = Pending()
+    print("ready", flush=True)
+
+    while True:
+        for key, _ in selector.select(pending.timeout()):
+            if key.data is not None:
+                key.data.drain(pending)
+                continue
+
+            line = sys.stdin.readline()
+            if not line or not command(players, selector, line.strip()):
+                return
+            for player in players.values():
+                player.drain(pending)
+            print("ok", flush=True)
+        pending.send_due(players)
+
+
+if __name__ == "__main__":
+    main()
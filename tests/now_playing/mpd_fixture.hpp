@@ -0,0 +1,75 @@
+/**
+ * @file mpd_fixture.hpp
+ * @brief Scripted MPD server on a Unix socket
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Server runs mock_mpd.py (MOCK_MPD_SCRIPT) listening in a temporary
+ * directory; see that script for the commands it accepts. It only needs
+ * Python, so Available() does not ask for dbus-daemon or jeepney.
+ */
+
+#pragma once
+
+#include "tests/now_playing/mpris_fixture.hpp"
+
+namespace tests::mpd {
+  using namespace draconis::utils::types;
+
+  inline auto Available() -> bool {
+    return access(PYTHON_PROGRAM, X_OK) == 0;
+  }
+
+  /**
+   * @brief mock_mpd.py listening on `<tmpdir>/mpd.sock`
+   */
+  class Server {
+    std::filesystem::path m_directory;
+    mpris::Process        m_process;
+
+   public:
+    static auto Start() -> Option<Server> {
+      String directory = (std::filesystem::temp_directory_path() / "now_playing_mpd_XXXXXX").string();
+      if (!mkdtemp(directory.data()))
+        return None;
+
+      Server server;
+      server.m_directory = directory;
+
+      Option<mpris::Process> process = mpris::Process::Spawn({ PYTHON_PROGRAM, MOCK_MPD_SCRIPT, server.socketPath() });
+      if (!process || process->readLine() != "ready")
+        return None;
+
+      server.m_process = std::move(*process);
+      return server;
+    }
+
+    Server() = default;
+
+    Server(Server&& other) noexcept
+      : m_directory(std::exchange(other.m_directory, {})), m_process(std::move(other.m_process)) {}
+
+    Server(const Server&)                    = delete;
+    auto operator=(const Server&) -> Server& = delete;
+    auto operator=(Server&&) -> Server&      = delete;
+
+    ~Server() {
+      m_process = mpris::Process {};
+      if (!m_directory.empty()) {
+        std::error_code errc;
+        std::filesystem::remove_all(m_directory, errc);
+      }
+    }
+
+    [[nodiscard]] auto socketPath() const -> String {
+      return (m_directory / "mpd.sock").string();
+    }
+
+    /**
+     * @brief Run one mock_mpd.py command and wait until it has been applied
+     */
+    auto command(const StringView line) const -> bool {
+      return m_process.writeLine(line) && m_process.readLine() == "ok";
+    }
+  };
+} // namespace tests::mpd
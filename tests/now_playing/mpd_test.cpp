@@ -0,0 +1,129 @@
+/**
+ * @file mpd_test.cpp
+ * @brief now_playing's MPD client against a scripted server
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Covers decoding status and currentsong, authentication, and that
+ * every failure - a timeout, an ACK, a malformed line - closes the
+ * connection, so a late or partial response is never read as the answer to
+ * the next command. The plugin is driven in both modes on top.
+ */
+
+#include "now_playing/now_playing.cpp"
+
+#include <thread>
+
+#include "tests/check.hpp"
+#include "tests/now_playing/mpd_fixture.hpp"
+
+namespace {
+  using namespace now_playing::mpd;
+
+  auto Field(const PluginFields& fields, const String& name) -> String {
+    const auto found = fields.find(name);
+    if (found == fields.end())
+      return {};
+    const String* text = std::get_if<String>(&found->second);
+    return text ? *text : String {};
+  }
+
+  auto TestConnection(const tests::mpd::Server& server) -> void {
+    const Endpoint endpoint = ResolveEndpoint(server.socketPath(), None, None);
+
+    Result<Connection> connection = Connection::open(endpoint);
+    if (!CHECK(connection))
+      return;
+    CHECK(connection->version() == "0.23.5");
+
+    Result<now_playing::MediaData> media = FetchMedia(*connection);
+    if (CHECK(media)) {
+      CHECK(media->title == "Song A");
+      CHECK(media->artist == "X, Y");
+      CHECK(media->album == "Alb");
+      CHECK(media->trackNumber == 3);
+      CHECK(media->status == now_playing::PlaybackStatus::Playing);
+      CHECK(media->lengthUs == 200'000'000 && media->positionUs == 12'500'000);
+    }
+
+    // A stalled reply times out and closes the connection
+    CHECK(server.command("stall"));
+    const auto start = std::chrono::steady_clock::now();
+    media            = FetchMedia(*connection);
+    CHECK(!media && media.error().code == Timeout);
+    CHECK(!connection->isOpen());
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+
+    // A malformed line is a protocol error, not something to skip
+    connection = Connection::open(endpoint);
+    if (!CHECK(connection))
+      return;
+    CHECK(server.command("garble"));
+    media = FetchMedia(*connection);
+    CHECK(!media && media.error().code == ParseError);
+    CHECK(!connection->isOpen());
+
+    // An ACK closes the connection too, and a fresh one answers normally
+    connection = Connection::open(endpoint);
+    if (!CHECK(connection))
+      return;
+    CHECK(!connection->command("bogus", [](StringView, StringView) {}));
+    CHECK(!connection->isOpen());
+
+    connection = Connection::open(endpoint);
+    CHECK(connection && FetchMedia(*connection));
+
+    // Passwords go through MPD_HOST's "password@host" form as well
+    CHECK(Connection::open(ResolveEndpoint("secret@" + server.socketPath(), None, None)));
+    CHECK(!Connection::open(ResolveEndpoint(server.socketPath(), None, String("wrong"))));
+  }
+
+  auto TestPlugin(const tests::mpd::Server& server, const StringView mode) -> void {
+    NowPlayingPlugin plugin;
+    PluginCache      cache;
+    if (!CHECK(plugin.setConfig(std::format("backend = \"mpd\"\nmode = \"{}\"\nmpd_host = \"{}\"", mode, server.socketPath()))))
+      return;
+    if (!CHECK(plugin.initialize({}, cache)))
+      return;
+
+    CHECK(plugin.collectData(cache));
+    CHECK(Field(plugin.getFields(), "title") == "Song A");
+    CHECK(Field(plugin.getFields(), "player") == "mpd");
+
+    CHECK(server.command("title Song B"));
+    CHECK(server.command("state pause"));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!(plugin.collectData(cache) && Field(plugin.getFields(), "title") == "Song B" && Field(plugin.getFields(), "status") == "paused")
+           && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(Field(plugin.getFields(), "title") == "Song B");
+    CHECK(Field(plugin.getFields(), "status") == "paused");
+
+    if (mode == "poll") {
+      // A hung server fails the run once, without a retry, and the next run reconnects
+      CHECK(server.command("stall"));
+      CHECK(!plugin.collectData(cache));
+      CHECK(plugin.collectData(cache));
+    }
+
+    plugin.shutdown();
+    CHECK(server.command("title Song A"));
+    CHECK(server.command("state play"));
+  }
+} // namespace
+
+auto main() -> int {
+  if (!tests::mpd::Available())
+    return tests::mpris::SKIP;
+
+  const Option<tests::mpd::Server> server = tests::mpd::Server::Start();
+  if (!CHECK(server))
+    return tests::Finish();
+
+  TestConnection(*server);
+  TestPlugin(*server, "poll");
+  TestPlugin(*server, "events");
+
+  return tests::Finish();
+}
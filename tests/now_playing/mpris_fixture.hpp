@@ -0,0 +1,253 @@
+/**
+ * @file mpris_fixture.hpp
+ * @brief Private session bus with scripted MPRIS players
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Bus starts a dbus-daemon that listens in a temporary directory, so
+ * tests never touch the user's session bus. Players runs mock_mpris.py against
+ * it; see that script for the player spec and the commands it accepts.
+ *
+ * The tools come from the build (DBUS_DAEMON_PROGRAM, PYTHON_PROGRAM,
+ * MOCK_MPRIS_SCRIPT). When one is missing, or Python cannot import jeepney,
+ * Available() is false and tests exit with SKIP.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+
+#include <Drac++/Utils/Types.hpp>
+
+extern char** environ; // NOLINT(readability-redundant-declaration)
+
+namespace tests::mpris {
+  using namespace draconis::utils::types;
+
+  inline constexpr int SKIP = 77; // Matches SKIP_RETURN_CODE in tests/CMakeLists.txt
+
+  /**
+   * @brief Child process whose stdin and stdout are pipes
+   */
+  class Process {
+    pid_t m_pid    = -1;
+    int   m_stdin  = -1;
+    FILE* m_stdout = nullptr;
+
+   public:
+    Process() = default;
+
+    static auto Spawn(const Vec<String>& args) -> Option<Process> {
+      int input[2];
+      int output[2];
+      if (pipe(input) != 0)
+        return None;
+      if (pipe(output) != 0) {
+        close(input[0]);
+        close(input[1]);
+        return None;
+      }
+
+      posix_spawn_file_actions_t actions;
+      posix_spawn_file_actions_init(&actions);
+      posix_spawn_file_actions_adddup2(&actions, input[0], STDIN_FILENO);
+      posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+      posix_spawn_file_actions_addclose(&actions, input[1]);
+      posix_spawn_file_actions_addclose(&actions, output[0]);
+
+      Vec<char*> argv;
+      for (const String& arg : args)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+      argv.push_back(nullptr);
+
+      Process process;
+      const int spawned = posix_spawn(&process.m_pid, argv[0], &actions, nullptr, argv.data(), environ);
+      posix_spawn_file_actions_destroy(&actions);
+      close(input[0]);
+      close(output[1]);
+
+      process.m_stdin  = input[1];
+      process.m_stdout = fdopen(output[0], "r");
+      if (spawned != 0) {
+        process.m_pid = -1;
+        return None;
+      }
+
+      return process;
+    }
+
+    Process(Process&& other) noexcept
+      : m_pid(std::exchange(other.m_pid, -1)), m_stdin(std::exchange(other.m_stdin, -1)), m_stdout(std::exchange(other.m_stdout, nullptr)) {}
+
+    auto operator=(Process&& other) noexcept -> Process& {
+      if (this != &other) {
+        std::swap(m_pid, other.m_pid);
+        std::swap(m_stdin, other.m_stdin);
+        std::swap(m_stdout, other.m_stdout);
+      }
+      return *this;
+    }
+
+    Process(const Process&)                    = delete;
+    auto operator=(const Process&) -> Process& = delete;
+
+    ~Process() {
+      if (m_stdin >= 0)
+        close(m_stdin);
+      if (m_pid > 0) {
+        kill(m_pid, SIGTERM);
+        waitpid(m_pid, nullptr, 0);
+      }
+      if (m_stdout)
+        std::fclose(m_stdout);
+    }
+
+    auto writeLine(const StringView line) const -> bool {
+      String buffer = String(line) + '\n';
+      return write(m_stdin, buffer.data(), buffer.size()) == static_cast<ssize_t>(buffer.size());
+    }
+
+    auto readLine() const -> Option<String> {
+      String line;
+      for (int character = std::fgetc(m_stdout); character != EOF; character = std::fgetc(m_stdout)) {
+        if (character == '\n')
+          return line;
+        line.push_back(static_cast<char>(character));
+      }
+      return None;
+    }
+
+    /**
+     * @brief Wait for the process to exit
+     * @return Its exit status, or -1 if it did not exit normally
+     */
+    auto wait() -> int {
+      int status = 0;
+      if (waitpid(std::exchange(m_pid, -1), &status, 0) < 0 || !WIFEXITED(status))
+        return -1;
+      return WEXITSTATUS(status);
+    }
+  };
+
+  inline auto Available() -> bool {
+    if (access(DBUS_DAEMON_PROGRAM, X_OK) != 0 || access(PYTHON_PROGRAM, X_OK) != 0)
+      return false;
+
+    Option<Process> probe = Process::Spawn({ PYTHON_PROGRAM, "-c", "import jeepney" });
+    return probe && probe->wait() == 0;
+  }
+
+  /**
+   * @brief dbus-daemon listening on a socket in a temporary directory
+   */
+  class Bus {
+    std::filesystem::path m_directory;
+    Process               m_daemon;
+    String                m_address;
+
+   public:
+    static auto Start() -> Option<Bus> {
+      String directory = (std::filesystem::temp_directory_path() / "now_playing_bus_XXXXXX").string();
+      if (!mkdtemp(directory.data()))
+        return None;
+
+      Bus bus;
+      bus.m_directory = directory;
+
+      const std::filesystem::path config = bus.m_directory / "bus.conf";
+      std::ofstream(config) << R"(<!DOCTYPE busconfig PUBLIC "-//freedesktop//DTD D-Bus Bus Configuration 1.0//EN"
+ "http://www.freedesktop.org/standards/dbus/1.0/busconfig.dtd">
+<busconfig>
+  <type>session</type>
+  <listen>unix:path=)" << (bus.m_directory / "bus").string()
+                            << R"(</listen>
+  <auth>EXTERNAL</auth>
+  <policy context="default">
+    <allow send_destination="*" eavesdrop="true"/>
+    <allow eavesdrop="true"/>
+    <allow own="*"/>
+  </policy>
+</busconfig>
+)";
+
+      Option<Process> daemon = Process::Spawn({ DBUS_DAEMON_PROGRAM, "--config-file=" + config.string(), "--nofork", "--print-address" });
+      if (!daemon)
+        return None;
+
+      // The address is printed once the daemon is listening
+      Option<String> address = daemon->readLine();
+      if (!address || address->empty())
+        return None;
+
+      bus.m_daemon  = std::move(*daemon);
+      bus.m_address = std::move(*address);
+      return bus;
+    }
+
+    Bus() = default;
+
+    Bus(Bus&& other) noexcept
+      : m_directory(std::exchange(other.m_directory, {})), m_daemon(std::move(other.m_daemon)), m_address(std::move(other.m_address)) {}
+
+    Bus(const Bus&)                    = delete;
+    auto operator=(const Bus&) -> Bus& = delete;
+    auto operator=(Bus&&) -> Bus&      = delete;
+
+    ~Bus() {
+      m_daemon = Process {};
+      if (!m_directory.empty()) {
+        std::error_code errc;
+        std::filesystem::remove_all(m_directory, errc);
+      }
+    }
+
+    [[nodiscard]] auto address() const -> const String& {
+      return m_address;
+    }
+  };
+
+  struct PlayerSpec {
+    String name;                  // Owns org.mpris.MediaPlayer2.<name>
+    String status     = "Playing"; // PlaybackStatus
+    usize  titleBytes = 16;
+    u32    delayMs    = 0;         // How late the player answers calls
+  };
+
+  /**
+   * @brief mock_mpris.py hosting a set of players on a Bus
+   */
+  class Players {
+    Process m_process;
+
+   public:
+    static auto Start(const Bus& bus, const Vec<PlayerSpec>& specs) -> Option<Players> {
+      Vec<String> args = { PYTHON_PROGRAM, MOCK_MPRIS_SCRIPT, bus.address() };
+      for (const PlayerSpec& spec : specs)
+        args.push_back(std::format("{}:{}:{}:{}", spec.name, spec.status, spec.titleBytes, spec.delayMs));
+
+      Option<Process> process = Process::Spawn(args);
+      if (!process || process->readLine() != "ready")
+        return None;
+
+      Players players;
+      players.m_process = std::move(*process);
+      return players;
+    }
+
+    /**
+     * @brief Run one mock_mpris.py command and wait until it has been applied
+     */
+    auto command(const StringView line) const -> bool {
+      return m_process.writeLine(line) && m_process.readLine() == "ok";
+    }
+  };
+} // namespace tests::mpris
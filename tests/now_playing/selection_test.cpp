@@ -0,0 +1,210 @@
+/**
+ * @file selection_test.cpp
+ * @brief Which player now_playing reports, in poll and events mode
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Drives NowPlayingPlugin the way the host does - setConfig,
+ * initialize, collectData, getFields - against scripted players, and checks
+ * that a playing player always wins over paused ones, that the priority list
+ * only breaks ties, that the remembered poll-mode player is dropped as
+ * soon as it stops playing, and that in events mode change_fd wakes the host
+ * and generation moves when the player changes.
+ */
+
+#include "now_playing/now_playing.cpp"
+
+#include <poll.h>
+#include <thread>
+
+#include "tests/check.hpp"
+#include "tests/now_playing/mpris_fixture.hpp"
+
+namespace {
+  using namespace now_playing::dbus;
+
+  auto Field(const PluginFields& fields, const String& name) -> String {
+    const auto found = fields.find(name);
+    if (found == fields.end())
+      return {};
+    const String* text = std::get_if<String>(&found->second);
+    return text ? *text : String {};
+  }
+
+  /**
+   * @brief Plugin instance on the private bus
+   */
+  struct Plugin {
+    NowPlayingPlugin plugin;
+    PluginCache      cache;
+
+    auto start(const tests::mpris::Bus& bus, const StringView extraConfig) -> bool {
+      return plugin.setConfig(std::format("bus_address = \"{}\"\n{}", bus.address(), extraConfig)) && plugin.initialize({}, cache);
+    }
+
+    // The reported player once collectData succeeds
+    auto active() -> String {
+      return plugin.collectData(cache) ? Field(plugin.getFields(), "player") : String {};
+    }
+
+    // Collects until `name` is reported or two seconds pass (events mode applies changes asynchronously)
+    auto waitFor(const StringView name) -> bool {
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+      while (active() != name) {
+        if (std::chrono::steady_clock::now() > deadline)
+          return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+      return true;
+    }
+
+    ~Plugin() {
+      plugin.shutdown();
+    }
+  };
+
+  auto TestMode(const tests::mpris::Bus& bus, const StringView mode) -> void {
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(
+      bus, { { .name = "alpha", .status = "Paused" }, { .name = "beta" }, { .name = "gamma", .status = "Stopped" } }
+    );
+    if (!CHECK(players))
+      return;
+
+    Plugin plugin;
+    if (!CHECK(plugin.start(bus, std::format("mode = \"{}\"", mode))))
+      return;
+
+    // A paused player listed first on the bus still loses to a playing one
+    CHECK(plugin.waitFor("beta"));
+
+    const PluginFields fields = plugin.plugin.getFields();
+    CHECK(Field(fields, "status") == "playing");
+    CHECK(Field(fields, "title") == "beta title xxxxx");
+    CHECK(Field(fields, "player_count") == "3");
+    CHECK(Field(fields, "players") == "beta, alpha, gamma");
+
+    CHECK(players->command("status beta Paused"));
+    CHECK(players->command("status alpha Playing"));
+    CHECK(plugin.waitFor("alpha"));
+
+    // With nothing playing, paused still outranks stopped
+    CHECK(players->command("status alpha Stopped"));
+    CHECK(plugin.waitFor("beta"));
+
+    CHECK(players->command("drop beta"));
+    CHECK(plugin.waitFor("alpha"));
+  }
+
+  auto TestPriority(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players =
+      tests::mpris::Players::Start(bus, { { .name = "alpha" }, { .name = "beta" }, { .name = "gamma", .status = "Paused" } });
+    if (!CHECK(players))
+      return;
+
+    // Priority breaks the tie between playing players, but never promotes a paused one
+    Plugin preferBeta;
+    if (CHECK(preferBeta.start(bus, "players = [\"gamma\", \"beta\"]")))
+      CHECK(preferBeta.active() == "beta");
+  }
+
+  // Whether `fd` becomes readable within `timeoutMs`
+  auto Readable(const i32 fd, const i32 timeoutMs) -> bool {
+    pollfd entry { .fd = fd, .events = POLLIN, .revents = 0 };
+    return poll(&entry, 1, timeoutMs) == 1 && (entry.revents & POLLIN) != 0;
+  }
+
+  auto TestChangeNotification(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players = tests::mpris::Players::Start(bus, { { .name = "alpha" } });
+    if (!CHECK(players))
+      return;
+
+    // Poll mode has nothing to wait on
+    Plugin polling;
+    if (CHECK(polling.start(bus, "mode = \"poll\"")) && CHECK(polling.active() == "alpha"))
+      CHECK(!polling.plugin.getFields().contains("change_fd"));
+
+    Plugin plugin;
+    if (!CHECK(plugin.start(bus, "mode = \"events\"")) || !CHECK(plugin.waitFor("alpha")))
+      return;
+
+    const PluginFields fields     = plugin.plugin.getFields();
+    const String       changeFd   = Field(fields, "change_fd");
+    const String       generation = Field(fields, "generation");
+    if (!CHECK(!changeFd.empty() && !generation.empty()))
+      return;
+
+    // collectData has cleared the fd; a state change sets it again
+    const i32 fd = std::stoi(changeFd);
+    CHECK(!Readable(fd, 0));
+
+    CHECK(players->command("status alpha Paused"));
+    CHECK(Readable(fd, 2000));
+
+    CHECK(plugin.plugin.collectData(plugin.cache));
+    const PluginFields after = plugin.plugin.getFields();
+    CHECK(Field(after, "status") == "paused");
+    CHECK(std::stoull(Field(after, "generation")) > std::stoull(generation));
+    CHECK(!Readable(fd, 0));
+  }
+
+  auto TestRemembered(const tests::mpris::Bus& bus) -> void {
+    const Option<tests::mpris::Players> players =
+      tests::mpris::Players::Start(bus, { { .name = "alpha" }, { .name = "beta", .status = "Paused" } });
+    if (!CHECK(players))
+      return;
+
+    Session session;
+    if (!CHECK(session.open(bus.address())))
+      return;
+
+    Option<CachedPlayer>     remembered;
+    Result<Vec<PlayerState>> fetched = fetchPlayers(session, {}, remembered);
+    CHECK(fetched && fetched->front().media.playerName == "alpha");
+    CHECK(remembered && remembered->busName == "org.mpris.MediaPlayer2.alpha");
+
+    // Asking the remembered player first still reports every player, and the priority list still applies
+    fetched = fetchPlayers(session, {}, remembered);
+    CHECK(fetched && fetched->size() == 2 && fetched->front().media.playerName == "alpha");
+
+    CHECK(players->command("status beta Playing"));
+    const Array<String, 1> preferBeta = { "beta" };
+    fetched                           = fetchPlayers(session, preferBeta, remembered);
+    CHECK(fetched && fetched->front().media.playerName == "beta");
+    CHECK(remembered && remembered->busName == "org.mpris.MediaPlayer2.beta");
+    CHECK(players->command("status beta Paused"));
+    CHECK(fetchPlayers(session, {}, remembered));
+
+    // The remembered player paused and another started: rediscover rather than keep reporting it
+    CHECK(players->command("status alpha Paused"));
+    CHECK(players->command("status beta Playing"));
+
+    fetched = fetchPlayers(session, {}, remembered);
+    CHECK(fetched && fetched->front().media.playerName == "beta");
+    CHECK(remembered && remembered->busName == "org.mpris.MediaPlayer2.beta");
+
+    // A remembered player that exited is rediscovered too
+    CHECK(players->command("drop beta"));
+    fetched = fetchPlayers(session, {}, remembered);
+    CHECK(fetched && fetched->size() == 1 && fetched->front().media.playerName == "alpha");
+
+    // Nothing playing: nothing worth remembering
+    CHECK(!remembered);
+  }
+} // namespace
+
+auto main() -> int {
+  if (!tests::mpris::Available())
+    return tests::mpris::SKIP;
+
+  const Option<tests::mpris::Bus> bus = tests::mpris::Bus::Start();
+  if (!CHECK(bus))
+    return tests::Finish();
+
+  TestMode(*bus, "poll");
+  TestMode(*bus, "events");
+  TestPriority(*bus);
+  TestChangeNotification(*bus);
+  TestRemembered(*bus);
+
+  return tests::Finish();
+}
@@ -0,0 +1,112 @@
+/**
+ * @file text_test.cpp
+ * @brief now_playing's UTF-8 repair and width functions
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details The ASCII fast paths and the early exit in Truncate() are checked
+ * against straightforward codepoint-at-a-time versions on generated strings
+ * mixing ASCII, accented, wide, zero-width, control and invalid sequences.
+ */
+
+#include "now_playing/now_playing_text.hpp"
+
+#include <random>
+
+#include "tests/check.hpp"
+
+namespace {
+  using namespace now_playing::text;
+
+  auto ReferenceWidth(const StringView text) -> usize {
+    usize width = 0;
+    for (usize pos = 0; pos < text.size();) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      width += decoded.valid ? CodepointWidth(decoded.codepoint) : 1;
+      pos += decoded.length;
+    }
+    return width;
+  }
+
+  auto ReferenceSanitize(const StringView text) -> String {
+    String repaired;
+    for (usize pos = 0; pos < text.size();) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      if (!decoded.valid)
+        repaired += REPLACEMENT_UTF8;
+      else if (detail::IsControl(decoded.codepoint))
+        repaired += ' ';
+      else
+        repaired.append(text.substr(pos, decoded.length));
+      pos += decoded.length;
+    }
+    return repaired;
+  }
+
+  auto ReferenceTruncate(const StringView text, const usize columns) -> String {
+    if (ReferenceWidth(text) <= columns)
+      return String(text);
+    if (columns == 0)
+      return {};
+
+    usize pos   = 0;
+    usize width = 0;
+    while (pos < text.size()) {
+      const detail::Decoded decoded = detail::Decode(text, pos);
+      const usize           cost    = decoded.valid ? CodepointWidth(decoded.codepoint) : 1;
+      if (width + cost > columns - 1)
+        break;
+      width += cost;
+      pos += decoded.length;
+    }
+    return String(text.substr(0, pos)) + String(ELLIPSIS);
+  }
+
+  auto TestExamples() -> void {
+    CHECK(Truncate("Hello, world", 20) == "Hello, world");
+    CHECK(Truncate("Hello, world", 6) == "Hello\xE2\x80\xA6");
+    CHECK(Truncate("Hello", 0).empty());
+    CHECK(Truncate("", 0).empty());
+
+    // A wide character that would straddle the limit is dropped
+    CHECK(Truncate("ab\xE3\x81\x82\xE3\x81\x84", 4) == "ab\xE2\x80\xA6");
+    CHECK(DisplayWidth("ab\xE3\x81\x82\xE3\x81\x84") == 6);
+
+    String broken = "a\xFF" "b\nc";
+    CHECK(Sanitize(broken) && broken == "a\xEF\xBF\xBD" "b c");
+
+    String clean = "plain \xE3\x81\x82 text";
+    CHECK(!Sanitize(clean));
+  }
+
+  auto TestAgainstReference() -> void {
+    constexpr Array<StringView, 12> PIECES = {
+      "a", "Some words ", "0123456789abcdef", "\xC3\xA9", "\xE3\x81\x82", "\xF0\x9F\x8E\xB5",
+      "\xCC\x81", "\xE2\x80\x8D", "\xFF", "\xC3", "\n", "\x7F",
+    };
+
+    std::mt19937 random(1234); // NOLINT(cert-msc32-c, cert-msc51-cpp) - reproducible inputs
+    for (i32 round = 0; round < 5000; ++round) {
+      String     text;
+      const auto pieces = random() % 24;
+      for (u32 index = 0; index < pieces; ++index)
+        text += PIECES[random() % PIECES.size()];
+
+      CHECK(DisplayWidth(text) == ReferenceWidth(text));
+
+      String repaired = text;
+      Sanitize(repaired);
+      CHECK(repaired == ReferenceSanitize(text));
+
+      for (usize columns = 0; columns <= 24; ++columns)
+        if (!CHECK(Truncate(text, columns) == ReferenceTruncate(text, columns)))
+          return;
+    }
+  }
+} // namespace
+
+auto main() -> int {
+  TestExamples();
+  TestAgainstReference();
+  return tests::Finish();
+}
@@ -0,0 +1,138 @@
+/**
+ * @file template_test.cpp
+ * @brief template_format's default layout, tag syntax and file extension
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details The default template claims to lay out the markdown format's
+ * document, so its output on the sample documents is compared with the
+ * markdown goldens in tests/markdown_format/golden/. The conditions and
+ * filters it relies on are then checked one by one.
+ */
+
+#include "template_format/template_format.cpp"
+
+#include <chrono>
+
+#include "tests/check.hpp"
+#include "tests/common/format_cases.hpp"
+#include "tests/common/golden.hpp"
+
+namespace {
+  using draconis::core::plugin::PluginData;
+
+  auto Render(const StringView source, const Map<String, String>& data, const PluginData& pluginData = {}) -> String {
+    const Result<template_format::Program> program = template_format::Program::Compile(source, "test");
+    if (!CHECK(program)) {
+      std::fprintf(stderr, "  %s\n", program.error().message.c_str());
+      return {};
+    }
+
+    String out;
+    program->render(data, pluginData, out);
+    return out;
+  }
+
+  auto CompileError(const StringView source) -> String {
+    const Result<template_format::Program> program = template_format::Program::Compile(source, "test");
+    return CHECK(!program) ? program.error().message : String {};
+  }
+
+  auto TestDefaultMatchesMarkdown(const fs::path& configDir) -> void {
+    TemplateFormatPlugin plugin;
+    PluginCache          cache;
+    draconis::core::plugin::PluginContext context;
+    context.configDir = configDir;
+
+    if (!CHECK(plugin.initialize(context, cache)))
+      return;
+
+    for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+      if (sample.name == "large")
+        continue;
+
+      const Option<String> expected = tests::golden::Read(fs::path(MARKDOWN_GOLDEN_DIR) / (sample.name + ".md"));
+      const Result<String> document = plugin.formatOutput("template", sample.data, sample.pluginData);
+
+      if (CHECK(expected && document) && !CHECK(*document == *expected))
+        std::fprintf(stderr, "  %s sample:\n%s\n", sample.name.c_str(), document->c_str());
+    }
+
+    CHECK(plugin.getFileExtension("template") == "md");
+  }
+
+  auto TestConditions() -> void {
+    const StringView source = "{{#if host or os}}A{{else}}B{{/if}}{{#unless host or os}}C{{else}}D{{/unless}}";
+
+    CHECK(Render(source, {}) == "BC");
+    CHECK(Render(source, { { "host", "box" } }) == "AD");
+    CHECK(Render(source, { { "os", "Linux" } }) == "AD");
+    CHECK(Render("{{#if a or b or c}}yes{{/if}}", { { "c", "1" } }) == "yes");
+
+    const StringView plugins = "{{#if plugins}}some{{else}}none{{/if}}";
+    CHECK(Render(plugins, {}) == "none");
+    CHECK(Render(plugins, {}, { { "now_playing", {} } }) == "some");
+  }
+
+  auto TestFilters() -> void {
+    const StringView round = "[{{weather_temperature | round}}]";
+
+    CHECK(Render(round, { { "weather_temperature", "21.6" } }) == "[22]");
+    CHECK(Render(round, { { "weather_temperature", "-3.4" } }) == "[-3]");
+    CHECK(Render(round, { { "weather_temperature", "-0.4" } }) == "[0]");
+    CHECK(Render(round, { { "weather_temperature", "abc" } }) == "[]");
+
+    const StringView nonzero = "{{#if packages | nonzero}}{{packages}}{{else}}-{{/if}}";
+
+    CHECK(Render(nonzero, { { "packages", "42" } }) == "42");
+    CHECK(Render(nonzero, { { "packages", "0" } }) == "-");
+    CHECK(Render(nonzero, { { "packages", "junk" } }) == "-");
+
+    // Plugin fields that are not strings are filtered through their text
+    CHECK(Render("{{weather.temp | round}}", {}, { { "weather", { { "temp", 7.5 } } } }) == "8");
+  }
+
+  auto TestCompileErrors() -> void {
+    CHECK(CompileError("{{host | upper}}").contains("unknown filter 'upper'"));
+    CHECK(CompileError("{{plugins}}").contains("'plugins' can only be tested"));
+    CHECK(CompileError("{{#if plugins | round}}{{/if}}").contains("'plugins' cannot be filtered"));
+    CHECK(CompileError("{{#if host or}}{{/if}}").contains("'host or' is not a valid name"));
+  }
+
+  auto TestFileExtension(const fs::path& configDir) -> void {
+    PluginCache                           cache;
+    draconis::core::plugin::PluginContext context;
+    context.configDir = configDir;
+
+    std::ofstream(configDir / "template.tmpl", std::ios::trunc) << "{{host}}\n";
+
+    TemplateFormatPlugin custom;
+    if (CHECK(custom.initialize(context, cache)))
+      CHECK(custom.getFileExtension("template") == "txt");
+
+    TemplateFormatPlugin configured;
+    CHECK(configured.setConfig("# Saved as report.html\nextension = \".html\"\n"));
+    if (CHECK(configured.initialize(context, cache)))
+      CHECK(configured.getFileExtension("template") == "html");
+
+    TemplateFormatPlugin invalid;
+    CHECK(invalid.setConfig("extension = \"../x\""));
+    if (CHECK(invalid.initialize(context, cache)))
+      CHECK(invalid.getFileExtension("template") == "txt");
+  }
+} // namespace
+
+auto main() -> int {
+  const fs::path configDir = fs::temp_directory_path() / std::format("template_format_test.{}", std::chrono::steady_clock::now().time_since_epoch().count());
+
+  TestDefaultMatchesMarkdown(configDir);
+  TestConditions();
+  TestFilters();
+  TestCompileErrors();
+  TestFileExtension(configDir);
+
+  std::error_code errc;
+  fs::remove_all(configDir, errc);
+
+  return tests::Finish();
+}
@@ -0,0 +1,55 @@
+/**
+ * @file forecast_kernels_test.cpp
+ * @brief Runtime checks for the weather forecast kernels
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details ForecastKernels.hpp already checks itself with static_asserts, but
+ * those evaluate the series-based ConstMath path. This test runs the same
+ * published-table checks and the reference comparison on the runtime <cmath>
+ * path, which is what the plugin actually executes.
+ */
+
+#include "tests/check.hpp"
+#include "weather/ForecastKernels.hpp"
+
+namespace {
+  using namespace weather::kernels;
+
+  auto RuntimeKernelsMatchReference() -> bool {
+    ForecastColumns columns;
+    for (f64 temperature = -40.0; temperature <= 45.0; temperature += 2.5)
+      for (f64 humidity = 0.0; humidity <= 100.0; humidity += 12.5)
+        for (f64 windSpeed = 0.0; windSpeed <= 20.0; windSpeed += 2.5) {
+          columns.time.push_back(0);
+          columns.temperature.push_back(temperature);
+          columns.relativeHumidity.push_back(humidity);
+          columns.windSpeed.push_back(windSpeed);
+        }
+
+    const DerivedColumns derived = ComputeAll(columns);
+
+    for (usize index = 0; index < columns.size(); ++index) {
+      const f64 temp     = columns.temperature[index];
+      const f64 humidity = columns.relativeHumidity[index];
+      const f64 wind     = columns.windSpeed[index];
+
+      if (!reference::Near(derived.apparentTemperature[index], reference::ApparentTemperature(temp, humidity, wind), reference::KERNEL_TOLERANCE) ||
+          !reference::Near(derived.dewPoint[index], reference::DewPoint(temp, humidity), reference::KERNEL_TOLERANCE) ||
+          !reference::Near(derived.heatIndex[index], reference::HeatIndex(temp, humidity), reference::KERNEL_TOLERANCE) ||
+          !reference::Near(derived.windChill[index], reference::WindChill(temp, wind), reference::KERNEL_TOLERANCE))
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+auto main() -> int {
+  CHECK(published::HeatIndexMatchesChart());
+  CHECK(published::WindChillMatchesTable());
+  CHECK(published::DewPointMatchesTable());
+  CHECK(RuntimeKernelsMatchReference());
+
+  return tests::Finish();
+}
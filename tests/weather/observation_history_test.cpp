@@ -0,0 +1,147 @@
+/**
+ * @file observation_history_test.cpp
+ * @brief Appends, wrap-around and lookups of the observation history ring
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Each test opens its own ring file in a temporary directory, the
+ * way the plugin opens one under its cache directory, and reopens it where
+ * the result has to survive the process.
+ */
+
+#include <chrono>
+#include <format>
+#include <fstream>
+
+#include "tests/check.hpp"
+#include "weather/ObservationHistory.hpp"
+
+namespace {
+  namespace fs = std::filesystem;
+  using namespace weather::history;
+
+  constexpr i64 START    = 1'700'000'000;
+  constexpr i64 INTERVAL = 600; // The plugin's 10-minute cache interval
+
+  auto At(const u64 index) -> Observation {
+    return {
+      .timestamp     = START + (static_cast<i64>(index) * INTERVAL),
+      .temperatureC  = static_cast<f64>(index % 40) - 10.0,
+      .conditionCode = static_cast<i32>(index % 100),
+    };
+  }
+
+  auto Same(const Option<Observation>& actual, const Observation& expected) -> bool {
+    return actual && actual->timestamp == expected.timestamp && actual->temperatureC == expected.temperatureC &&
+      actual->conditionCode == expected.conditionCode;
+  }
+
+  auto TestAppend(const fs::path& path) -> void {
+    Result<ObservationRing> ring = ObservationRing::open(path);
+    if (!CHECK(ring))
+      return;
+
+    CHECK(!ring->latest());
+    CHECK(!ring->nearest(START, INTERVAL));
+
+    for (u64 index = 0; index < 5; ++index)
+      ring->append(At(index));
+
+    CHECK(Same(ring->latest(), At(4)));
+
+    // Records outlive the mapping and are seen by the next opener
+    ring = ObservationRing::open(path);
+    if (CHECK(ring)) {
+      CHECK(Same(ring->latest(), At(4)));
+      CHECK(Same(ring->nearest(At(0).timestamp, INTERVAL), At(0)));
+    }
+  }
+
+  auto TestNearest(const fs::path& path) -> void {
+    Result<ObservationRing> ring = ObservationRing::open(path);
+    if (!CHECK(ring))
+      return;
+
+    for (u64 index = 0; index < 10; ++index)
+      ring->append(At(index));
+
+    // At a stored timestamp
+    CHECK(Same(ring->nearest(At(3).timestamp, INTERVAL), At(3)));
+    CHECK(Same(ring->nearest(At(3).timestamp, 1), At(3)));
+
+    // Between two, closer to either side
+    CHECK(Same(ring->nearest(At(3).timestamp + 100, INTERVAL), At(3)));
+    CHECK(Same(ring->nearest(At(4).timestamp - 100, INTERVAL), At(4)));
+
+    // Halfway, the earlier record wins
+    CHECK(Same(ring->nearest(At(3).timestamp + (INTERVAL / 2), INTERVAL), At(3)));
+
+    // Before the first and after the last record
+    CHECK(Same(ring->nearest(START - 60, INTERVAL), At(0)));
+    CHECK(Same(ring->nearest(At(9).timestamp + 60, INTERVAL), At(9)));
+
+    // Nothing within maxDistance
+    CHECK(!ring->nearest(At(3).timestamp + 200, 100));
+    CHECK(!ring->nearest(START - (2 * INTERVAL), INTERVAL));
+  }
+
+  auto TestWrapAround(const fs::path& path) -> void {
+    Result<ObservationRing> ring = ObservationRing::open(path);
+    if (!CHECK(ring))
+      return;
+
+    constexpr u64 OVERWRITTEN = 10;
+    constexpr u64 TOTAL       = CAPACITY + OVERWRITTEN;
+
+    for (u64 index = 0; index < TOTAL; ++index)
+      ring->append(At(index));
+
+    CHECK(Same(ring->latest(), At(TOTAL - 1)));
+
+    // The oldest records were overwritten in place; the oldest survivor is now first
+    for (u64 index = 0; index < OVERWRITTEN; ++index)
+      CHECK(!ring->nearest(At(index).timestamp, 1));
+
+    CHECK(Same(ring->nearest(At(OVERWRITTEN).timestamp, 1), At(OVERWRITTEN)));
+    CHECK(Same(ring->nearest(START, INTERVAL * static_cast<i64>(TOTAL)), At(OVERWRITTEN)));
+
+    // Every surviving record is still found, including the ones written over old slots
+    usize found = 0;
+    for (u64 index = OVERWRITTEN; index < TOTAL; ++index)
+      found += Same(ring->nearest(At(index).timestamp, 1), At(index)) ? 1 : 0;
+    CHECK(found == CAPACITY);
+
+    // One bucket per record over the last ten records
+    const Vec<Option<f64>> means = ring->downsample(At(TOTAL - 10).timestamp, At(TOTAL - 1).timestamp + INTERVAL, 10);
+    CHECK(means.size() == 10);
+    for (usize bucket = 0; bucket < means.size(); ++bucket)
+      CHECK(means[bucket] && *means[bucket] == At(TOTAL - 10 + bucket).temperatureC);
+  }
+
+  auto TestIncompatibleFile(const fs::path& path) -> void {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not an observation ring";
+
+    Result<ObservationRing> ring = ObservationRing::open(path);
+    if (!CHECK(ring))
+      return;
+
+    CHECK(!ring->latest());
+
+    ring->append(At(0));
+    CHECK(Same(ring->latest(), At(0)));
+  }
+} // namespace
+
+auto main() -> int {
+  const fs::path directory = fs::temp_directory_path() / std::format("observation_history_test.{}", std::chrono::steady_clock::now().time_since_epoch().count());
+
+  TestAppend(directory / "append.bin");
+  TestNearest(directory / "nearest.bin");
+  TestWrapAround(directory / "wrap.bin");
+  TestIncompatibleFile(directory / "incompatible.bin");
+
+  std::error_code errc;
+  fs::remove_all(directory, errc);
+
+  return tests::Finish();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file emitter_test.cpp
+ * @brief BlockWriter against RapidYAML on generated documents
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details BlockWriter promises RapidYAML's exact output. Built with
+ * YAML_FORMAT_USE_RYML, this test lays out the same randomly generated
+ * documents through BlockWriter and through the plugin's ryml TreeWriter and
+ * compares the text. Keys and values are assembled from fragments that
+ * change the scalar style: indicators, quotes, escapes, whitespace, numbers
+ * in every base and the special floats. detail::IsNumber() is compared with
+ * c4's is_number() the same way, and the "large" sample document is compared
+ * as a whole.
+ */
+
+#include "yaml_format/yaml_format.cpp"
+
+#include <random>
+
+#include "tests/check.hpp"
+#include "tests/common/format_cases.hpp"
+#include "yaml_format/yaml_emitter.hpp"
+
+namespace {
+  using yaml_format::emitter::BlockWriter;
+
+  constexpr u64 SEED = 12345;
+
+  // clang-format off
+  constexpr Array<StringView, 60> FRAGMENTS = {
+    "-", "-.", "+", ".", "0", "1", "9", "x", "X", "b", "o", "p", "P", "e", "E", "a", "f",
+    "inf", "infinity", "nan", "INF", " ", "\n", "\t", "\r", "\b", "'", "\"", "\\", ":", "#",
+    ",", "[", "]", "{", "}", "?", "*", "&", "|", ">", "%", "@", "`", "!", "~", "...", "---",
+    ";", ")", StringView("\0", 1), "é", "0x", "0b", "0o", "1.5", "e+", "p-", "null", "true",
+  };
+  // clang-format on
+
+  class Generator {
+   public:
+    explicit Generator(const u64 seed) : m_random(seed) {}
+
+    auto scalar() -> String {
+      String     text;
+      const auto count = m_random() % 6;
+      for (u64 index = 0; index < count; ++index)
+        text += FRAGMENTS[m_random() % FRAGMENTS.size()];
+      return text;
+    }
+
+    // Up to three entries per map and three levels of nested maps
+    template <typename Writer>
+    auto fill(Writer& writer, const usize depth = 0) -> void {
+      const auto count = m_random() % 4;
+      for (u64 index = 0; index < count; ++index) {
+        if (depth < 3 && m_random() % 3 == 0) {
+          // BlockWriter holds on to the key until the map's first entry
+          const String key = scalar();
+          writer.beginMap(key);
+          fill(writer, depth + 1);
+          writer.endMap();
+        } else {
+          const String key = scalar();
+          writer.entry(key, scalar());
+        }
+      }
+    }
+
+   private:
+    std::mt19937_64 m_random;
+  };
+
+  auto WithTree(const u64 seed) -> String {
+    // As the plugin's tree: an empty copy into an unallocated arena would be a
+    // null scalar, which ryml writes as nothing rather than ''
+    ryml::Tree tree;
+    tree.reserve_arena(64);
+    {
+      TreeWriter writer(tree);
+      Generator(seed).fill(writer);
+    }
+
+    String yaml;
+    ryml::emitrs_yaml(tree, &yaml, /*append=*/true);
+    return yaml;
+  }
+
+  auto WithBlockWriter(const u64 seed) -> String {
+    String      yaml;
+    BlockWriter writer(yaml);
+    Generator(seed).fill(writer);
+    writer.finish();
+    return yaml;
+  }
+
+  auto TestDocuments() -> void {
+    std::mt19937_64 seeds(SEED);
+    usize           mismatches = 0;
+
+    for (usize index = 0; index < 100'000; ++index) {
+      const u64    seed = seeds();
+      const String tree = WithTree(seed);
+      const String mine = WithBlockWriter(seed);
+
+      if (tree != mine && mismatches++ < 3)
+        std::fprintf(stderr, "seed %llu:\n--- ryml ---\n%s--- BlockWriter ---\n%s\n", static_cast<unsigned long long>(seed), tree.c_str(), mine.c_str());
+    }
+
+    CHECK(mismatches == 0);
+  }
+
+  auto TestNumbers() -> void {
+    constexpr StringView ALPHABET = "0123456789+-.eEpPxXbBoOinfatyINF ,;]\n";
+
+    std::mt19937_64 random(SEED);
+    usize           mismatches = 0;
+
+    for (usize index = 0; index < 1'000'000; ++index) {
+      String     text;
+      const auto length = 1 + (random() % 8);
+      for (u64 position = 0; position < length; ++position)
+        text += ALPHABET[random() % ALPHABET.size()];
+
+      if (ryml::to_csubstr(text).is_number() != yaml_format::emitter::detail::IsNumber(text) && mismatches++ < 5)
+        std::fprintf(stderr, "IsNumber disagrees with c4 on [%s]\n", text.c_str());
+    }
+
+    CHECK(mismatches == 0);
+  }
+
+  auto TestLargeDocument() -> void {
+    YamlFormatPlugin plugin;
+    PluginCache      cache;
+    if (!CHECK(plugin.initialize({}, cache)))
+      return;
+
+    for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+      const Result<String> tree = plugin.formatOutput("yaml", sample.data, sample.pluginData);
+
+      String      mine = "---\n";
+      BlockWriter writer(mine);
+      WriteDocument(writer, FieldValues::Extract(sample.data), sample.pluginData);
+
+      if (!CHECK(tree && *tree == mine))
+        std::fprintf(stderr, "  emitters differ on the %s sample\n", sample.name.c_str());
+    }
+  }
+} // namespace
+
+auto main() -> int {
+  TestDocuments();
+  TestNumbers();
+  TestLargeDocument();
+
+  return tests::Finish();
+}
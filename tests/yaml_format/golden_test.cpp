@@ -0,0 +1,35 @@
+/**
+ * @file golden_test.cpp
+ * @brief yaml_format's output on the sample documents against checked-in files
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Built twice: once as the plugin ships by default, with
+ * BlockWriter, and once with YAML_FORMAT_USE_RYML. Both builds must
+ * reproduce tests/yaml_format/golden/ byte for byte. The files were produced
+ * by the RapidYAML tree emitter that BlockWriter replaced; the "large" case
+ * is left to emitter_test.cpp.
+ */
+
+#include "yaml_format/yaml_format.cpp"
+
+#include "tests/common/format_cases.hpp"
+#include "tests/common/golden.hpp"
+
+auto main() -> int {
+  YamlFormatPlugin plugin;
+  PluginCache      cache;
+  if (!CHECK(plugin.initialize({}, cache)))
+    return tests::Finish();
+
+  for (const tests::formats::Case& sample : tests::formats::MakeCases()) {
+    if (sample.name == "large")
+      continue;
+
+    const Result<String> document = plugin.formatOutput("yaml", sample.data, sample.pluginData);
+    if (CHECK(document))
+      tests::golden::Check(std::filesystem::path(GOLDEN_DIR) / (sample.name + ".yaml"), *document);
+  }
+
+  return tests::Finish();
+}
@@ -0,0 +1,211 @@
+/**
+ * @file ConstMath.hpp
+ * @brief constexpr-capable math helpers for the weather plugin
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details The <cmath> functions are not usable in constant expressions on
+ * every supported compiler, so this header provides series-based versions for
+ * compile-time evaluation. At runtime each helper forwards to the <cmath>
+ * implementation, which keeps hot loops branch-light and lets the compiler
+ * use its vectorized math routines.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#include <Drac++/Utils/Types.hpp>
+
+namespace weather::math {
+  using draconis::utils::types::f64;
+  using draconis::utils::types::i32;
+  using draconis::utils::types::i64;
+
+  inline constexpr f64 PI         = std::numbers::pi;
+  inline constexpr f64 DEG_TO_RAD = PI / 180.0;
+  inline constexpr f64 RAD_TO_DEG = 180.0 / PI;
+
+  constexpr auto Abs(const f64 value) -> f64 {
+    return value < 0.0 ? -value : value;
+  }
+
+  constexpr auto Floor(const f64 value) -> f64 {
+    if !consteval {
+      return std::floor(value);
+    }
+
+    const auto truncated = static_cast<f64>(static_cast<i64>(value));
+    return truncated > value ? truncated - 1.0 : truncated;
+  }
+
+  constexpr auto Ceil(const f64 value) -> f64 {
+    return -Floor(-value);
+  }
+
+  /**
+   * @brief Wraps an angle in degrees into [0, 360)
+   */
+  constexpr auto WrapDegrees(const f64 degrees) -> f64 {
+    return degrees - (360.0 * Floor(degrees / 360.0));
+  }
+
+  constexpr auto Sqrt(const f64 value) -> f64 {
+    if !consteval {
+      return std::sqrt(value);
+    }
+
+    if (value <= 0.0)
+      return 0.0;
+
+    f64 guess = value > 1.0 ? value : 1.0;
+    for (i32 iteration = 0; iteration < 128; ++iteration) {
+      const f64 next = 0.5 * (guess + (value / guess));
+      if (next == guess)
+        break;
+      guess = next;
+    }
+    return guess;
+  }
+
+  constexpr auto Sin(const f64 radians) -> f64 {
+    if !consteval {
+      return std::sin(radians);
+    }
+
+    // Reduce to [-pi, pi], then fold into [-pi/2, pi/2] where the series converges quickly
+    f64 reduced = radians - (2.0 * PI * Floor((radians + PI) / (2.0 * PI)));
+    if (reduced > PI / 2.0)
+      reduced = PI - reduced;
+    else if (reduced < -PI / 2.0)
+      reduced = -PI - reduced;
+
+    const f64 squared = reduced * reduced;
+    f64       term    = reduced;
+    f64       sum     = reduced;
+    for (i32 index = 1; index < 14; ++index) {
+      term *= -squared / static_cast<f64>((2 * index) * ((2 * index) + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  constexpr auto Cos(const f64 radians) -> f64 {
+    if !consteval {
+      return std::cos(radians);
+    }
+
+    return Sin(radians + (PI / 2.0));
+  }
+
+  constexpr auto Atan(const f64 value) -> f64 {
+    if !consteval {
+      return std::atan(value);
+    }
+
+    if (value < 0.0)
+      return -Atan(-value);
+    if (value > 1.0)
+      return (PI / 2.0) - Atan(1.0 / value);
+
+    // Two half-angle reductions bring the argument below tan(pi/16)
+    f64 reduced = value;
+    for (i32 step = 0; step < 2; ++step)
+      reduced = reduced / (1.0 + Sqrt(1.0 + (reduced * reduced)));
+
+    const f64 squared = reduced * reduced;
+    f64       power   = reduced;
+    f64       sum     = reduced;
+    for (i32 index = 1; index < 24; ++index) {
+      power *= -squared;
+      sum += power / static_cast<f64>((2 * index) + 1);
+    }
+    return 4.0 * sum;
+  }
+
+  constexpr auto Asin(const f64 value) -> f64 {
+    if !consteval {
+      return std::asin(value);
+    }
+
+    if (value >= 1.0)
+      return PI / 2.0;
+    if (value <= -1.0)
+      return -PI / 2.0;
+    return Atan(value / Sqrt(1.0 - (value * value)));
+  }
+
+  constexpr auto Acos(const f64 value) -> f64 {
+    if !consteval {
+      return std::acos(value);
+    }
+
+    return (PI / 2.0) - Asin(value);
+  }
+
+  constexpr auto Exp(const f64 value) -> f64 {
+    if !consteval {
+      return std::exp(value);
+    }
+
+    // exp(x) = 2^k * exp(r) with |r| <= ln(2)/2
+    const f64 kValue  = Floor((value / std::numbers::ln2) + 0.5);
+    const f64 reduced = value - (kValue * std::numbers::ln2);
+
+    f64 term = 1.0;
+    f64 sum  = 1.0;
+    for (i32 index = 1; index < 24; ++index) {
+      term *= reduced / static_cast<f64>(index);
+      sum += term;
+    }
+
+    for (i64 step = 0; step < static_cast<i64>(Abs(kValue)); ++step)
+      sum = kValue > 0.0 ? sum * 2.0 : sum / 2.0;
+    return sum;
+  }
+
+  constexpr auto Log(const f64 value) -> f64 {
+    if !consteval {
+      return std::log(value);
+    }
+
+    if (value <= 0.0)
+      return -std::numeric_limits<f64>::infinity();
+
+    // Scale into [0.75, 1.5) by powers of two, then use log(x) = 2 * atanh((x - 1) / (x + 1))
+    f64 mantissa = value;
+    f64 exponent = 0.0;
+    while (mantissa >= 1.5) {
+      mantissa /= 2.0;
+      exponent += 1.0;
+    }
+    while (mantissa < 0.75) {
+      mantissa *= 2.0;
+      exponent -= 1.0;
+    }
+
+    const f64 ratio   = (mantissa - 1.0) / (mantissa + 1.0);
+    const f64 squared = ratio * ratio;
+    f64       power   = ratio;
+    f64       sum     = ratio;
+    for (i32 index = 1; index < 24; ++index) {
+      power *= squared;
+      sum += power / static_cast<f64>((2 * index) + 1);
+    }
+
+    return (2.0 * sum) + (exponent * std::numbers::ln2);
+  }
+
+  /**
+   * @brief base^exponent for positive bases
+   */
+  constexpr auto Pow(const f64 base, const f64 exponent) -> f64 {
+    if !consteval {
+      return std::pow(base, exponent);
+    }
+
+    return base > 0.0 ? Exp(exponent * Log(base)) : 0.0;
+  }
+} // namespace weather::math
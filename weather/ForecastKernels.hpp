@@ -0,0 +1,484 @@
+/**
+ * @file ForecastKernels.hpp
+ * @brief Batch kernels for derived weather metrics over forecast series
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Apparent temperature, dew point, heat index and wind chill are
+ * computed over structure-of-arrays forecast columns. Apparent temperature,
+ * dew point and heat index are single flat loops with no data-dependent
+ * branches (applicability ranges are handled with selects), so the compiler
+ * can auto-vectorize them; wind chill branches, as explained at WindChill(). A <cmath> call in the
+ * loop body would stop that: without -ffast-math it stays an opaque scalar
+ * call, and the kernels ran slower than the scalar reference. The loops
+ * therefore use detail::Exp() and detail::Log(), branch-free polynomial
+ * versions built from plain arithmetic and bit operations that the compiler
+ * inlines and vectorizes like the rest of the loop. bench/weather compares
+ * the batch kernels with the scalar reference.
+ *
+ * The `reference` namespace holds straightforward scalar versions of the same
+ * formulas. They share the kernels' coefficients, so they only catch mistakes
+ * in the vectorizable rewrite. The `published` namespace is the independent
+ * check: values read off the NWS heat index chart, the Environment Canada
+ * wind chill table and psychrometric dew point tables, compared with the
+ * batch kernels within each table's rounding. Everything is constexpr and is
+ * checked by the static_asserts at the bottom of this file; the unit test in
+ * tests/weather runs the same checks on the runtime <cmath> path.
+ *
+ * All inputs and outputs are metric: temperatures in °C, relative humidity in
+ * percent, wind speed in m/s.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <numbers>
+
+#include <Drac++/Utils/Types.hpp>
+
+#include "ConstMath.hpp"
+
+namespace weather::kernels {
+  using draconis::utils::types::Array;
+  using draconis::utils::types::f64;
+  using draconis::utils::types::i64;
+  using draconis::utils::types::Span;
+  using draconis::utils::types::u64;
+  using draconis::utils::types::usize;
+  using draconis::utils::types::Vec;
+
+  /**
+   * @brief Forecast series as parallel columns (one entry per forecast hour)
+   */
+  struct ForecastColumns {
+    Vec<i64> time;             // Unix seconds
+    Vec<f64> temperature;      // °C
+    Vec<f64> relativeHumidity; // %
+    Vec<f64> windSpeed;        // m/s
+
+    [[nodiscard]] constexpr auto size() const -> usize {
+      return std::min({ time.size(), temperature.size(), relativeHumidity.size(), windSpeed.size() });
+    }
+  };
+
+  /**
+   * @brief Derived metrics, aligned with the ForecastColumns they came from
+   */
+  struct DerivedColumns {
+    Vec<f64> apparentTemperature;
+    Vec<f64> dewPoint;
+    Vec<f64> heatIndex;
+    Vec<f64> windChill;
+  };
+
+  namespace detail {
+    // Magnus coefficients (Alduchov & Eskridge) used for the dew point
+    inline constexpr f64 MAGNUS_B = 17.62;
+    inline constexpr f64 MAGNUS_C = 243.12;
+
+    // Heat index is only defined from 80 °F; below that it equals air temperature
+    inline constexpr f64 HEAT_INDEX_MIN_F = 80.0;
+
+    // Wind chill is only defined at or below 10 °C with wind above 4.8 km/h
+    inline constexpr f64 WIND_CHILL_MAX_C   = 10.0;
+    inline constexpr f64 WIND_CHILL_MIN_KMH = 4.8;
+
+    // Applicability ranges are selected with integer masks rather than
+    // ternaries. With the default -ftrapping-math the compiler may not evaluate
+    // floating-point work a branch would skip, so it keeps a ternary as a
+    // branch, and converting a comparison's bool to a mask does not vectorize.
+
+    /**
+     * @brief All ones when lhs >= rhs, zero otherwise (neither may be NaN)
+     * @details lhs - rhs is +0 when the two are equal, so its sign bit alone decides.
+     */
+    constexpr auto AtLeast(const f64 lhs, const f64 rhs) -> u64 {
+      return (std::bit_cast<u64>(lhs - rhs) >> 63) - 1;
+    }
+
+    /**
+     * @brief ifSet where mask is all ones, ifClear where it is zero
+     */
+    constexpr auto Select(const u64 mask, const f64 ifSet, const f64 ifClear) -> f64 {
+      return std::bit_cast<f64>((std::bit_cast<u64>(ifSet) & mask) | (std::bit_cast<u64>(ifClear) & ~mask));
+    }
+
+    constexpr auto ClampHumidity(const f64 humidity) -> f64 {
+      const f64 atLeastOne = Select(AtLeast(humidity, 1.0), humidity, 1.0);
+      return Select(AtLeast(100.0, atLeastOne), atLeastOne, 100.0);
+    }
+
+    constexpr auto Rothfusz(const f64 tempF, const f64 humidity) -> f64 {
+      // clang-format off
+      return -42.379
+        + (2.04901523 * tempF)
+        + (10.14333127 * humidity)
+        - (0.22475541 * tempF * humidity)
+        - (0.00683783 * tempF * tempF)
+        - (0.05481717 * humidity * humidity)
+        + (0.00122874 * tempF * tempF * humidity)
+        + (0.00085282 * tempF * humidity * humidity)
+        - (0.00000199 * tempF * tempF * humidity * humidity);
+      // clang-format on
+    }
+
+    inline constexpr f64 LN2_HI = 0x1.62e42fee00000p-1; // ln 2 split so k * LN2_HI is exact
+    inline constexpr f64 LN2_LO = 0x1.a39ef35793c76p-33;
+
+    // Adding this to a double of magnitude below 2^51 rounds it to an integer
+    // held in the low bits of its representation
+    inline constexpr f64 ROUNDING_SHIFTER = 0x1.8p52;
+
+    /**
+     * @brief e^value for |value| < 700, to a relative error below 1e-11
+     * @details value = k ln 2 + r with |r| <= ln 2 / 2. e^r is a degree-9
+     * Taylor polynomial and 2^k is written straight into the exponent field.
+     */
+    constexpr auto Exp(const f64 value) -> f64 {
+      const f64 shifted = (value * std::numbers::log2e) + ROUNDING_SHIFTER;
+      const f64 k       = shifted - ROUNDING_SHIFTER;
+      const f64 r       = value - (k * LN2_HI) - (k * LN2_LO);
+
+      // Written out rather than looped over, so the compiler never sees control flow here
+      // clang-format off
+      const f64 poly = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040 +
+        r * (1.0 / 40320 + r / 362880.0))))))));
+      // clang-format on
+
+      // The low bits of `shifted` hold k; shifting them into the exponent field drops the rest
+      const u64 scale = (std::bit_cast<u64>(shifted) + 1023) << 52;
+      return poly * std::bit_cast<f64>(scale);
+    }
+
+    /**
+     * @brief Natural logarithm of a positive, normal value, to an absolute error below 1e-12
+     * @details value = 2^k z with z in [sqrt(1/2), sqrt(2)), found with unsigned
+     * integer operations only. ln z = 2 atanh(s) with s = (z - 1) / (z + 1),
+     * |s| < 0.172, summed to s^13.
+     */
+    constexpr auto Log(const f64 value) -> f64 {
+      constexpr u64 SQRT_HALF_BITS = 0x3fe6a09e667f3bcd;
+      constexpr u64 ONE_BITS       = 0x3ff0000000000000;
+      constexpr u64 INT_MAGIC_BITS = 0x4330000000000000; // 2^52, whose low mantissa bits read as an integer
+
+      // biased = k + 1023 for the k that brings the mantissa into [sqrt(1/2), sqrt(2))
+      const u64 bits   = std::bit_cast<u64>(value);
+      const u64 biased = (bits + (ONE_BITS - SQRT_HALF_BITS)) >> 52;
+      const f64 z      = std::bit_cast<f64>(bits - (biased << 52) + ONE_BITS);
+      const f64 k      = std::bit_cast<f64>(biased | INT_MAGIC_BITS) - 0x1p52 - 1023.0;
+
+      const f64 s       = (z - 1.0) / (z + 1.0);
+      const f64 squared = s * s;
+
+      // clang-format off
+      const f64 series = 1.0 + squared * (1.0 / 3 + squared * (1.0 / 5 + squared * (1.0 / 7 + squared * (1.0 / 9 + squared * (1.0 / 11 +
+        squared / 13.0)))));
+      // clang-format on
+
+      return (k * LN2_HI) + ((2.0 * s * series) + (k * LN2_LO));
+    }
+
+    static_assert(Exp(0.0) == 1.0 && Log(1.0) == 0.0);
+    static_assert(math::Abs(Exp(1.0) - std::numbers::e) < 1e-10 && math::Abs(Log(std::numbers::e) - 1.0) < 1e-11);
+  } // namespace detail
+
+  /**
+   * @brief Dew point (Magnus formula)
+   */
+  constexpr auto DewPoint(Span<const f64> temperature, Span<const f64> humidity, Span<f64> out) -> void {
+    using namespace detail;
+
+    const usize count = std::min({ temperature.size(), humidity.size(), out.size() });
+    for (usize index = 0; index < count; ++index) {
+      const f64 temp  = temperature[index];
+      const f64 gamma = detail::Log(ClampHumidity(humidity[index]) / 100.0) + (MAGNUS_B * temp / (MAGNUS_C + temp));
+      out[index]      = MAGNUS_C * gamma / (MAGNUS_B - gamma);
+    }
+  }
+
+  /**
+   * @brief Apparent temperature (Steadman, as used by the Australian BoM; no radiation term)
+   */
+  constexpr auto ApparentTemperature(Span<const f64> temperature, Span<const f64> humidity, Span<const f64> windSpeed, Span<f64> out)
+    -> void {
+    const usize count = std::min({ temperature.size(), humidity.size(), windSpeed.size(), out.size() });
+    for (usize index = 0; index < count; ++index) {
+      const f64 temp           = temperature[index];
+      const f64 vapourPressure = humidity[index] / 100.0 * 6.105 * detail::Exp(17.27 * temp / (237.7 + temp));
+      out[index]               = temp + (0.33 * vapourPressure) - (0.70 * windSpeed[index]) - 4.00;
+    }
+  }
+
+  /**
+   * @brief Heat index (NWS Rothfusz regression); equals air temperature below 80 °F
+   */
+  constexpr auto HeatIndex(Span<const f64> temperature, Span<const f64> humidity, Span<f64> out) -> void {
+    using namespace detail;
+
+    const usize count = std::min({ temperature.size(), humidity.size(), out.size() });
+    for (usize index = 0; index < count; ++index) {
+      const f64 temp   = temperature[index];
+      const f64 tempF  = (temp * 9.0 / 5.0) + 32.0;
+      const f64 indexC = (Rothfusz(tempF, humidity[index]) - 32.0) * 5.0 / 9.0;
+      out[index]       = Select(AtLeast(tempF, HEAT_INDEX_MIN_F), indexC, temp);
+    }
+  }
+
+  /**
+   * @brief Wind chill (Environment Canada / NWS 2001); equals air temperature outside its range
+   * @details Unlike the other kernels this one branches. Its transcendental
+   * term, wind speed to the 0.16, costs a Log() and an Exp() per hour, and
+   * most hours outside a cold season are warmer than the formula's range. A
+   * branch that skips them to a single std::pow measured faster than
+   * evaluating both polynomials on every hour.
+   */
+  constexpr auto WindChill(Span<const f64> temperature, Span<const f64> windSpeed, Span<f64> out) -> void {
+    using namespace detail;
+
+    const usize count = std::min({ temperature.size(), windSpeed.size(), out.size() });
+    for (usize index = 0; index < count; ++index) {
+      const f64 temp    = temperature[index];
+      const f64 windKmh = windSpeed[index] * 3.6;
+
+      if (temp > WIND_CHILL_MAX_C || windKmh <= WIND_CHILL_MIN_KMH) {
+        out[index] = temp;
+        continue;
+      }
+
+      const f64 windTerm = math::Pow(windKmh, 0.16);
+      out[index]         = 13.12 + (0.6215 * temp) - (11.37 * windTerm) + (0.3965 * temp * windTerm);
+    }
+  }
+
+  /**
+   * @brief Run every kernel over a forecast window
+   */
+  constexpr auto ComputeAll(const ForecastColumns& columns) -> DerivedColumns {
+    const usize count = columns.size();
+
+    const Span<const f64> temperature(columns.temperature.data(), count);
+    const Span<const f64> humidity(columns.relativeHumidity.data(), count);
+    const Span<const f64> windSpeed(columns.windSpeed.data(), count);
+
+    DerivedColumns derived {
+      .apparentTemperature = Vec<f64>(count),
+      .dewPoint            = Vec<f64>(count),
+      .heatIndex           = Vec<f64>(count),
+      .windChill           = Vec<f64>(count),
+    };
+
+    ApparentTemperature(temperature, humidity, windSpeed, derived.apparentTemperature);
+    DewPoint(temperature, humidity, derived.dewPoint);
+    HeatIndex(temperature, humidity, derived.heatIndex);
+    WindChill(temperature, windSpeed, derived.windChill);
+
+    return derived;
+  }
+
+  /**
+   * @brief Scalar reference implementations, written for clarity rather than speed
+   */
+  namespace reference {
+    constexpr auto DewPoint(const f64 temp, const f64 humidity) -> f64 {
+      const f64 gamma = math::Log(detail::ClampHumidity(humidity) / 100.0) + (detail::MAGNUS_B * temp / (detail::MAGNUS_C + temp));
+      return detail::MAGNUS_C * gamma / (detail::MAGNUS_B - gamma);
+    }
+
+    constexpr auto ApparentTemperature(const f64 temp, const f64 humidity, const f64 windSpeed) -> f64 {
+      const f64 vapourPressure = humidity / 100.0 * 6.105 * math::Exp(17.27 * temp / (237.7 + temp));
+      return temp + (0.33 * vapourPressure) - (0.70 * windSpeed) - 4.00;
+    }
+
+    constexpr auto HeatIndex(const f64 temp, const f64 humidity) -> f64 {
+      const f64 tempF = (temp * 9.0 / 5.0) + 32.0;
+      if (tempF < detail::HEAT_INDEX_MIN_F)
+        return temp;
+      return (detail::Rothfusz(tempF, humidity) - 32.0) * 5.0 / 9.0;
+    }
+
+    constexpr auto WindChill(const f64 temp, const f64 windSpeed) -> f64 {
+      const f64 windKmh = windSpeed * 3.6;
+      if (temp > detail::WIND_CHILL_MAX_C || windKmh <= detail::WIND_CHILL_MIN_KMH)
+        return temp;
+      const f64 windTerm = math::Pow(windKmh, 0.16);
+      return 13.12 + (0.6215 * temp) - (11.37 * windTerm) + (0.3965 * temp * windTerm);
+    }
+
+    struct Sample {
+      f64 temperature;
+      f64 humidity;
+      f64 windSpeed;
+    };
+
+    // Spans every applicability boundary: hot/humid, mild, cold/windy, calm, extreme humidity
+    inline constexpr Array<Sample, 8> SAMPLES = { {
+      {  32.0,  70.0,  2.0 },
+      {  26.7,  40.0,  0.0 },
+      {  20.0,  50.0,  3.0 },
+      {  10.0,  80.0,  1.0 },
+      {   0.0,  90.0,  8.0 },
+      { -10.0,  75.0,  5.5 },
+      { -25.0,  60.0, 15.0 },
+      {  15.0,   0.0,  0.5 },
+    } };
+
+    inline constexpr f64 KERNEL_TOLERANCE = 1e-9;
+
+    consteval auto KernelsMatchReference() -> bool {
+      ForecastColumns columns;
+      for (const Sample& sample : SAMPLES) {
+        columns.time.push_back(0);
+        columns.temperature.push_back(sample.temperature);
+        columns.relativeHumidity.push_back(sample.humidity);
+        columns.windSpeed.push_back(sample.windSpeed);
+      }
+
+      const DerivedColumns derived = ComputeAll(columns);
+
+      const auto close = [](const f64 lhs, const f64 rhs) { return math::Abs(lhs - rhs) <= KERNEL_TOLERANCE; };
+
+      for (usize index = 0; index < SAMPLES.size(); ++index) {
+        const auto& [temp, humidity, wind] = SAMPLES[index];
+
+        if (!close(derived.apparentTemperature[index], ApparentTemperature(temp, humidity, wind)) ||
+            !close(derived.dewPoint[index], DewPoint(temp, humidity)) ||
+            !close(derived.heatIndex[index], HeatIndex(temp, humidity)) ||
+            !close(derived.windChill[index], WindChill(temp, wind)))
+          return false;
+      }
+
+      return true;
+    }
+
+    constexpr auto Near(const f64 value, const f64 expected, const f64 tolerance) -> bool {
+      return math::Abs(value - expected) <= tolerance;
+    }
+  } // namespace reference
+
+  /**
+   * @brief Published table values, checked against the batch kernels
+   */
+  namespace published {
+    struct Entry {
+      f64 temperature;
+      f64 second; // Relative humidity (%) or wind speed (km/h), as the table is laid out
+      f64 expected;
+    };
+
+    // NWS heat index chart, in °F. The chart is rounded to whole degrees.
+    inline constexpr Array<Entry, 13> HEAT_INDEX_CHART = { {
+      {  80.0, 40.0,  80.0 },
+      {  86.0, 60.0,  91.0 },
+      {  86.0, 80.0, 100.0 },
+      {  88.0, 60.0,  95.0 },
+      {  90.0, 40.0,  91.0 },
+      {  90.0, 50.0,  95.0 },
+      {  90.0, 60.0, 100.0 },
+      {  90.0, 70.0, 106.0 },
+      {  90.0, 80.0, 113.0 },
+      {  94.0, 50.0, 102.0 },
+      {  96.0, 50.0, 108.0 },
+      { 100.0, 40.0, 109.0 },
+      { 100.0, 50.0, 118.0 },
+    } };
+
+    inline constexpr f64 HEAT_INDEX_TOLERANCE_F = 1.0;
+
+    // Environment Canada wind chill index table: °C and km/h, rounded to whole degrees
+    inline constexpr Array<Entry, 12> WIND_CHILL_TABLE = { {
+      {   5.0, 10.0,   3.0 },
+      {   0.0, 10.0,  -3.0 },
+      {   0.0, 20.0,  -5.0 },
+      {   0.0, 30.0,  -6.0 },
+      {  -5.0, 25.0, -12.0 },
+      { -10.0, 10.0, -15.0 },
+      { -10.0, 20.0, -18.0 },
+      { -10.0, 30.0, -20.0 },
+      { -20.0, 20.0, -30.0 },
+      { -20.0, 30.0, -33.0 },
+      { -30.0, 20.0, -43.0 },
+      { -40.0, 50.0, -63.0 },
+    } };
+
+    inline constexpr f64 WIND_CHILL_TOLERANCE_C = 0.5;
+
+    // Psychrometric dew point table: °C and % relative humidity, to 0.1 °C
+    inline constexpr Array<Entry, 9> DEW_POINT_TABLE = { {
+      { -10.0, 80.0, -12.8 },
+      {   0.0, 90.0,  -1.4 },
+      {  10.0, 80.0,   6.7 },
+      {  15.0, 70.0,   9.6 },
+      {  20.0, 50.0,   9.3 },
+      {  25.0, 60.0,  16.7 },
+      {  30.0, 50.0,  18.4 },
+      {  30.0, 90.0,  28.2 },
+      {  35.0, 40.0,  19.4 },
+    } };
+
+    inline constexpr f64 DEW_POINT_TOLERANCE_C = 0.1;
+
+    constexpr auto HeatIndexMatchesChart() -> bool {
+      Array<f64, HEAT_INDEX_CHART.size()> temperature {};
+      Array<f64, HEAT_INDEX_CHART.size()> humidity {};
+      Array<f64, HEAT_INDEX_CHART.size()> out {};
+
+      for (usize index = 0; index < HEAT_INDEX_CHART.size(); ++index) {
+        temperature[index] = (HEAT_INDEX_CHART[index].temperature - 32.0) * 5.0 / 9.0;
+        humidity[index]    = HEAT_INDEX_CHART[index].second;
+      }
+
+      HeatIndex(temperature, humidity, out);
+
+      for (usize index = 0; index < HEAT_INDEX_CHART.size(); ++index)
+        if (!reference::Near((out[index] * 9.0 / 5.0) + 32.0, HEAT_INDEX_CHART[index].expected, HEAT_INDEX_TOLERANCE_F))
+          return false;
+
+      return true;
+    }
+
+    constexpr auto WindChillMatchesTable() -> bool {
+      Array<f64, WIND_CHILL_TABLE.size()> temperature {};
+      Array<f64, WIND_CHILL_TABLE.size()> windSpeed {};
+      Array<f64, WIND_CHILL_TABLE.size()> out {};
+
+      for (usize index = 0; index < WIND_CHILL_TABLE.size(); ++index) {
+        temperature[index] = WIND_CHILL_TABLE[index].temperature;
+        windSpeed[index]   = WIND_CHILL_TABLE[index].second / 3.6;
+      }
+
+      WindChill(temperature, windSpeed, out);
+
+      for (usize index = 0; index < WIND_CHILL_TABLE.size(); ++index)
+        if (!reference::Near(out[index], WIND_CHILL_TABLE[index].expected, WIND_CHILL_TOLERANCE_C))
+          return false;
+
+      return true;
+    }
+
+    constexpr auto DewPointMatchesTable() -> bool {
+      Array<f64, DEW_POINT_TABLE.size()> temperature {};
+      Array<f64, DEW_POINT_TABLE.size()> humidity {};
+      Array<f64, DEW_POINT_TABLE.size()> out {};
+
+      for (usize index = 0; index < DEW_POINT_TABLE.size(); ++index) {
+        temperature[index] = DEW_POINT_TABLE[index].temperature;
+        humidity[index]    = DEW_POINT_TABLE[index].second;
+      }
+
+      DewPoint(temperature, humidity, out);
+
+      for (usize index = 0; index < DEW_POINT_TABLE.size(); ++index)
+        if (!reference::Near(out[index], DEW_POINT_TABLE[index].expected, DEW_POINT_TOLERANCE_C))
+          return false;
+
+      return true;
+    }
+  } // namespace published
+
+  static_assert(reference::KernelsMatchReference(), "Forecast kernels disagree with the scalar reference");
+
+  static_assert(published::HeatIndexMatchesChart(), "Heat index kernel is off the NWS heat index chart");
+  static_assert(published::WindChillMatchesTable(), "Wind chill kernel is off the Environment Canada table");
+  static_assert(published::DewPointMatchesTable(), "Dew point kernel is off the psychrometric table");
+} // namespace weather::kernels
@@ -0,0 +1,375 @@
+/**
+ * @file ObservationHistory.hpp
+ * @brief Memory-mapped observation history ring for the weather plugin
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Every fresh observation (timestamp, temperature, condition code) is
+ * appended to a fixed-size ring file under the plugin cache directory. The file
+ * is memory-mapped, so appends are a single atomic slot reservation plus a
+ * record store, and concurrent Draconis++ processes can share it without locks.
+ * The only lock is an exclusive file lock taken by open() while it initializes
+ * a new or incompatible file, so one opener never wipes records that another
+ * has just appended.
+ * Trend fields ("vs. yesterday", sparklines) are then computed locally instead
+ * of requesting historical data from the provider.
+ *
+ * Layout: a 32-byte Header followed by CAPACITY 24-byte Records. Each record
+ * carries the sequence number of the append that wrote it; readers ignore
+ * records whose sequence does not match the slot they expect, which covers
+ * both torn writes and slots that have since been overwritten. Concurrent
+ * writers reserve slots and take timestamps independently, so slot order is
+ * only approximately time order.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/file.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <Drac++/Utils/Error.hpp>
+#include <Drac++/Utils/Types.hpp>
+
+namespace weather::history {
+  using namespace draconis::utils::types;
+  using draconis::utils::error::DracError;
+  using enum draconis::utils::error::DracErrorCode;
+
+  inline constexpr u32   MAGIC    = 0x54534857; // "WHST"
+  inline constexpr u32   VERSION  = 1;
+  inline constexpr usize CAPACITY = 1024; // ~7 days at the 10-minute cache interval
+
+  /**
+   * @brief A single observation as returned to callers
+   */
+  struct Observation {
+    i64 timestamp;     // Unix seconds
+    f64 temperatureC;  // Always stored in Celsius
+    i32 conditionCode; // WMO weather code, -1 if unknown
+  };
+
+  namespace detail {
+    struct Header {
+      u32 magic;
+      u32 version;
+      u64 capacity;
+      u64 writeCount; // Total appends; accessed through std::atomic_ref
+      u64 reserved;
+    };
+
+    struct Record {
+      u64 sequence; // 1-based append number that last completed this slot
+      i64 timestamp;
+      f32 temperatureC;
+      i16 conditionCode;
+      u16 reserved;
+    };
+
+    static_assert(sizeof(Header) == 32);
+    static_assert(sizeof(Record) == 24);
+
+    inline constexpr usize FILE_SIZE = sizeof(Header) + (CAPACITY * sizeof(Record));
+  } // namespace detail
+
+  /**
+   * @brief Fixed-size, memory-mapped ring of observations
+   */
+  class ObservationRing {
+    u8* m_base = nullptr;
+#ifdef _WIN32
+    HANDLE m_file    = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+
+    ObservationRing() = default;
+
+    [[nodiscard]] auto header() const -> detail::Header* {
+      return reinterpret_cast<detail::Header*>(m_base); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    [[nodiscard]] auto slot(const u64 index) const -> detail::Record* {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return reinterpret_cast<detail::Record*>(m_base + sizeof(detail::Header)) + (index % CAPACITY);
+    }
+
+    [[nodiscard]] auto headerMatches() const -> bool {
+      const detail::Header* hdr = header();
+      return std::atomic_ref<u32>(const_cast<u32&>(hdr->magic)).load(std::memory_order_acquire) == MAGIC && hdr->version == VERSION &&
+        hdr->capacity == CAPACITY;
+    }
+
+    // Only called with the file lock held, after headerMatches() failed under it
+    auto reset() -> void {
+      detail::Header* hdr = header();
+      std::atomic_ref<u32>(hdr->magic).store(0, std::memory_order_relaxed);
+      std::fill_n(m_base + sizeof(u32), detail::FILE_SIZE - sizeof(u32), u8 { 0 });
+      hdr->version  = VERSION;
+      hdr->capacity = CAPACITY;
+      std::atomic_ref<u32>(hdr->magic).store(MAGIC, std::memory_order_release);
+    }
+
+    [[nodiscard]] auto writeCount() const -> u64 {
+      return std::atomic_ref<u64>(header()->writeCount).load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Read the record written by the given 0-based append, if still present
+     */
+    [[nodiscard]] auto read(const u64 appendIndex) const -> Option<Observation> {
+      const detail::Record* record = slot(appendIndex);
+
+      const u64 before = std::atomic_ref<u64>(const_cast<u64&>(record->sequence)).load(std::memory_order_acquire);
+      if (before != appendIndex + 1)
+        return None;
+
+      Observation observation {
+        .timestamp     = record->timestamp,
+        .temperatureC  = static_cast<f64>(record->temperatureC),
+        .conditionCode = static_cast<i32>(record->conditionCode),
+      };
+
+      // Re-check: a concurrent writer may have reused the slot while we copied it
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (std::atomic_ref<u64>(const_cast<u64&>(record->sequence)).load(std::memory_order_relaxed) != before)
+        return None;
+
+      return observation;
+    }
+
+    /**
+     * @brief Range of append indices still held by the ring: [first, end)
+     */
+    [[nodiscard]] auto window() const -> std::pair<u64, u64> {
+      const u64 end = writeCount();
+      return { end > CAPACITY ? end - CAPACITY : 0, end };
+    }
+
+    auto unmap() -> void {
+      if (!m_base)
+        return;
+#ifdef _WIN32
+      UnmapViewOfFile(m_base);
+      CloseHandle(m_mapping);
+      CloseHandle(m_file);
+      m_mapping = nullptr;
+      m_file    = INVALID_HANDLE_VALUE;
+#else
+      munmap(m_base, detail::FILE_SIZE);
+#endif
+      m_base = nullptr;
+    }
+
+   public:
+    ~ObservationRing() {
+      unmap();
+    }
+
+    ObservationRing(const ObservationRing&)                    = delete;
+    auto operator=(const ObservationRing&) -> ObservationRing& = delete;
+
+    ObservationRing(ObservationRing&& other) noexcept
+      : m_base(std::exchange(other.m_base, nullptr))
+#ifdef _WIN32
+        ,
+        m_file(std::exchange(other.m_file, INVALID_HANDLE_VALUE)),
+        m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+    {
+    }
+
+    auto operator=(ObservationRing&& other) noexcept -> ObservationRing& {
+      if (this != &other) {
+        unmap();
+        m_base = std::exchange(other.m_base, nullptr);
+#ifdef _WIN32
+        m_file    = std::exchange(other.m_file, INVALID_HANDLE_VALUE);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Open (creating if needed) the ring file and map it into memory
+     * @param path Location of the ring file, typically under the plugin cache directory
+     */
+    static auto open(const std::filesystem::path& path) -> Result<ObservationRing> {
+      std::error_code errc;
+      std::filesystem::create_directories(path.parent_path(), errc);
+
+      ObservationRing ring;
+
+#ifdef _WIN32
+      ring.m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (ring.m_file == INVALID_HANDLE_VALUE)
+        ERR_FMT(IoError, "Failed to open observation history {}: error {}", path.string(), GetLastError());
+
+      // CreateFileMapping grows the file to the mapping size if it is shorter
+      ring.m_mapping = CreateFileMappingW(ring.m_file, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(detail::FILE_SIZE), nullptr);
+      if (!ring.m_mapping)
+        ERR_FMT(IoError, "Failed to map observation history {}: error {}", path.string(), GetLastError());
+
+      ring.m_base = static_cast<u8*>(MapViewOfFile(ring.m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, detail::FILE_SIZE));
+      if (!ring.m_base)
+        ERR_FMT(IoError, "Failed to map observation history {}: error {}", path.string(), GetLastError());
+
+      // A fresh (zero-filled) file is adopted by the first opener; an incompatible one is reset.
+      // Both happen under the file lock, and the header is checked again once it is held.
+      if (!ring.headerMatches()) {
+        OVERLAPPED overlapped {};
+        if (!LockFileEx(ring.m_file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped))
+          ERR_FMT(IoError, "Failed to lock observation history {}: error {}", path.string(), GetLastError());
+
+        if (!ring.headerMatches())
+          ring.reset();
+
+        UnlockFileEx(ring.m_file, 0, MAXDWORD, MAXDWORD, &overlapped);
+      }
+#else
+      const i32 fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (fileDescriptor < 0)
+        ERR_FMT(IoError, "Failed to open observation history {}: {}", path.string(), std::strerror(errno));
+
+      struct stat fileStat {};
+      if (fstat(fileDescriptor, &fileStat) != 0 ||
+          (std::cmp_less(fileStat.st_size, detail::FILE_SIZE) && ftruncate(fileDescriptor, static_cast<off_t>(detail::FILE_SIZE)) != 0)) {
+        ::close(fileDescriptor);
+        ERR_FMT(IoError, "Failed to size observation history {}: {}", path.string(), std::strerror(errno));
+      }
+
+      void* mapping = mmap(nullptr, detail::FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+      if (mapping == MAP_FAILED) {
+        ::close(fileDescriptor);
+        ERR_FMT(IoError, "Failed to map observation history {}: {}", path.string(), std::strerror(errno));
+      }
+
+      ring.m_base = static_cast<u8*>(mapping);
+
+      // A fresh (zero-filled) file is adopted by the first opener; an incompatible one is reset.
+      // Both happen under the file lock, and the header is checked again once it is held.
+      if (!ring.headerMatches()) {
+        if (flock(fileDescriptor, LOCK_EX) != 0) {
+          ::close(fileDescriptor);
+          ERR_FMT(IoError, "Failed to lock observation history {}: {}", path.string(), std::strerror(errno));
+        }
+
+        if (!ring.headerMatches())
+          ring.reset();
+
+        flock(fileDescriptor, LOCK_UN);
+      }
+
+      ::close(fileDescriptor); // The mapping keeps the file referenced
+#endif
+
+      return ring;
+    }
+
+    /**
+     * @brief Append an observation (lock-free, safe across processes)
+     */
+    auto append(const Observation& observation) -> void {
+      const u64 appendIndex = std::atomic_ref<u64>(header()->writeCount).fetch_add(1, std::memory_order_acq_rel);
+
+      detail::Record* record = slot(appendIndex);
+
+      // Invalidate the slot first so readers never pair the old sequence with new data
+      std::atomic_ref<u64>(record->sequence).store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      record->timestamp     = observation.timestamp;
+      record->temperatureC  = static_cast<f32>(observation.temperatureC);
+      record->conditionCode = static_cast<i16>(observation.conditionCode);
+
+      std::atomic_ref<u64>(record->sequence).store(appendIndex + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Most recently appended observation
+     * @details Reads the newest slot, so this is O(1) unless that slot is being
+     * rewritten; only then does it walk back to the previous complete record.
+     */
+    [[nodiscard]] auto latest() const -> Option<Observation> {
+      const auto [first, end] = window();
+      for (u64 index = end; index > first; --index)
+        if (Option<Observation> observation = read(index - 1))
+          return observation;
+      return None;
+    }
+
+    /**
+     * @brief Observation closest to a point in time
+     * @details Concurrent writers can leave neighbouring slots out of time
+     * order, so this scans the whole window instead of binary searching it.
+     * The window is at most CAPACITY records (24 KiB), independent of history age.
+     * @param timestamp Target Unix time
+     * @param maxDistance Reject matches further than this many seconds away
+     */
+    [[nodiscard]] auto nearest(const i64 timestamp, const i64 maxDistance) const -> Option<Observation> {
+      Option<Observation> best;
+      i64                 bestDistance = maxDistance;
+
+      const auto [first, end] = window();
+      for (u64 index = first; index < end; ++index) {
+        const Option<Observation> observation = read(index);
+        if (!observation)
+          continue;
+
+        const i64 distance = observation->timestamp > timestamp ? observation->timestamp - timestamp : timestamp - observation->timestamp;
+        if (distance < bestDistance || (distance == bestDistance && !best)) {
+          best         = observation;
+          bestDistance = distance;
+        }
+      }
+
+      return best;
+    }
+
+    /**
+     * @brief Downsample temperatures in [from, to) into equally sized buckets
+     * @return The mean temperature (Celsius) of each bucket; None for empty buckets
+     */
+    [[nodiscard]] auto downsample(const i64 from, const i64 to, const usize buckets) const -> Vec<Option<f64>> {
+      Vec<f64>         sums(buckets, 0.0);
+      Vec<u32>         counts(buckets, 0);
+      Vec<Option<f64>> means(buckets);
+
+      if (buckets == 0 || to <= from)
+        return means;
+
+      const auto [first, end] = window();
+      for (u64 index = first; index < end; ++index) {
+        const Option<Observation> observation = read(index);
+        if (!observation || observation->timestamp < from || observation->timestamp >= to)
+          continue;
+
+        const auto bucket = static_cast<usize>((observation->timestamp - from) * static_cast<i64>(buckets) / (to - from));
+        sums[bucket] += observation->temperatureC;
+        ++counts[bucket];
+      }
+
+      for (usize bucket = 0; bucket < buckets; ++bucket)
+        if (counts[bucket] > 0)
+          means[bucket] = sums[bucket] / counts[bucket];
+
+      return means;
+    }
+  };
+} // namespace weather::history
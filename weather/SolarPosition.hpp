@@ -0,0 +1,218 @@
+/**
+ * @file SolarPosition.hpp
+ * @brief Local sunrise, sunset and twilight computation for the weather plugin
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details Implements the NOAA/Meeus low-precision sunrise equation, which is
+ * accurate to roughly a minute for latitudes below the polar circles. All
+ * functions are constexpr so the results can be checked against reference
+ * tables at compile time (see the static_asserts at the bottom of this file),
+ * and they contain no lookup tables or data-dependent loops so batches of
+ * locations vectorize well at runtime.
+ */
+
+#pragma once
+
+#include <Drac++/Utils/Types.hpp>
+
+#include "ConstMath.hpp"
+
+namespace weather::solar {
+  using draconis::utils::types::f64;
+  using draconis::utils::types::i64;
+  using draconis::utils::types::None;
+  using draconis::utils::types::Option;
+  using draconis::utils::types::StringView;
+
+  /**
+   * @brief Where the sun currently is relative to the horizon
+   */
+  enum class DayPhase : unsigned char {
+    Day,                  // Sun above the horizon (including refraction)
+    CivilTwilight,        // Sun 0.833°..6° below the horizon
+    NauticalTwilight,     // Sun 6°..12° below the horizon
+    AstronomicalTwilight, // Sun 12°..18° below the horizon
+    Night,                // Sun more than 18° below the horizon
+  };
+
+  /**
+   * @brief Solar events for the local solar day containing a given instant
+   * @note Event times are Unix timestamps (UTC). An event is None when the sun
+   * never crosses the corresponding altitude that day (polar day or night).
+   */
+  struct SolarDay {
+    Option<i64> sunrise;
+    Option<i64> sunset;
+    Option<i64> civilDawn;
+    Option<i64> civilDusk;
+    i64         solarNoon = 0;
+    f64         elevation = 0.0; // Current solar elevation in degrees
+    DayPhase    phase     = DayPhase::Night;
+  };
+
+  namespace detail {
+    inline constexpr f64 UNIX_EPOCH_JULIAN_DAY = 2440587.5;
+    inline constexpr f64 J2000_JULIAN_DAY      = 2451545.0;
+    inline constexpr f64 SECONDS_PER_DAY       = 86400.0;
+    inline constexpr f64 EARTH_AXIAL_TILT      = 23.4397;
+
+    // Altitudes of the sun's centre that define each event, in degrees
+    inline constexpr f64 SUNRISE_ALTITUDE  = -0.833; // Refraction plus solar radius
+    inline constexpr f64 CIVIL_ALTITUDE    = -6.0;
+    inline constexpr f64 NAUTICAL_ALTITUDE = -12.0;
+    inline constexpr f64 ASTRO_ALTITUDE    = -18.0;
+
+    constexpr auto ToJulianDay(const i64 unixSeconds) -> f64 {
+      return (static_cast<f64>(unixSeconds) / SECONDS_PER_DAY) + UNIX_EPOCH_JULIAN_DAY;
+    }
+
+    constexpr auto ToUnixSeconds(const f64 julianDay) -> i64 {
+      const f64 seconds = (julianDay - UNIX_EPOCH_JULIAN_DAY) * SECONDS_PER_DAY;
+      return static_cast<i64>(seconds < 0.0 ? seconds - 0.5 : seconds + 0.5);
+    }
+
+    /**
+     * @brief Hour angle (in days) at which the sun reaches the given altitude
+     * @return None if the sun stays entirely above or below that altitude
+     */
+    constexpr auto HourAngleDays(const f64 altitude, const f64 sinLat, const f64 cosLat, const f64 sinDecl, const f64 cosDecl)
+      -> Option<f64> {
+      const f64 cosOmega = (math::Sin(altitude * math::DEG_TO_RAD) - (sinLat * sinDecl)) / (cosLat * cosDecl);
+      if (cosOmega < -1.0 || cosOmega > 1.0)
+        return None;
+      return math::Acos(cosOmega) * math::RAD_TO_DEG / 360.0;
+    }
+
+    constexpr auto PhaseForElevation(const f64 elevation) -> DayPhase {
+      if (elevation > SUNRISE_ALTITUDE)
+        return DayPhase::Day;
+      if (elevation > CIVIL_ALTITUDE)
+        return DayPhase::CivilTwilight;
+      if (elevation > NAUTICAL_ALTITUDE)
+        return DayPhase::NauticalTwilight;
+      if (elevation > ASTRO_ALTITUDE)
+        return DayPhase::AstronomicalTwilight;
+      return DayPhase::Night;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Compute solar events and the current sun position
+   * @param lat Latitude in degrees (north positive)
+   * @param lon Longitude in degrees (east positive)
+   * @param unixSeconds The instant to evaluate, as a Unix timestamp
+   * @return Events for the local solar day containing the instant
+   */
+  constexpr auto Compute(const f64 lat, const f64 lon, const i64 unixSeconds) -> SolarDay {
+    using namespace detail;
+    using math::Cos, math::Sin, math::DEG_TO_RAD, math::RAD_TO_DEG;
+
+    const f64 julianDay = ToJulianDay(unixSeconds);
+
+    // Whole days since J2000, counted in local mean solar time so that the
+    // events returned belong to the observer's calendar day
+    const f64 dayNumber = math::Floor(julianDay + 0.5 + (lon / 360.0)) - J2000_JULIAN_DAY;
+    const f64 meanNoon  = dayNumber + 0.0009 - (lon / 360.0);
+
+    const f64 meanAnomaly = math::WrapDegrees(357.5291 + (0.98560028 * meanNoon));
+    const f64 anomalyRad  = meanAnomaly * DEG_TO_RAD;
+    const f64 center      = (1.9148 * Sin(anomalyRad)) + (0.0200 * Sin(2.0 * anomalyRad)) + (0.0003 * Sin(3.0 * anomalyRad));
+    const f64 eclipticLon = math::WrapDegrees(meanAnomaly + center + 180.0 + 102.9372) * DEG_TO_RAD;
+
+    const f64 transit = J2000_JULIAN_DAY + meanNoon + (0.0053 * Sin(anomalyRad)) - (0.0069 * Sin(2.0 * eclipticLon));
+
+    const f64 sinDecl = Sin(eclipticLon) * Sin(EARTH_AXIAL_TILT * DEG_TO_RAD);
+    const f64 cosDecl = math::Sqrt(1.0 - (sinDecl * sinDecl));
+    const f64 sinLat  = Sin(lat * DEG_TO_RAD);
+    const f64 cosLat  = Cos(lat * DEG_TO_RAD);
+
+    SolarDay result;
+    result.solarNoon = ToUnixSeconds(transit);
+
+    if (const Option<f64> omega = HourAngleDays(SUNRISE_ALTITUDE, sinLat, cosLat, sinDecl, cosDecl)) {
+      result.sunrise = ToUnixSeconds(transit - *omega);
+      result.sunset  = ToUnixSeconds(transit + *omega);
+    }
+
+    if (const Option<f64> omega = HourAngleDays(CIVIL_ALTITUDE, sinLat, cosLat, sinDecl, cosDecl)) {
+      result.civilDawn = ToUnixSeconds(transit - *omega);
+      result.civilDusk = ToUnixSeconds(transit + *omega);
+    }
+
+    const f64 hourAngle = (julianDay - transit) * 2.0 * math::PI;
+    result.elevation    = math::Asin((sinLat * sinDecl) + (cosLat * cosDecl * Cos(hourAngle))) * RAD_TO_DEG;
+    result.phase        = PhaseForElevation(result.elevation);
+
+    return result;
+  }
+
+  constexpr auto IsDaylight(const DayPhase phase) -> bool {
+    return phase == DayPhase::Day;
+  }
+
+  constexpr auto PhaseName(const DayPhase phase) -> StringView {
+    switch (phase) {
+      case DayPhase::Day:                  return "day";
+      case DayPhase::CivilTwilight:        return "civil_twilight";
+      case DayPhase::NauticalTwilight:     return "nautical_twilight";
+      case DayPhase::AstronomicalTwilight: return "astronomical_twilight";
+      case DayPhase::Night:                return "night";
+    }
+    return "night";
+  }
+
+  namespace reference {
+    /**
+     * @brief Published sunrise/sunset times (UTC, rounded to the minute)
+     */
+    struct Entry {
+      f64         lat;
+      f64         lon;
+      i64         instant;
+      Option<i64> sunrise;
+      Option<i64> sunset;
+    };
+
+    // clang-format off
+    inline constexpr Entry TABLE[] = {
+      // New York, 2024-06-20: 05:25 / 20:31 EDT
+      {  40.7128,  -74.0060, 1718884800, 1718875500, 1718929860 },
+      // London, 2024-03-20: 06:03 / 18:15 GMT
+      {  51.5074,   -0.1278, 1710936000, 1710914580, 1710958500 },
+      // Sydney, 2024-12-21: 05:41 / 20:05 AEDT
+      { -33.8688,  151.2093, 1734739200, 1734720060, 1734771900 },
+      // Tromsø, 2024-12-21: polar night
+      {  69.6492,   18.9553, 1734778800,       None,       None },
+      // Tromsø, 2024-06-21: midnight sun
+      {  69.6492,   18.9553, 1718967600,       None,       None },
+    };
+    // clang-format on
+
+    inline constexpr i64 TOLERANCE_SECONDS = 180;
+
+    constexpr auto Matches(const Option<i64>& computed, const Option<i64>& expected) -> bool {
+      if (computed.has_value() != expected.has_value())
+        return false;
+      if (!computed)
+        return true;
+      const i64 delta = *computed - *expected;
+      return delta <= TOLERANCE_SECONDS && delta >= -TOLERANCE_SECONDS;
+    }
+
+    consteval auto Validate() -> bool {
+      for (const Entry& entry : TABLE) {
+        const SolarDay day = Compute(entry.lat, entry.lon, entry.instant);
+        if (!Matches(day.sunrise, entry.sunrise) || !Matches(day.sunset, entry.sunset))
+          return false;
+      }
+      return true;
+    }
+  } // namespace reference
+
+  static_assert(reference::Validate(), "Solar position engine disagrees with the reference table");
+
+  // The polar entries must resolve to the right side of the horizon
+  static_assert(Compute(69.6492, 18.9553, 1734778800).phase != DayPhase::Day, "Polar night classified as day");
+  static_assert(Compute(69.6492, 18.9553, 1718967600).phase == DayPhase::Day, "Midnight sun classified as night");
+} // namespace weather::solar
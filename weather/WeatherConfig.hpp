@@ -7,6 +7,8 @@
  * @details This header provides type-safe configuration helpers for the weather
  * plugin. The configuration uses:
  * - std::variant for location (either coordinates or city name)
+ * - optional per-provider endpoint overrides (caching mirrors, local stand-ins)
+ * - optional auxiliary datasets fetched alongside the forecast
  * - consteval validation to catch config errors at compile time
  */
 
@@ -35,22 +37,67 @@ namespace weather::config {
     Imperial, // Fahrenheit, mph
   };
 
+  // Endpoint overrides - empty means "use the provider's public API"
+  // Base URLs replace the scheme and host (optionally with a path prefix) of the
+  // public API, e.g. "http://weather-cache.lan:8080" for a site-local mirror.
+  struct Endpoints {
+    std::string_view openMeteo;
+    std::string_view metNo;
+    std::string_view openWeatherMap;
+    std::string_view unixSocket; // Connect through this Unix domain socket instead of TCP
+    std::string_view airQuality; // OpenMeteo air-quality API
+  };
+
   // Weather plugin configuration with type-safe location
   struct Config {
     Provider                            provider = Provider::OpenMeteo;
     Units                               units    = Units::Metric;
     std::variant<Coordinates, CityName> location = Coordinates { 0.0, 0.0 };
     std::optional<std::string_view>     apiKey; // Only needed for OpenWeatherMap
+    Endpoints                           endpoints {};
+    bool                                airQuality    = false; // Fetch air quality and UV index alongside the forecast
+    unsigned int                        airQualityTtl = 3600;  // Cache lifetime of the air-quality dataset, in seconds
   };
 
   // Factory functions to create configs without designated initializers
   // (avoids -Wmissing-designated-field-initializers warning)
   consteval auto MakeConfig(Provider provider, Units units, std::variant<Coordinates, CityName> location) -> Config {
-    return { .provider = provider, .units = units, .location = location, .apiKey = std::nullopt };
+    return { .provider = provider, .units = units, .location = location, .apiKey = std::nullopt, .endpoints = {}, .airQuality = false, .airQualityTtl = 3600 };
   }
 
   consteval auto MakeConfig(Provider provider, Units units, std::variant<Coordinates, CityName> location, std::string_view apiKey) -> Config {
-    return { .provider = provider, .units = units, .location = location, .apiKey = apiKey };
+    return { .provider = provider, .units = units, .location = location, .apiKey = apiKey, .endpoints = {}, .airQuality = false, .airQualityTtl = 3600 };
+  }
+
+  consteval auto MakeEndpoints(
+    std::string_view openMeteo,
+    std::string_view metNo,
+    std::string_view openWeatherMap,
+    std::string_view unixSocket = {},
+    std::string_view airQuality = {}
+  ) -> Endpoints {
+    return { .openMeteo = openMeteo, .metNo = metNo, .openWeatherMap = openWeatherMap, .unixSocket = unixSocket, .airQuality = airQuality };
+  }
+
+  consteval auto WithEndpoints(Config cfg, const Endpoints& endpoints) -> Config {
+    cfg.endpoints = endpoints;
+    return cfg;
+  }
+
+  consteval auto WithAirQuality(Config cfg, unsigned int ttlSeconds = 3600) -> Config {
+    cfg.airQuality    = true;
+    cfg.airQualityTtl = ttlSeconds;
+    return cfg;
+  }
+
+  // An endpoint override must be empty or an http(s) base URL
+  constexpr auto IsValidEndpoint(std::string_view url) -> bool {
+    return url.empty() || url.starts_with("http://") || url.starts_with("https://");
+  }
+
+  // A Unix socket override must be empty or an absolute path
+  constexpr auto IsValidUnixSocket(std::string_view path) -> bool {
+    return path.empty() || path.starts_with('/');
   }
 
   /**
@@ -62,6 +109,8 @@ namespace weather::config {
    * 1. City names (CityName) only work with OpenWeatherMap
    * 2. OpenWeatherMap requires an API key
    * 3. OpenMeteo and MetNo require coordinates
+   * 4. Endpoint overrides must be http(s) URLs and Unix socket paths absolute
+   * 5. The air-quality dataset needs coordinates and a non-zero cache lifetime
    */
   consteval auto Validate(const Config& cfg) -> bool {
     // Rule 1: City name is only valid for OpenWeatherMap
@@ -72,6 +121,19 @@ namespace weather::config {
     if (cfg.provider == Provider::OpenWeatherMap && !cfg.apiKey.has_value())
       return false;
 
+    // Rule 4: Endpoint overrides must be usable by libcurl
+    const Endpoints& endpoints = cfg.endpoints;
+    if (!IsValidEndpoint(endpoints.openMeteo) || !IsValidEndpoint(endpoints.metNo) || !IsValidEndpoint(endpoints.openWeatherMap) ||
+        !IsValidEndpoint(endpoints.airQuality))
+      return false;
+
+    if (!IsValidUnixSocket(endpoints.unixSocket))
+      return false;
+
+    // Rule 5: Air quality is looked up by coordinates
+    if (cfg.airQuality && (!std::holds_alternative<Coordinates>(cfg.location) || cfg.airQualityTtl == 0))
+      return false;
+
     return true;
   }
 } // namespace weather::config
@@ -9,14 +9,32 @@
  * - Met.no (no API key required, coordinates only)
  * - OpenWeatherMap (API key required, supports city names)
  *
+ * Optional auxiliary datasets (air quality and UV index from the OpenMeteo
+ * air-quality API) are fetched concurrently with the forecast, multiplexed
+ * over HTTP/2 where the endpoints share an origin, and cached separately.
+ *
  * Configuration is read from:
  * - Runtime mode: ~/.config/draconis++/plugins/weather.toml
  * - Runtime TOML passed by the host application
  * - Precompiled mode: weather/config.hpp generated into this plugin directory
  *
+ * Sunrise, sunset and day/night state are computed locally from the configured
+ * coordinates (see SolarPosition.hpp), so they cost no extra API requests.
+ *
+ * Each fresh observation is also appended to a memory-mapped ring file in the
+ * plugin cache directory (see ObservationHistory.hpp); temperature trends and
+ * sparklines are derived from it locally.
+ *
+ * Providers also return a short hourly series (temperature, humidity, wind),
+ * from which apparent temperature, dew point, heat index and wind chill are
+ * computed in batch (see ForecastKernels.hpp).
+ *
  * This is a single-file plugin that combines all functionality for static plugin support.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
 #include <curl/curl.h>
 #include <filesystem>
 #include <format>
@@ -31,6 +49,10 @@ namespace fs = std::filesystem;
 // Always include WeatherConfig.hpp for unified enum definitions
 #include "WeatherConfig.hpp"
 
+#include "ForecastKernels.hpp"
+#include "ObservationHistory.hpp"
+#include "SolarPosition.hpp"
+
 #if DRAC_PRECOMPILED_CONFIG
   #include "config.hpp" // Get draconis::config::WEATHER_CONFIG from this plugin directory
 #else
@@ -69,19 +91,68 @@ namespace weather {
     Option<f64>    temperature;
     Option<String> description;
     Option<String> location;
+    Option<i32>    conditionCode; // WMO 4677 weather code, normalized across providers
     UnitSystem     units = UnitSystem::Metric;
+
+    kernels::ForecastColumns forecast; // Upcoming hours in metric units, first entry is the current hour
+  };
+
+  // History and forecast series are stored in metric units regardless of the configured units
+  constexpr auto ToCelsius(const f64 temperature, const UnitSystem units) -> f64 {
+    return units == UnitSystem::Imperial ? (temperature - 32.0) * 5.0 / 9.0 : temperature;
+  }
+
+  constexpr auto FromCelsius(const f64 temperature, const UnitSystem units) -> f64 {
+    return units == UnitSystem::Imperial ? (temperature * 9.0 / 5.0) + 32.0 : temperature;
+  }
+
+  constexpr auto FromCelsiusDelta(const f64 delta, const UnitSystem units) -> f64 {
+    return units == UnitSystem::Imperial ? delta * 9.0 / 5.0 : delta;
+  }
+
+  /**
+   * @brief Auxiliary air-quality dataset (OpenMeteo air-quality API)
+   */
+  struct AirQualityData {
+    Option<f64> europeanAqi;
+    Option<f64> usAqi;
+    Option<f64> pm25;
+    Option<f64> pm10;
+    Option<f64> uvIndex;
+  };
+
+  /**
+   * @brief Where a provider sends its requests
+   */
+  struct Endpoint {
+    String         baseUrl;    // Scheme and host, optionally with a path prefix (no trailing slash)
+    Option<String> unixSocket; // Connect through this Unix domain socket instead of TCP
+  };
+
+  /**
+   * @brief User-supplied endpoint overrides (None = provider's public API)
+   */
+  struct EndpointOverrides {
+    Option<String> openMeteo;
+    Option<String> metNo;
+    Option<String> openWeatherMap;
+    Option<String> airQuality;
+    Option<String> unixSocket;
   };
 
   /**
    * @brief Plugin configuration
    */
   struct WeatherConfig {
-    bool           enabled  = false;
-    Provider       provider = Provider::OpenMeteo;
-    UnitSystem     units    = UnitSystem::Metric;
-    Option<Coords> coords;
-    Option<String> city;
-    Option<String> apiKey;
+    bool              enabled  = false;
+    Provider          provider = Provider::OpenMeteo;
+    UnitSystem        units    = UnitSystem::Metric;
+    Option<Coords>    coords;
+    Option<String>    city;
+    Option<String>    apiKey;
+    EndpointOverrides endpoints;
+    bool              airQuality    = false; // Fetch the air-quality dataset alongside the forecast
+    u32               airQualityTtl = 3600;  // Cache lifetime of the air-quality dataset, in seconds
   };
 } // namespace weather
 
@@ -96,6 +167,21 @@ namespace {
     f64 lon = 0.0;
   };
 
+  // Endpoint overrides table - empty string = use the public API
+  struct TomlEndpoints {
+    String openMeteo;
+    String metNo;
+    String openWeatherMap;
+    String airQuality;
+    String unixSocket;
+  };
+
+  // Auxiliary air-quality dataset table
+  struct TomlAirQuality {
+    bool enabled = false;
+    u32  ttl     = 0; // 0 = not provided (defaults to 3600)
+  };
+
   // Weather config with separate fields for city name and coordinates
   // In TOML, user can specify either:
   //   location = "New York"           (city name string)
@@ -103,11 +189,13 @@ namespace {
   //   coords = { lat = 40.7, lon = -74.0 }  (coordinates table)
   struct TomlWeatherConfig {
     bool               enabled = false;
-    String             provider; // Empty = not provided (defaults to "openmeteo")
-    String             units;    // Empty = not provided (defaults to "metric")
-    String             location; // City name string - empty = not provided
-    TomlLocationCoords coords;   // Coordinates table - 0,0 = not provided
-    String             apiKey;   // Empty = not provided
+    String             provider;   // Empty = not provided (defaults to "openmeteo")
+    String             units;      // Empty = not provided (defaults to "metric")
+    String             location;   // City name string - empty = not provided
+    TomlLocationCoords coords;     // Coordinates table - 0,0 = not provided
+    String             apiKey;     // Empty = not provided
+    TomlEndpoints      endpoints;  // Endpoints table - empty fields = not provided
+    TomlAirQuality     airQuality; // Air-quality table - disabled by default
   };
 
   // Wrapper for parsing [plugins.weather] from main config file
@@ -133,6 +221,29 @@ struct glz::meta<TomlLocationCoords> {
   static constexpr auto value = object("lat", &T::lat, "lon", &T::lon);
 };
 
+template <>
+struct glz::meta<TomlEndpoints> {
+  using T                     = TomlEndpoints;
+  static constexpr auto value = object(
+    "openmeteo",
+    &T::openMeteo,
+    "metno",
+    &T::metNo,
+    "openweathermap",
+    &T::openWeatherMap,
+    "air_quality",
+    &T::airQuality,
+    "unix_socket",
+    &T::unixSocket
+  );
+};
+
+template <>
+struct glz::meta<TomlAirQuality> {
+  using T                     = TomlAirQuality;
+  static constexpr auto value = object("enabled", &T::enabled, "ttl", &T::ttl);
+};
+
 template <>
 struct glz::meta<TomlWeatherConfig> {
   using T                     = TomlWeatherConfig;
@@ -148,7 +259,11 @@ struct glz::meta<TomlWeatherConfig> {
     "coords",
     &T::coords,
     "api_key",
-    &T::apiKey
+    &T::apiKey,
+    "endpoints",
+    &T::endpoints,
+    "air_quality",
+    &T::airQuality
   );
 };
 
@@ -173,7 +288,9 @@ struct glz::meta<TomlMainConfig> {
 namespace weather::dto {
   namespace metno {
     struct Details {
-      f64 airTemperature;
+      f64         airTemperature;
+      Option<f64> relativeHumidity;
+      Option<f64> windSpeed;
     };
 
     struct Next1hSummary {
@@ -214,20 +331,46 @@ namespace weather::dto {
         i32    weathercode;
         String time;
       } currentWeather;
+
+      struct Hourly {
+        Vec<String> time;
+        Vec<f64>    temperature;
+        Vec<f64>    relativeHumidity;
+        Vec<f64>    windSpeed;
+      };
+
+      Option<Hourly> hourly;
+    };
+
+    struct AirQualityResponse {
+      struct Current {
+        Option<f64> europeanAqi;
+        Option<f64> usAqi;
+        Option<f64> pm25;
+        Option<f64> pm10;
+        Option<f64> uvIndex;
+      } current;
     };
   } // namespace openmeteo
 
   namespace owm {
     struct OWMResponse {
       struct Main {
-        f64 temp;
+        f64         temp;
+        Option<f64> humidity;
+      };
+
+      struct Wind {
+        Option<f64> speed;
       };
 
       struct Weather {
+        i32    id = 0;
         String description;
       };
 
       Main           main;
+      Option<Wind>   wind;
       Vec<Weather>   weather;
       String         name;
       i64            dt;
@@ -248,8 +391,44 @@ namespace glz {
       &T::description,
       "location",
       &T::location,
+      "conditionCode",
+      &T::conditionCode,
       "units",
-      &T::units
+      &T::units,
+      "forecast",
+      &T::forecast
+    );
+  };
+
+  template <>
+  struct meta<weather::kernels::ForecastColumns> {
+    using T                     = weather::kernels::ForecastColumns;
+    static constexpr auto value = object(
+      "time",
+      &T::time,
+      "temperature",
+      &T::temperature,
+      "relativeHumidity",
+      &T::relativeHumidity,
+      "windSpeed",
+      &T::windSpeed
+    );
+  };
+
+  template <>
+  struct meta<weather::AirQualityData> {
+    using T                     = weather::AirQualityData;
+    static constexpr auto value = object(
+      "europeanAqi",
+      &T::europeanAqi,
+      "usAqi",
+      &T::usAqi,
+      "pm25",
+      &T::pm25,
+      "pm10",
+      &T::pm10,
+      "uvIndex",
+      &T::uvIndex
     );
   };
 
@@ -261,7 +440,14 @@ namespace glz {
 
   template <>
   struct meta<weather::dto::metno::Details> {
-    static constexpr auto value = object("air_temperature", &weather::dto::metno::Details::airTemperature);
+    static constexpr auto value = object(
+      "air_temperature",
+      &weather::dto::metno::Details::airTemperature,
+      "relative_humidity",
+      &weather::dto::metno::Details::relativeHumidity,
+      "wind_speed",
+      &weather::dto::metno::Details::windSpeed
+    );
   };
 
   template <>
@@ -321,19 +507,76 @@ namespace glz {
     );
   };
 
+  template <>
+  struct meta<weather::dto::openmeteo::Response::Hourly> {
+    using T                     = weather::dto::openmeteo::Response::Hourly;
+    static constexpr auto value = object(
+      "time",
+      &T::time,
+      "temperature_2m",
+      &T::temperature,
+      "relative_humidity_2m",
+      &T::relativeHumidity,
+      "wind_speed_10m",
+      &T::windSpeed
+    );
+  };
+
   template <>
   struct meta<weather::dto::openmeteo::Response> {
-    static constexpr auto value = object("current_weather", &weather::dto::openmeteo::Response::currentWeather);
+    static constexpr auto value = object(
+      "current_weather",
+      &weather::dto::openmeteo::Response::currentWeather,
+      "hourly",
+      &weather::dto::openmeteo::Response::hourly
+    );
+  };
+
+  template <>
+  struct meta<weather::dto::openmeteo::AirQualityResponse::Current> {
+    using T                     = weather::dto::openmeteo::AirQualityResponse::Current;
+    static constexpr auto value = object(
+      "european_aqi",
+      &T::europeanAqi,
+      "us_aqi",
+      &T::usAqi,
+      "pm2_5",
+      &T::pm25,
+      "pm10",
+      &T::pm10,
+      "uv_index",
+      &T::uvIndex
+    );
+  };
+
+  template <>
+  struct meta<weather::dto::openmeteo::AirQualityResponse> {
+    static constexpr auto value = object("current", &weather::dto::openmeteo::AirQualityResponse::current);
   };
 
   template <>
   struct meta<weather::dto::owm::OWMResponse::Main> {
-    static constexpr auto value = object("temp", &weather::dto::owm::OWMResponse::Main::temp);
+    static constexpr auto value = object(
+      "temp",
+      &weather::dto::owm::OWMResponse::Main::temp,
+      "humidity",
+      &weather::dto::owm::OWMResponse::Main::humidity
+    );
+  };
+
+  template <>
+  struct meta<weather::dto::owm::OWMResponse::Wind> {
+    static constexpr auto value = object("speed", &weather::dto::owm::OWMResponse::Wind::speed);
   };
 
   template <>
   struct meta<weather::dto::owm::OWMResponse::Weather> {
-    static constexpr auto value = object("description", &weather::dto::owm::OWMResponse::Weather::description);
+    static constexpr auto value = object(
+      "id",
+      &weather::dto::owm::OWMResponse::Weather::id,
+      "description",
+      &weather::dto::owm::OWMResponse::Weather::description
+    );
   };
 
   template <>
@@ -341,6 +584,8 @@ namespace glz {
     static constexpr auto value = object(
       "main",
       &weather::dto::owm::OWMResponse::main,
+      "wind",
+      &weather::dto::owm::OWMResponse::wind,
       "weather",
       &weather::dto::owm::OWMResponse::weather,
       "name",
@@ -362,6 +607,8 @@ namespace weather::curl {
     Option<i64>    timeoutSecs        = None;
     Option<i64>    connectTimeoutSecs = None;
     Option<String> userAgent          = None;
+    Option<String> unixSocketPath     = None;
+    bool           multiplex          = false; // Prefer HTTP/2 and wait to share an existing connection
   };
 
   class Easy {
@@ -415,6 +662,18 @@ namespace weather::curl {
           m_initError = res.error();
           return;
         }
+
+      if (options.unixSocketPath)
+        if (Result<> res = setUnixSocketPath(*options.unixSocketPath); !res) {
+          m_initError = res.error();
+          return;
+        }
+
+      if (options.multiplex)
+        if (Result<> res = setMultiplex(); !res) {
+          m_initError = res.error();
+          return;
+        }
     }
 
     ~Easy() {
@@ -501,6 +760,90 @@ namespace weather::curl {
     auto setUserAgent(const String& userAgent) -> Result<> {
       return setOpt(CURLOPT_USERAGENT, userAgent.c_str());
     }
+    auto setUnixSocketPath(const String& socketPath) -> Result<> {
+      return setOpt(CURLOPT_UNIX_SOCKET_PATH, socketPath.c_str());
+    }
+    auto setMultiplex() -> Result<> {
+      if (Result<> res = setOpt(CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS)); !res)
+        return res;
+      return setOpt(CURLOPT_PIPEWAIT, 1L);
+    }
+  };
+
+  /**
+   * @brief RAII wrapper for a cURL multi handle
+   *
+   * Transfers run concurrently; requests to the same origin are multiplexed
+   * over a single HTTP/2 connection when the easy handles opt in.
+   */
+  class Multi {
+    CURLM* m_multi = nullptr;
+
+   public:
+    Multi() : m_multi(curl_multi_init()) {
+      if (m_multi)
+        curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    }
+
+    ~Multi() {
+      if (m_multi)
+        curl_multi_cleanup(m_multi);
+    }
+
+    Multi(const Multi&)                    = delete;
+    auto operator=(const Multi&) -> Multi& = delete;
+    Multi(Multi&&)                         = delete;
+    auto operator=(Multi&&) -> Multi&      = delete;
+
+    [[nodiscard]] explicit operator bool() const {
+      return m_multi != nullptr;
+    }
+
+    /**
+     * @brief Run all transfers to completion
+     * @param handles Initialized easy handles; they stay owned by the caller
+     * @return One result per handle, in the same order
+     */
+    auto performAll(Span<Easy* const> handles) -> Vec<Result<>> {
+      Vec<Result<>> results(handles.size(), Err(DracError(ApiUnavailable, "Transfer did not complete")));
+
+      if (!m_multi) {
+        for (Result<>& result : results)
+          result = Err(DracError(ApiUnavailable, "curl_multi_init() failed"));
+        return results;
+      }
+
+      for (usize index = 0; index < handles.size(); ++index)
+        if (const CURLMcode res = curl_multi_add_handle(m_multi, handles[index]->get()); res != CURLM_OK)
+          results[index] = Err(DracError(PlatformSpecific, std::format("curl_multi_add_handle failed: {}", curl_multi_strerror(res))));
+
+      i32 running = 0;
+      do {
+        if (const CURLMcode res = curl_multi_perform(m_multi, &running); res != CURLM_OK)
+          break;
+        if (running > 0)
+          curl_multi_poll(m_multi, nullptr, 0, 1000, nullptr);
+      } while (running > 0);
+
+      i32 queued = 0;
+      while (const CURLMsg* msg = curl_multi_info_read(m_multi, &queued)) {
+        if (msg->msg != CURLMSG_DONE)
+          continue;
+
+        for (usize index = 0; index < handles.size(); ++index)
+          if (handles[index]->get() == msg->easy_handle) {
+            if (msg->data.result == CURLE_OK)
+              results[index] = {};
+            else
+              results[index] = Err(DracError(ApiUnavailable, std::format("curl transfer failed: {}", curl_easy_strerror(msg->data.result))));
+          }
+      }
+
+      for (Easy* handle : handles)
+        curl_multi_remove_handle(m_multi, handle->get());
+
+      return results;
+    }
   };
 } // namespace weather::curl
 
@@ -509,8 +852,87 @@ namespace weather::curl {
 // ============================================================================
 
 namespace weather::providers {
+  // Public API base URLs, used when no endpoint override is configured
+  inline constexpr StringView METNO_BASE_URL          = "https://api.met.no";
+  inline constexpr StringView OPENMETEO_BASE_URL      = "https://api.open-meteo.com";
+  inline constexpr StringView OPENWEATHERMAP_BASE_URL = "https://api.openweathermap.org";
+  inline constexpr StringView AIR_QUALITY_BASE_URL    = "https://air-quality-api.open-meteo.com";
+
+  /**
+   * @brief A single GET request against a provider endpoint
+   */
+  struct Request {
+    Endpoint       endpoint;
+    String         pathAndQuery; // Request path (starting with '/') and query string
+    Option<String> userAgent;
+  };
+
+  namespace {
+    auto MakeHandle(const Request& request, String* responseBuffer) -> Result<curl::Easy> {
+      curl::Easy curlHandle({
+        .url                = request.endpoint.baseUrl + request.pathAndQuery,
+        .writeBuffer        = responseBuffer,
+        .timeoutSecs        = 10L,
+        .connectTimeoutSecs = 5L,
+        .userAgent          = request.userAgent,
+        .unixSocketPath     = request.endpoint.unixSocket,
+        .multiplex          = true,
+      });
+
+      if (!curlHandle) {
+        if (const auto& initError = curlHandle.getInitializationError())
+          ERR_FROM(*initError);
+        ERR(ApiUnavailable, "Failed to initialize cURL");
+      }
+
+      return curlHandle;
+    }
+
+    /**
+     * @brief Perform several GET requests concurrently
+     * @details Requests sharing an origin are multiplexed over one HTTP/2
+     * connection, so the whole batch completes in about one round trip.
+     * @return One response body (or error) per request, in the same order
+     */
+    auto HttpGetAll(Span<const Request> requests) -> Vec<Result<String>> {
+      Vec<String>             buffers(requests.size());
+      Vec<Result<curl::Easy>> handles;
+      Vec<curl::Easy*>        active;
+      handles.reserve(requests.size());
+
+      for (usize index = 0; index < requests.size(); ++index) {
+        handles.push_back(MakeHandle(requests[index], &buffers[index]));
+        if (handles.back())
+          active.push_back(&*handles.back());
+      }
+
+      curl::Multi   multi;
+      Vec<Result<>> transferResults = multi.performAll(active);
+
+      Vec<Result<String>> results;
+      results.reserve(requests.size());
+
+      for (usize index = 0, activeIndex = 0; index < requests.size(); ++index) {
+        if (!handles[index]) {
+          results.emplace_back(Err(handles[index].error()));
+          continue;
+        }
+
+        if (Result<>& transfer = transferResults[activeIndex++]; !transfer)
+          results.emplace_back(Err(transfer.error()));
+        else
+          results.emplace_back(std::move(buffers[index]));
+      }
+
+      return results;
+    }
+  } // namespace
+
   /**
    * @brief Interface for weather providers
+   *
+   * Providers only describe their request and parse the response, so the
+   * plugin can run them alongside auxiliary datasets in one batch.
    */
   class IWeatherProvider {
    public:
@@ -521,10 +943,48 @@ namespace weather::providers {
     IWeatherProvider(IWeatherProvider&&)                         = default;
     auto operator=(IWeatherProvider&&) -> IWeatherProvider&      = default;
 
-    virtual auto fetch() -> Result<WeatherData> = 0;
+    virtual auto buildRequest() -> Result<Request>                        = 0;
+    virtual auto parseResponse(const String& body) -> Result<WeatherData> = 0;
   };
 
   namespace {
+    // Forecast series are limited to the next day; that is all the derived fields look at
+    constexpr usize FORECAST_HOURS = 24;
+
+    /**
+     * @brief Parse the "YYYY-MM-DDTHH:MM" prefix of an ISO 8601 UTC timestamp
+     */
+    auto ParseIsoTimestamp(StringView text) -> Option<i64> {
+      if (text.size() < 16 || text[4] != '-' || text[7] != '-' || text[10] != 'T' || text[13] != ':')
+        return None;
+
+      const auto number = [&](const usize offset, const usize length) -> Option<i32> {
+        i32 value = 0;
+        for (usize index = offset; index < offset + length; ++index) {
+          if (text[index] < '0' || text[index] > '9')
+            return None;
+          value = (value * 10) + (text[index] - '0');
+        }
+        return value;
+      };
+
+      const Option<i32> year   = number(0, 4);
+      const Option<i32> month  = number(5, 2);
+      const Option<i32> day    = number(8, 2);
+      const Option<i32> hour   = number(11, 2);
+      const Option<i32> minute = number(14, 2);
+      if (!year || !month || !day || !hour || !minute)
+        return None;
+
+      const std::chrono::year_month_day date {
+        std::chrono::year(*year), std::chrono::month(static_cast<u32>(*month)), std::chrono::day(static_cast<u32>(*day))
+      };
+      if (!date.ok())
+        return None;
+
+      return (static_cast<i64>(std::chrono::sys_days(date).time_since_epoch().count()) * 86400) + (*hour * 3600) + (*minute * 60);
+    }
+
     auto GetMetnoSymbolDescriptions() -> const std::unordered_map<StringView, StringView>& {
       static const std::unordered_map<StringView, StringView> MAP = {
         {             "clearsky",               "clear sky" },
@@ -563,6 +1023,8 @@ namespace weather::providers {
       return MAP;
     }
 
+    // The _day/_night/_polartwilight variants only differ in their icon; day/night
+    // state is derived locally from the solar position instead (see SolarPosition.hpp)
     auto StripTimeOfDayFromSymbol(StringView symbol) -> String {
       static constexpr Array<StringView, 3> SUFFIXES = { "_day", "_night", "_polartwilight" };
       for (const StringView& suffix : SUFFIXES)
@@ -571,34 +1033,55 @@ namespace weather::providers {
       return String(symbol);
     }
 
+    /**
+     * @brief Map a (stripped) Met.no symbol code onto the WMO 4677 code OpenMeteo reports
+     */
+    auto MetnoSymbolToWmoCode(StringView symbol) -> Option<i32> {
+      if (symbol == "clearsky")
+        return 0;
+      if (symbol == "fair")
+        return 1;
+      if (symbol == "partlycloudy")
+        return 2;
+      if (symbol == "cloudy")
+        return 3;
+      if (symbol == "fog")
+        return 45;
+      if (symbol.contains("thunder"))
+        return 95;
+
+      const i32 intensity = symbol.starts_with("light") ? 0 : symbol.starts_with("heavy") ? 2 : 1;
+      const bool showers  = symbol.ends_with("showers");
+
+      if (symbol.contains("snow"))
+        return showers ? (intensity == 2 ? 86 : 85) : 71 + (intensity * 2);
+      if (symbol.contains("sleet"))
+        return intensity == 0 ? 66 : 67;
+      if (symbol.contains("rain"))
+        return showers ? 80 + intensity : 61 + (intensity * 2);
+
+      return None;
+    }
+
     class MetNoProvider : public IWeatherProvider {
       f64        m_lat;
       f64        m_lon;
       UnitSystem m_units;
+      Endpoint   m_endpoint;
 
      public:
-      MetNoProvider(f64 lat, f64 lon, UnitSystem units)
-        : m_lat(lat), m_lon(lon), m_units(units) {}
-
-      auto fetch() -> Result<WeatherData> override {
-        String responseBuffer;
-
-        curl::Easy curlHandle({
-          .url                = std::format("https://api.met.no/weatherapi/locationforecast/2.0/compact?lat={:.4f}&lon={:.4f}", m_lat, m_lon),
-          .writeBuffer        = &responseBuffer,
-          .timeoutSecs        = 10L,
-          .connectTimeoutSecs = 5L,
-          .userAgent          = String("draconisplusplus-weather-plugin/1.0"),
-        });
-
-        if (!curlHandle) {
-          if (const auto& initError = curlHandle.getInitializationError())
-            ERR_FROM(*initError);
-          ERR(ApiUnavailable, "Failed to initialize cURL");
-        }
-
-        TRY_VOID(curlHandle.perform());
+      MetNoProvider(f64 lat, f64 lon, UnitSystem units, Endpoint endpoint)
+        : m_lat(lat), m_lon(lon), m_units(units), m_endpoint(std::move(endpoint)) {}
+
+      auto buildRequest() -> Result<Request> override {
+        return Request {
+          .endpoint     = m_endpoint,
+          .pathAndQuery = std::format("/weatherapi/locationforecast/2.0/compact?lat={:.4f}&lon={:.4f}", m_lat, m_lon),
+          .userAgent    = String("draconisplusplus-weather-plugin/1.0"),
+        };
+      }
 
+      auto parseResponse(const String& responseBuffer) -> Result<WeatherData> override {
         dto::metno::Response apiResp {};
         if (auto errc = glz::read<glz::opts { .error_on_unknown_keys = false }>(apiResp, responseBuffer); errc.ec != glz::error_code::none)
           ERR_FMT(ParseError, "Failed to parse Met.no response: {}", glz::format_error(errc, responseBuffer.data()));
@@ -612,20 +1095,40 @@ namespace weather::providers {
         if (m_units == UnitSystem::Imperial)
           temp = (temp * 9.0 / 5.0) + 32.0;
 
-        String description;
+        String      description;
+        Option<i32> conditionCode;
         if (data.next1Hours) {
           String strippedSymbol = StripTimeOfDayFromSymbol(data.next1Hours->summary.symbolCode);
+          conditionCode         = MetnoSymbolToWmoCode(strippedSymbol);
           if (auto iter = GetMetnoSymbolDescriptions().find(strippedSymbol); iter != GetMetnoSymbolDescriptions().end())
             description = String(iter->second);
           else
             description = strippedSymbol;
         }
 
+        kernels::ForecastColumns forecast;
+        for (const auto& [entryTime, entryData] : apiResp.properties.timeseries) {
+          if (forecast.time.size() >= FORECAST_HOURS)
+            break;
+
+          const dto::metno::Details& details   = entryData.instant.details;
+          const Option<i64>          timestamp = ParseIsoTimestamp(entryTime);
+          if (!timestamp || !details.relativeHumidity || !details.windSpeed)
+            continue;
+
+          forecast.time.push_back(*timestamp);
+          forecast.temperature.push_back(details.airTemperature);
+          forecast.relativeHumidity.push_back(*details.relativeHumidity);
+          forecast.windSpeed.push_back(*details.windSpeed);
+        }
+
         return WeatherData {
-          .temperature = temp,
-          .description = description.empty() ? None : Some(description),
-          .location    = None,
-          .units       = m_units,
+          .temperature   = temp,
+          .description   = description.empty() ? None : Some(description),
+          .location      = None,
+          .conditionCode = conditionCode,
+          .units         = m_units,
+          .forecast      = std::move(forecast),
         };
       }
     };
@@ -670,69 +1173,88 @@ namespace weather::providers {
       f64        m_lat;
       f64        m_lon;
       UnitSystem m_units;
+      Endpoint   m_endpoint;
 
      public:
-      OpenMeteoProvider(f64 lat, f64 lon, UnitSystem units)
-        : m_lat(lat), m_lon(lon), m_units(units) {}
-
-      auto fetch() -> Result<WeatherData> override {
-        String url = std::format(
-          "https://api.open-meteo.com/v1/forecast?latitude={:.4f}&longitude={:.4f}&current_weather=true&temperature_unit={}",
-          m_lat,
-          m_lon,
-          m_units == UnitSystem::Imperial ? "fahrenheit" : "celsius"
-        );
-
-        String responseBuffer;
-
-        curl::Easy curlHandle({
-          .url                = url,
-          .writeBuffer        = &responseBuffer,
-          .timeoutSecs        = 10L,
-          .connectTimeoutSecs = 5L,
-        });
-
-        if (!curlHandle) {
-          if (const auto& initError = curlHandle.getInitializationError())
-            ERR_FROM(*initError);
-          ERR(ApiUnavailable, "Failed to initialize cURL");
-        }
-
-        TRY_VOID(curlHandle.perform());
+      OpenMeteoProvider(f64 lat, f64 lon, UnitSystem units, Endpoint endpoint)
+        : m_lat(lat), m_lon(lon), m_units(units), m_endpoint(std::move(endpoint)) {}
+
+      auto buildRequest() -> Result<Request> override {
+        return Request {
+          .endpoint     = m_endpoint,
+          .pathAndQuery = std::format(
+            "/v1/forecast?latitude={:.4f}&longitude={:.4f}&current_weather=true&temperature_unit={}"
+            "&hourly=temperature_2m,relative_humidity_2m,wind_speed_10m&wind_speed_unit=ms&forecast_hours={}",
+            m_lat,
+            m_lon,
+            m_units == UnitSystem::Imperial ? "fahrenheit" : "celsius",
+            FORECAST_HOURS
+          ),
+          .userAgent = None,
+        };
+      }
 
+      auto parseResponse(const String& responseBuffer) -> Result<WeatherData> override {
         dto::openmeteo::Response apiResp {};
         if (auto errc = glz::read<glz::opts { .error_on_unknown_keys = false }>(apiResp, responseBuffer.data()); errc.ec != glz::error_code::none)
           ERR_FMT(ParseError, "Failed to parse OpenMeteo response: {}", glz::format_error(errc, responseBuffer.data()));
 
+        kernels::ForecastColumns forecast;
+        if (const auto& hourly = apiResp.hourly) {
+          const usize count = std::min({ hourly->time.size(), hourly->temperature.size(), hourly->relativeHumidity.size(), hourly->windSpeed.size() });
+
+          for (usize index = 0; index < count; ++index) {
+            const Option<i64> timestamp = ParseIsoTimestamp(hourly->time[index]);
+            if (!timestamp)
+              continue;
+
+            forecast.time.push_back(*timestamp);
+            forecast.temperature.push_back(ToCelsius(hourly->temperature[index], m_units));
+            forecast.relativeHumidity.push_back(hourly->relativeHumidity[index]);
+            forecast.windSpeed.push_back(hourly->windSpeed[index]);
+          }
+        }
+
         return WeatherData {
-          .temperature = apiResp.currentWeather.temperature,
-          .description = Some(GetOpenmeteoWeatherDescription(apiResp.currentWeather.weathercode)),
-          .location    = None,
-          .units       = m_units,
+          .temperature   = apiResp.currentWeather.temperature,
+          .description   = Some(GetOpenmeteoWeatherDescription(apiResp.currentWeather.weathercode)),
+          .location      = None,
+          .conditionCode = apiResp.currentWeather.weathercode,
+          .units         = m_units,
+          .forecast      = std::move(forecast),
         };
       }
     };
   } // namespace
 
   namespace {
-    auto MakeOWMApiRequest(const String& url) -> Result<WeatherData> {
-      String responseBuffer;
-
-      curl::Easy curlHandle({
-        .url                = url,
-        .writeBuffer        = &responseBuffer,
-        .timeoutSecs        = 10L,
-        .connectTimeoutSecs = 5L,
-      });
-
-      if (!curlHandle) {
-        if (const auto& initError = curlHandle.getInitializationError())
-          ERR_FROM(*initError);
-        ERR(ApiUnavailable, "Failed to initialize cURL");
+    /**
+     * @brief Map an OpenWeatherMap condition id onto the nearest WMO 4677 code
+     * @see https://openweathermap.org/weather-conditions
+     */
+    auto OWMConditionToWmoCode(const i32 id) -> Option<i32> {
+      switch (id / 100) {
+        case 2: return 95;                                             // Thunderstorm
+        case 3: return id >= 310 ? 55 : 51 + ((id % 100) * 2);         // Drizzle
+        case 5:                                                        // Rain
+          if (id == 511)
+            return 66;
+          if (id >= 520)
+            return 80 + std::min(id - 520, 2);
+          return 61 + (std::min(id - 500, 2) * 2);
+        case 6:                                                        // Snow
+          if (id >= 611 && id <= 616)
+            return 67;
+          if (id >= 620)
+            return id == 622 ? 86 : 85;
+          return 71 + (std::min(id - 600, 2) * 2);
+        case 7: return 45;                                             // Atmosphere (mist, fog, haze...)
+        case 8: return id == 800 ? 0 : std::min(id - 800, 3);          // Clear / clouds
+        default: return None;
       }
+    }
 
-      TRY_VOID(curlHandle.perform());
-
+    auto ParseOWMResponse(const String& responseBuffer) -> Result<WeatherData> {
       dto::owm::OWMResponse owmResponse;
       if (auto errc = glz::read<glz::opts { .error_on_unknown_keys = false }>(owmResponse, responseBuffer); errc.ec != glz::error_code::none)
         ERR_FMT(ParseError, "Failed to parse OpenWeatherMap response: {}", glz::format_error(errc, responseBuffer.data()));
@@ -752,11 +1274,21 @@ namespace weather::providers {
         );
       }
 
+      kernels::ForecastColumns forecast;
+      if (owmResponse.main.humidity && owmResponse.wind && owmResponse.wind->speed) {
+        forecast.time             = { owmResponse.dt };
+        forecast.temperature      = { owmResponse.main.temp };
+        forecast.relativeHumidity = { *owmResponse.main.humidity };
+        forecast.windSpeed        = { *owmResponse.wind->speed };
+      }
+
       return WeatherData {
-        .temperature = owmResponse.main.temp,
-        .description = !owmResponse.weather.empty() ? Some(owmResponse.weather[0].description) : None,
-        .location    = owmResponse.name.empty() ? None : Some(owmResponse.name),
-        .units       = UnitSystem::Metric, // Will be set by caller
+        .temperature   = owmResponse.main.temp,
+        .description   = !owmResponse.weather.empty() ? Some(owmResponse.weather[0].description) : None,
+        .location      = owmResponse.name.empty() ? None : Some(owmResponse.name),
+        .conditionCode = !owmResponse.weather.empty() ? OWMConditionToWmoCode(owmResponse.weather[0].id) : None,
+        .units         = UnitSystem::Metric, // Will be set by caller
+        .forecast      = forecast,
       };
     }
 
@@ -765,73 +1297,194 @@ namespace weather::providers {
       Option<String> m_city;
       String         m_apiKey;
       UnitSystem     m_units;
+      Endpoint       m_endpoint;
 
      public:
-      OpenWeatherMapProvider(const Option<Coords>& coords, const Option<String>& city, String apiKey, UnitSystem units)
-        : m_coords(coords), m_city(city), m_apiKey(std::move(apiKey)), m_units(units) {}
+      OpenWeatherMapProvider(const Option<Coords>& coords, const Option<String>& city, String apiKey, UnitSystem units, Endpoint endpoint)
+        : m_coords(coords), m_city(city), m_apiKey(std::move(apiKey)), m_units(units), m_endpoint(std::move(endpoint)) {}
 
-      auto fetch() -> Result<WeatherData> override {
+      auto buildRequest() -> Result<Request> override {
         String unitsParam = m_units == UnitSystem::Imperial ? "imperial" : "metric";
 
         if (m_city) {
           String escapedCity = TRY(curl::Easy::escape(*m_city));
-          String apiUrl      = std::format(
-            "https://api.openweathermap.org/data/2.5/weather?q={}&appid={}&units={}",
+          String apiPath     = std::format(
+            "/data/2.5/weather?q={}&appid={}&units={}",
             escapedCity,
             m_apiKey,
             unitsParam
           );
-          auto result  = TRY(MakeOWMApiRequest(apiUrl));
-          result.units = m_units;
-          return result;
+          return Request { .endpoint = m_endpoint, .pathAndQuery = std::move(apiPath), .userAgent = None };
         }
 
         if (m_coords) {
-          String apiUrl = std::format(
-            "https://api.openweathermap.org/data/2.5/weather?lat={:.3f}&lon={:.3f}&appid={}&units={}",
+          String apiPath = std::format(
+            "/data/2.5/weather?lat={:.3f}&lon={:.3f}&appid={}&units={}",
             m_coords->lat,
             m_coords->lon,
             m_apiKey,
             unitsParam
           );
-          auto result  = TRY(MakeOWMApiRequest(apiUrl));
-          result.units = m_units;
-          return result;
+          return Request { .endpoint = m_endpoint, .pathAndQuery = std::move(apiPath), .userAgent = None };
         }
 
         ERR(InvalidArgument, "No location (city or coordinates) provided for OpenWeatherMap");
       }
+
+      auto parseResponse(const String& responseBuffer) -> Result<WeatherData> override {
+        auto result  = TRY(ParseOWMResponse(responseBuffer));
+        result.units = m_units;
+
+        // The current-weather endpoint has no forecast, so the series is the current observation
+        // only; it is reported in the requested units and normalized to metric here
+        kernels::ForecastColumns& forecast = result.forecast;
+        if (!forecast.temperature.empty()) {
+          forecast.temperature.front() = ToCelsius(forecast.temperature.front(), m_units);
+          if (m_units == UnitSystem::Imperial)
+            forecast.windSpeed.front() *= 0.44704; // mph -> m/s
+        }
+
+        return result;
+      }
     };
   } // namespace
 
   namespace {
-    auto CreateMetNoProvider(f64 lat, f64 lon, UnitSystem units) -> UniquePointer<IWeatherProvider> {
-      return std::make_unique<MetNoProvider>(lat, lon, units);
+    /**
+     * @brief Auxiliary air-quality and UV dataset from the OpenMeteo air-quality API
+     */
+    class AirQualityProvider {
+      f64      m_lat;
+      f64      m_lon;
+      Endpoint m_endpoint;
+
+     public:
+      AirQualityProvider(f64 lat, f64 lon, Endpoint endpoint)
+        : m_lat(lat), m_lon(lon), m_endpoint(std::move(endpoint)) {}
+
+      [[nodiscard]] auto buildRequest() const -> Request {
+        return Request {
+          .endpoint     = m_endpoint,
+          .pathAndQuery = std::format(
+            "/v1/air-quality?latitude={:.4f}&longitude={:.4f}&current=european_aqi,us_aqi,pm2_5,pm10,uv_index",
+            m_lat,
+            m_lon
+          ),
+          .userAgent = None,
+        };
+      }
+
+      static auto parseResponse(const String& responseBuffer) -> Result<AirQualityData> {
+        dto::openmeteo::AirQualityResponse apiResp {};
+        if (auto errc = glz::read<glz::opts { .error_on_unknown_keys = false }>(apiResp, responseBuffer); errc.ec != glz::error_code::none)
+          ERR_FMT(ParseError, "Failed to parse OpenMeteo air-quality response: {}", glz::format_error(errc, responseBuffer.data()));
+
+        return AirQualityData {
+          .europeanAqi = apiResp.current.europeanAqi,
+          .usAqi       = apiResp.current.usAqi,
+          .pm25        = apiResp.current.pm25,
+          .pm10        = apiResp.current.pm10,
+          .uvIndex     = apiResp.current.uvIndex,
+        };
+      }
+    };
+  } // namespace
+
+  namespace {
+    auto CreateMetNoProvider(f64 lat, f64 lon, UnitSystem units, Endpoint endpoint) -> UniquePointer<IWeatherProvider> {
+      return std::make_unique<MetNoProvider>(lat, lon, units, std::move(endpoint));
     }
 
-    auto CreateOpenMeteoProvider(f64 lat, f64 lon, UnitSystem units) -> UniquePointer<IWeatherProvider> {
-      return std::make_unique<OpenMeteoProvider>(lat, lon, units);
+    auto CreateOpenMeteoProvider(f64 lat, f64 lon, UnitSystem units, Endpoint endpoint) -> UniquePointer<IWeatherProvider> {
+      return std::make_unique<OpenMeteoProvider>(lat, lon, units, std::move(endpoint));
     }
 
     auto CreateOpenWeatherMapProvider(
       const Option<Coords>& coords,
       const Option<String>& city,
       const String&         apiKey,
-      UnitSystem            units
+      UnitSystem            units,
+      Endpoint              endpoint
     ) -> UniquePointer<IWeatherProvider> {
-      return std::make_unique<OpenWeatherMapProvider>(coords, city, apiKey, units);
+      return std::make_unique<OpenWeatherMapProvider>(coords, city, apiKey, units, std::move(endpoint));
     }
   } // namespace
 } // namespace weather::providers
 
 namespace {
+  /**
+   * @brief Format a Unix timestamp as local wall-clock time ("HH:MM")
+   */
+  auto FormatLocalTime(const i64 unixSeconds) -> Option<String> {
+    const auto timeValue = static_cast<std::time_t>(unixSeconds);
+    std::tm    localTime {};
+
+#ifdef _WIN32
+    if (localtime_s(&localTime, &timeValue) != 0)
+      return None;
+#else
+    if (!localtime_r(&timeValue, &localTime))
+      return None;
+#endif
+
+    return std::format("{:02}:{:02}", localTime.tm_hour, localTime.tm_min);
+  }
+
+  auto UnixNow() -> i64 {
+    return static_cast<i64>(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+  }
+
+  /**
+   * @brief Render bucketed temperatures as a block-character sparkline
+   * @details Empty buckets become spaces. Returns None when fewer than two
+   * buckets have data, since a single point carries no trend.
+   */
+  auto RenderSparkline(const Vec<Option<f64>>& buckets) -> Option<String> {
+    static constexpr Array<StringView, 8> BLOCKS = { "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█" };
+
+    Option<f64> low;
+    Option<f64> high;
+    usize       filled = 0;
+
+    for (const Option<f64>& value : buckets) {
+      if (!value)
+        continue;
+      low  = low ? std::min(*low, *value) : *value;
+      high = high ? std::max(*high, *value) : *value;
+      ++filled;
+    }
+
+    if (filled < 2)
+      return None;
+
+    const f64 range = *high - *low;
+
+    String result;
+    for (const Option<f64>& value : buckets) {
+      if (!value) {
+        result += ' ';
+        continue;
+      }
+
+      const usize level = range > 0.0 ? static_cast<usize>((*value - *low) / range * (BLOCKS.size() - 1) + 0.5) : BLOCKS.size() / 2;
+      result += BLOCKS.at(level);
+    }
+
+    return result;
+  }
+
   class WeatherPlugin : public IInfoProviderPlugin {
    private:
     PluginMetadata                                      m_metadata;
     weather::WeatherConfig                              m_config;
     weather::WeatherData                                m_data;
+    Option<weather::solar::SolarDay>                    m_solar;
+    Option<weather::AirQualityData>                     m_airQuality;
+    Option<weather::history::ObservationRing>           m_history;
+    weather::kernels::DerivedColumns                    m_derived;
     Option<String>                                      m_lastError;
     UniquePointer<weather::providers::IWeatherProvider> m_provider;
+    Option<weather::providers::AirQualityProvider>      m_airQualityProvider;
 #if !DRAC_PRECOMPILED_CONFIG
     Option<String>                                      m_runtimeConfig;
 #endif
@@ -861,6 +1514,22 @@ namespace {
       if (precompiledCfg.apiKey.has_value())
         cfg.apiKey = String(*precompiledCfg.apiKey);
 
+      // Empty overrides mean "use the public API"
+      auto endpointOverride = [](std::string_view value) -> Option<String> {
+        return value.empty() ? None : Some(String(value));
+      };
+
+      cfg.endpoints = {
+        .openMeteo      = endpointOverride(precompiledCfg.endpoints.openMeteo),
+        .metNo          = endpointOverride(precompiledCfg.endpoints.metNo),
+        .openWeatherMap = endpointOverride(precompiledCfg.endpoints.openWeatherMap),
+        .airQuality     = endpointOverride(precompiledCfg.endpoints.airQuality),
+        .unixSocket     = endpointOverride(precompiledCfg.endpoints.unixSocket),
+      };
+
+      cfg.airQuality    = precompiledCfg.airQuality;
+      cfg.airQualityTtl = precompiledCfg.airQualityTtl;
+
       return cfg;
     }
 #else
@@ -908,6 +1577,33 @@ namespace {
       if (!tomlCfg.apiKey.empty())
         cfg.apiKey = tomlCfg.apiKey;
 
+      // Parse endpoint overrides - only http(s) base URLs are accepted
+      auto endpointOverride = [](const String& value, StringView name) -> Option<String> {
+        if (value.empty())
+          return None;
+        if (!weather::config::IsValidEndpoint(value)) {
+          warn_log("Ignoring weather endpoint override for {}: '{}' is not an http(s) URL", name, value);
+          return None;
+        }
+        return value;
+      };
+
+      cfg.endpoints.openMeteo      = endpointOverride(tomlCfg.endpoints.openMeteo, "openmeteo");
+      cfg.endpoints.metNo          = endpointOverride(tomlCfg.endpoints.metNo, "metno");
+      cfg.endpoints.openWeatherMap = endpointOverride(tomlCfg.endpoints.openWeatherMap, "openweathermap");
+      cfg.endpoints.airQuality     = endpointOverride(tomlCfg.endpoints.airQuality, "air_quality");
+
+      // Same rule as the precompiled config's Validate(): the socket path must be absolute
+      if (!weather::config::IsValidUnixSocket(tomlCfg.endpoints.unixSocket))
+        warn_log("Ignoring weather unix_socket override: '{}' is not an absolute path", tomlCfg.endpoints.unixSocket);
+      else if (!tomlCfg.endpoints.unixSocket.empty())
+        cfg.endpoints.unixSocket = tomlCfg.endpoints.unixSocket;
+
+      // Parse auxiliary datasets
+      cfg.airQuality = tomlCfg.airQuality.enabled;
+      if (tomlCfg.airQuality.ttl != 0)
+        cfg.airQualityTtl = tomlCfg.airQuality.ttl;
+
       return cfg;
     }
 
@@ -991,6 +1687,21 @@ units = "metric"
 # API key (required for openweathermap)
 # Get a free key at: https://openweathermap.org/api
 # api_key = "your_api_key_here"
+
+# Endpoint overrides (optional) - point providers at a caching mirror or a
+# self-hosted instance. Base URLs replace the public API's scheme and host.
+# [endpoints]
+# openmeteo = "http://weather-cache.lan:8080"
+# metno = "http://weather-cache.lan:8081"
+# openweathermap = "http://weather-cache.lan:8082"
+# air_quality = "http://weather-cache.lan:8083"
+# unix_socket = "/run/weather-cache.sock"
+
+# Air quality and UV index (optional, coordinates only) - fetched concurrently
+# with the forecast and cached separately
+# [air_quality]
+# enabled = true
+# ttl = 3600
 )";
     }
 #endif // !DRAC_PRECOMPILED_CONFIG
@@ -1006,7 +1717,10 @@ units = "metric"
           if (!m_config.coords)
             ERR(InvalidArgument, "OpenMeteo requires coordinates. Set [location] with lat and lon in weather.toml");
           m_provider = weather::providers::CreateOpenMeteoProvider(
-            m_config.coords->lat, m_config.coords->lon, m_config.units
+            m_config.coords->lat,
+            m_config.coords->lon,
+            m_config.units,
+            resolveEndpoint(m_config.endpoints.openMeteo, weather::providers::OPENMETEO_BASE_URL)
           );
           break;
 
@@ -1014,7 +1728,10 @@ units = "metric"
           if (!m_config.coords)
             ERR(InvalidArgument, "Met.no requires coordinates. Set [location] with lat and lon in weather.toml");
           m_provider = weather::providers::CreateMetNoProvider(
-            m_config.coords->lat, m_config.coords->lon, m_config.units
+            m_config.coords->lat,
+            m_config.coords->lon,
+            m_config.units,
+            resolveEndpoint(m_config.endpoints.metNo, weather::providers::METNO_BASE_URL)
           );
           break;
 
@@ -1024,14 +1741,111 @@ units = "metric"
           if (!m_config.coords && !m_config.city)
             ERR(InvalidArgument, "OpenWeatherMap requires a location. Set location in weather.toml");
           m_provider = weather::providers::CreateOpenWeatherMapProvider(
-            m_config.coords, m_config.city, *m_config.apiKey, m_config.units
+            m_config.coords,
+            m_config.city,
+            *m_config.apiKey,
+            m_config.units,
+            resolveEndpoint(m_config.endpoints.openWeatherMap, weather::providers::OPENWEATHERMAP_BASE_URL)
           );
           break;
       }
 
+      m_airQualityProvider = None;
+      if (m_config.airQuality) {
+        if (m_config.coords)
+          m_airQualityProvider.emplace(
+            m_config.coords->lat,
+            m_config.coords->lon,
+            resolveEndpoint(m_config.endpoints.airQuality, weather::providers::AIR_QUALITY_BASE_URL)
+          );
+        else
+          warn_log("Weather: air quality requires coordinates; the dataset is disabled");
+      }
+
       return {};
     }
 
+    // Solar events are cheap to compute, so they are refreshed on every
+    // collection instead of being cached alongside the provider response
+    auto updateSolarPosition() -> void {
+      if (!m_config.coords) {
+        m_solar = None;
+        return;
+      }
+
+      m_solar = weather::solar::Compute(m_config.coords->lat, m_config.coords->lon, UnixNow());
+    }
+
+    auto updateDerivedMetrics() -> void {
+      m_derived = weather::kernels::ComputeAll(m_data.forecast);
+    }
+
+    // Current-hour derived metrics plus the feels-like range over the forecast window
+    auto addDerivedFields(PluginFields& fields) const -> void {
+      const weather::UnitSystem units = m_data.units;
+
+      if (m_derived.apparentTemperature.empty())
+        return;
+
+      fields["apparent_temperature"] = weather::FromCelsius(m_derived.apparentTemperature.front(), units);
+      fields["dew_point"]            = weather::FromCelsius(m_derived.dewPoint.front(), units);
+      fields["heat_index"]           = weather::FromCelsius(m_derived.heatIndex.front(), units);
+      fields["wind_chill"]           = weather::FromCelsius(m_derived.windChill.front(), units);
+
+      const auto [low, high] = std::ranges::minmax(m_derived.apparentTemperature);
+
+      fields["apparent_temperature_min"] = weather::FromCelsius(low, units);
+      fields["apparent_temperature_max"] = weather::FromCelsius(high, units);
+    }
+
+    auto recordObservation() -> void {
+      if (!m_history || !m_data.temperature)
+        return;
+
+      m_history->append({
+        .timestamp     = UnixNow(),
+        .temperatureC  = weather::ToCelsius(*m_data.temperature, m_data.units),
+        .conditionCode = m_data.conditionCode.value_or(-1),
+      });
+    }
+
+    // Trend fields are derived purely from the local observation history
+    auto addTrendFields(PluginFields& fields) const -> void {
+      using weather::history::Observation;
+
+      if (!m_history || !m_data.temperature)
+        return;
+
+      static constexpr i64   HOUR              = 3600;
+      static constexpr i64   DAY               = 24 * HOUR;
+      static constexpr f64   STEADY_THRESHOLD  = 1.0; // Celsius
+      static constexpr usize SPARKLINE_BUCKETS = 24;
+
+      const i64 now      = UnixNow();
+      const f64 currentC = weather::ToCelsius(*m_data.temperature, m_data.units);
+
+      if (const Option<Observation> yesterday = m_history->nearest(now - DAY, 2 * HOUR))
+        fields["temperature_change_24h"] = weather::FromCelsiusDelta(currentC - yesterday->temperatureC, m_data.units);
+
+      if (const Option<Observation> earlier = m_history->nearest(now - (3 * HOUR), HOUR)) {
+        const f64 delta = currentC - earlier->temperatureC;
+
+        fields["temperature_trend"] = String(delta > STEADY_THRESHOLD ? "rising" : delta < -STEADY_THRESHOLD ? "falling" : "steady");
+      }
+
+      if (Option<String> sparkline = RenderSparkline(m_history->downsample(now - DAY, now + 1, SPARKLINE_BUCKETS)))
+        fields["temperature_sparkline"] = std::move(*sparkline);
+    }
+
+    // Resolve the endpoint for a provider, falling back to its public API
+    [[nodiscard]] auto resolveEndpoint(const Option<String>& baseUrlOverride, StringView defaultBaseUrl) const -> weather::Endpoint {
+      String baseUrl = baseUrlOverride ? *baseUrlOverride : String(defaultBaseUrl);
+      while (baseUrl.ends_with('/'))
+        baseUrl.pop_back();
+
+      return { .baseUrl = std::move(baseUrl), .unixSocket = m_config.endpoints.unixSocket };
+    }
+
    public:
     WeatherPlugin() {
       m_metadata = {
@@ -1115,14 +1929,24 @@ units = "metric"
         }
       }
 
+      // Observation history is optional; trend fields are simply omitted without it
+      if (m_config.enabled) {
+        if (auto ring = weather::history::ObservationRing::open(ctx.cacheDir / "weather_history.ring"))
+          m_history = std::move(*ring);
+        else
+          warn_log("Weather plugin: observation history unavailable: {}", ring.error().message);
+      }
+
       m_ready = true;
       debug_log("Weather plugin initialization complete");
       return {};
     }
 
     auto shutdown() -> Unit override {
-      m_provider = nullptr;
-      m_ready    = false;
+      m_provider           = nullptr;
+      m_airQualityProvider = None;
+      m_history            = None;
+      m_ready              = false;
     }
 
     [[nodiscard]] auto isReady() const -> bool override {
@@ -1149,28 +1973,92 @@ units = "metric"
 
       m_lastError = None;
 
+      updateSolarPosition();
+
       // Check cache first - directly cache WeatherData using BEVE (no JSON conversion needed)
-      String cacheKey = "weather_data";
+      String cacheKey    = "weather_data";
+      bool   needWeather = true;
       if (auto cached = cache.get<weather::WeatherData>(cacheKey)) {
         debug_log("Weather: Found cached data for key '{}'", cacheKey);
-        m_data = *cached;
+        m_data      = *cached;
+        needWeather = false;
+        updateDerivedMetrics();
+      } else {
+        debug_log("Weather: No cached data found for key '{}'", cacheKey);
+      }
+
+      // Auxiliary datasets have their own cache entries and lifetimes
+      String airQualityCacheKey = "weather_air_quality";
+      bool   needAirQuality     = false;
+      if (m_airQualityProvider) {
+        if (auto cached = cache.get<weather::AirQualityData>(airQualityCacheKey))
+          m_airQuality = *cached;
+        else
+          needAirQuality = true;
+      }
+
+      if (!needWeather && !needAirQuality)
         return {};
+
+      // Fetch every stale dataset in one concurrent batch
+      Vec<weather::providers::Request> requests;
+
+      if (needWeather) {
+        auto request = m_provider->buildRequest();
+        if (!request) {
+          m_lastError = request.error().message;
+          return std::unexpected(request.error());
+        }
+        requests.push_back(std::move(*request));
+      }
+
+      if (needAirQuality)
+        requests.push_back(m_airQualityProvider->buildRequest());
+
+      Vec<Result<String>> responses = weather::providers::HttpGetAll(requests);
+
+      // A failed auxiliary dataset is logged but never blocks the forecast
+      if (needAirQuality) {
+        const Result<String>& response = responses.back();
+
+        Result<weather::AirQualityData> airQuality = response
+          ? weather::providers::AirQualityProvider::parseResponse(*response)
+          : Result<weather::AirQualityData>(Err(response.error()));
+
+        if (airQuality) {
+          m_airQuality = *airQuality;
+          cache.set(airQualityCacheKey, *m_airQuality, m_config.airQualityTtl);
+          debug_log("Weather: Cached data with key '{}'", airQualityCacheKey);
+        } else {
+          warn_log("Weather: air-quality dataset unavailable: {}", airQuality.error().message);
+        }
       }
-      debug_log("Weather: No cached data found for key '{}'", cacheKey);
 
-      // Fetch fresh data
-      auto result = m_provider->fetch();
+      if (!needWeather)
+        return {};
+
+      const Result<String>& response = responses.front();
+      if (!response) {
+        m_lastError = response.error().message;
+        return std::unexpected(response.error());
+      }
+
+      auto result = m_provider->parseResponse(*response);
       if (!result) {
         m_lastError = result.error().message;
         return std::unexpected(result.error());
       }
 
       m_data = *result;
+      updateDerivedMetrics();
 
       // Cache the result directly as WeatherData (BEVE format, 10 minute TTL)
       cache.set(cacheKey, m_data, 600);
       debug_log("Weather: Cached data with key '{}'", cacheKey);
 
+      // Only fresh observations enter the history, so cache hits never create duplicates
+      recordObservation();
+
       return {};
     }
 
@@ -1188,6 +2076,38 @@ units = "metric"
 
       fields["units"] = m_data.units == weather::UnitSystem::Metric ? "metric" : "imperial";
 
+      if (m_airQuality) {
+        if (m_airQuality->europeanAqi)
+          fields["air_quality"] = *m_airQuality->europeanAqi;
+
+        if (m_airQuality->usAqi)
+          fields["us_aqi"] = *m_airQuality->usAqi;
+
+        if (m_airQuality->pm25)
+          fields["pm2_5"] = *m_airQuality->pm25;
+
+        if (m_airQuality->pm10)
+          fields["pm10"] = *m_airQuality->pm10;
+
+        if (m_airQuality->uvIndex)
+          fields["uv_index"] = *m_airQuality->uvIndex;
+      }
+
+      addDerivedFields(fields);
+      addTrendFields(fields);
+
+      if (m_solar) {
+        fields["daylight"] = String(weather::solar::PhaseName(m_solar->phase));
+
+        if (m_solar->sunrise)
+          if (Option<String> sunrise = FormatLocalTime(*m_solar->sunrise))
+            fields["sunrise"] = *sunrise;
+
+        if (m_solar->sunset)
+          if (Option<String> sunset = FormatLocalTime(*m_solar->sunset))
+            fields["sunset"] = *sunset;
+      }
+
       return fields;
     }
 
@@ -1204,7 +2124,16 @@ units = "metric"
     }
 
     [[nodiscard]] auto getDisplayIcon() const -> String override {
-      return "   "; // Nerd Font weather icon
+      using weather::solar::DayPhase;
+
+      if (!m_solar)
+        return "   "; // Nerd Font weather icon
+
+      switch (m_solar->phase) {
+        case DayPhase::Day:           return "   "; // Nerd Font day-sunny icon
+        case DayPhase::CivilTwilight: return "   "; // Nerd Font sunset icon
+        default:                      return "   "; // Nerd Font night-clear icon
+      }
     }
 
     [[nodiscard]] auto getDisplayLabel() const -> String override {
@@ -0,0 +1,395 @@
+/**
+ * @file yaml_emitter.hpp
+ * @brief Tree-free block YAML writer for the YAML format plugin
+ * @author Draconis++ Team
+ * @version 1.0.0
+ *
+ * @details The plugin's documents are nested block maps of string scalars, at
+ * most three levels deep. BlockWriter appends such a document straight to a
+ * String as the formatter walks its data, without building a node tree first
+ * and without pulling RapidYAML into the translation unit.
+ *
+ * The output is byte-for-byte what RapidYAML 0.10 emits for the same document,
+ * so switching between the two emitters never changes a file:
+ * - ChooseStyle() ports ryml's scalar_style_choose(), including the number
+ *   grammar of c4::csubstr::is_number() that lets "-1" or "-.5" stay plain.
+ * - Plain scalars, which are nearly all of them, are classified with a single
+ *   table-driven pass and appended as-is. Only scalars that need quoting are
+ *   scanned a second time for characters to escape.
+ * - Single-quoted scalars double their quotes and fold newlines the way ryml
+ *   does; double-quoted ones escape `"`, `\`, `\n`, `\r` and `\b`.
+ * - Empty scalars are written as `''`, ryml's choice for empty non-null views.
+ * - A map without entries is written in flow style, `key: {}`.
+ */
+
+#pragma once
+
+#include <Drac++/Utils/Types.hpp>
+
+namespace yaml_format::emitter {
+  using namespace draconis::utils::types;
+
+  enum class ScalarStyle : u8 {
+    Plain,
+    SingleQuoted,
+    DoubleQuoted,
+  };
+
+  namespace detail {
+    constexpr auto IsDigit(const char chr) -> bool {
+      return chr >= '0' && chr <= '9';
+    }
+
+    constexpr auto IsHexDigit(const char chr) -> bool {
+      return IsDigit(chr) || (chr >= 'a' && chr <= 'f') || (chr >= 'A' && chr <= 'F');
+    }
+
+    constexpr auto IsBinDigit(const char chr) -> bool {
+      return chr == '0' || chr == '1';
+    }
+
+    constexpr auto IsOctDigit(const char chr) -> bool {
+      return chr >= '0' && chr <= '7';
+    }
+
+    constexpr auto IsSign(const char chr) -> bool {
+      return chr == '+' || chr == '-';
+    }
+
+    // Every character of text from pos on satisfies isDigit (vacuously true past the end)
+    template <typename Pred>
+    constexpr auto AllOf(const StringView text, usize pos, Pred isDigit) -> bool {
+      for (; pos < text.size(); ++pos)
+        if (!isDigit(text[pos]))
+          return false;
+      return true;
+    }
+
+    // The integer forms of c4's first_int_span(): decimal, 0x, 0b and 0o
+    constexpr auto IsInteger(const StringView text) -> bool {
+      const usize start = IsSign(text[0]) ? 1 : 0;
+
+      if (start == text.size())
+        return false;
+
+      if (text.size() >= start + 3 && text[start] == '0') {
+        switch (text[start + 1]) {
+          case 'x':
+          case 'X': return AllOf(text, start + 2, IsHexDigit);
+          case 'b':
+          case 'B': return AllOf(text, start + 2, IsBinDigit);
+          case 'o':
+          case 'O': return AllOf(text, start + 2, IsOctDigit);
+          default:  break;
+        }
+      }
+
+      return AllOf(text, start, IsDigit);
+    }
+
+    // Decimal reals: digits, an optional fraction and an optional e exponent
+    constexpr auto IsDecimalReal(const StringView text, usize pos) -> bool {
+      bool intDigits  = false;
+      bool fracDigits = false;
+
+      for (; pos < text.size() && IsDigit(text[pos]); ++pos)
+        intDigits = true;
+
+      if (pos < text.size() && text[pos] == '.')
+        for (++pos; pos < text.size() && IsDigit(text[pos]); ++pos)
+          fracDigits = true;
+
+      if (pos == text.size())
+        return intDigits || fracDigits;
+
+      if ((text[pos] != 'e' && text[pos] != 'E') || ++pos == text.size() || (!intDigits && !fracDigits))
+        return false;
+
+      if (IsSign(text[pos]))
+        ++pos;
+
+      return pos < text.size() && AllOf(text, pos, IsDigit);
+    }
+
+    // Hex, binary and octal reals; their p exponent requires a sign
+    template <typename Pred>
+    constexpr auto IsRadixReal(const StringView text, usize pos, Pred isDigit) -> bool {
+      bool intDigits  = false;
+      bool fracDigits = false;
+
+      for (; pos < text.size() && isDigit(text[pos]); ++pos)
+        intDigits = true;
+
+      if (pos < text.size() && text[pos] == '.')
+        for (++pos; pos < text.size() && isDigit(text[pos]); ++pos)
+          fracDigits = true;
+
+      if (pos == text.size())
+        return intDigits || fracDigits;
+
+      if ((text[pos] != 'p' && text[pos] != 'P') || (!intDigits && !fracDigits))
+        return false;
+
+      ++pos;
+      return pos + 1 < text.size() && IsSign(text[pos]) && AllOf(text, pos + 1, IsDigit);
+    }
+
+    // The real forms of c4's first_real_span(), including inf, infinity and nan
+    constexpr auto IsReal(const StringView text) -> bool {
+      const usize start = IsSign(text[0]) ? 1 : 0;
+
+      if (text.size() < start + 3)
+        return IsDecimalReal(text, start);
+
+      const StringView body = text.substr(start);
+
+      switch (body[0]) {
+        case 'i': return body == "infinity" || body == "inf";
+        case 'n': return body == "nan";
+        case '0': break;
+        default:  return IsDecimalReal(text, start);
+      }
+
+      switch (body[1]) {
+        case 'x':
+        case 'X': return IsRadixReal(text, start + 2, IsHexDigit);
+        case 'b':
+        case 'B': return IsRadixReal(text, start + 2, IsBinDigit);
+        case 'o':
+        case 'O': return IsRadixReal(text, start + 2, IsOctDigit);
+        default:  return IsDecimalReal(text, start);
+      }
+    }
+
+    /**
+     * @brief Port of c4::csubstr::is_number()
+     * @details c4 accepts a span only if it ends at a delimiter and the whole
+     * string must be the span, so a number here is one of the grammars above
+     * with nothing before or after it.
+     */
+    constexpr auto IsNumber(const StringView text) -> bool {
+      if (text.empty() || text.find_first_of(" \n\r\t") != StringView::npos)
+        return false;
+      return IsInteger(text) || IsReal(text);
+    }
+
+    // Plain-scalar restrictions, one bit per rule of ryml's scalar_style_query_plain()
+    enum CharClass : u8 {
+      NotFirst   = 1 << 0, // "-:?*&,'\"{}[]|>%#@`\r", plus whitespace which forces double quotes
+      NotLast    = 1 << 1, // ":#", plus whitespace
+      NotInside  = 1 << 2, // "\n#:[]{},"
+      Whitespace = 1 << 3, // " \n\t" at either end forces double quotes
+    };
+
+    inline constexpr Array<u8, 256> CHAR_CLASSES = [] {
+      Array<u8, 256> classes {};
+
+      const auto mark = [&classes](const StringView chars, const u8 flag) {
+        for (const char chr : chars)
+          classes[static_cast<u8>(chr)] |= flag;
+      };
+
+      mark("-:?*&,'\"{}[]|>%#@`\r", NotFirst);
+      mark(":#", NotLast);
+      mark("\n#:[]{},", NotInside);
+      mark(" \n\t", NotFirst | NotLast | Whitespace);
+
+      return classes;
+    }();
+
+    constexpr auto ClassOf(const char chr) -> u8 {
+      return CHAR_CLASSES[static_cast<u8>(chr)];
+    }
+
+    // Port of ryml's scalar_style_query_plain() for non-empty text without edge whitespace
+    constexpr auto QueryPlain(const StringView text) -> bool {
+      // A leading '-' is only allowed for numbers ("-1", "-.5", "-.inf")
+      if (text[0] == '-') {
+        if (text.starts_with("-."))
+          return text == "-.inf" || text == "-.INF" || IsNumber(text.substr(2));
+        return IsNumber(text);
+      }
+
+      // Every other number also passes the checks below, so it needs no parse
+      if ((ClassOf(text[0]) & NotFirst) || (ClassOf(text.back()) & NotLast))
+        return false;
+
+      for (const char chr : text)
+        if (ClassOf(chr) & NotInside)
+          return false;
+
+      return true;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Port of ryml's scalar_style_choose() for a non-empty scalar
+   */
+  constexpr auto ChooseStyle(const StringView scalar) -> ScalarStyle {
+    if ((detail::ClassOf(scalar.front()) & detail::Whitespace) || (detail::ClassOf(scalar.back()) & detail::Whitespace))
+      return ScalarStyle::DoubleQuoted;
+
+    if (detail::QueryPlain(scalar))
+      return ScalarStyle::Plain;
+
+    // Single quotes cannot represent a line that starts with whitespace
+    if (scalar.find("\n ") == StringView::npos && scalar.find("\n\t") == StringView::npos)
+      return ScalarStyle::SingleQuoted;
+
+    return ScalarStyle::DoubleQuoted;
+  }
+
+  static_assert(ChooseStyle("Linux 6.9.1") == ScalarStyle::Plain);
+  static_assert(ChooseStyle("-12") == ScalarStyle::Plain && ChooseStyle("-.5e3") == ScalarStyle::Plain);
+  static_assert(ChooseStyle("-0x1F") == ScalarStyle::Plain && ChooseStyle("-.inf") == ScalarStyle::Plain);
+  static_assert(ChooseStyle("-v") == ScalarStyle::SingleQuoted && ChooseStyle("12:30") == ScalarStyle::SingleQuoted);
+  static_assert(ChooseStyle(" padded") == ScalarStyle::DoubleQuoted && ChooseStyle("a\n b") == ScalarStyle::DoubleQuoted);
+
+  /**
+   * @brief Appends a block-style YAML map document to a String
+   * @details Entries are written in call order. beginMap() opens a nested map
+   * under a key and endMap() closes it; the key line is held back until the
+   * first entry so that an empty map can still be written as `key: {}`.
+   * Keys and values must stay valid until the next call.
+   */
+  class BlockWriter {
+   public:
+    explicit BlockWriter(String& out) : m_out(out) {}
+
+    /**
+     * @brief Open a nested map under key in the current map
+     */
+    auto beginMap(const StringView key) -> void {
+      openPendingMap();
+      m_pendingKey = key;
+      m_hasPending = true;
+      ++m_depth;
+    }
+
+    /**
+     * @brief Close the innermost open map
+     */
+    auto endMap() -> void {
+      if (m_hasPending) {
+        writeKey(m_pendingKey, m_depth - 1);
+        m_out += ": {}\n";
+        m_hasPending = false;
+      }
+      --m_depth;
+    }
+
+    /**
+     * @brief Write a key: value pair into the current map
+     */
+    auto entry(const StringView key, const StringView value) -> void {
+      openPendingMap();
+      writeKey(key, m_depth);
+      m_out += ": ";
+      writeScalar(value, m_depth);
+      m_out += '\n';
+    }
+
+    /**
+     * @brief Complete the document; a root map without entries becomes `{}`
+     */
+    auto finish() -> void {
+      if (m_empty)
+        m_out += " {}\n";
+    }
+
+   private:
+    String&    m_out;
+    StringView m_pendingKey;
+    usize      m_depth      = 0;
+    bool       m_hasPending = false;
+    bool       m_empty      = true;
+
+    auto openPendingMap() -> void {
+      if (!m_hasPending)
+        return;
+
+      writeKey(m_pendingKey, m_depth - 1);
+      m_out += ":\n";
+      m_hasPending = false;
+    }
+
+    auto writeKey(const StringView key, const usize level) -> void {
+      m_empty = false;
+      m_out.append(2 * level, ' ');
+      writeScalar(key, level);
+    }
+
+    auto writeScalar(const StringView scalar, const usize level) -> void {
+      if (scalar.empty()) {
+        m_out += "''";
+        return;
+      }
+
+      switch (ChooseStyle(scalar)) {
+        case ScalarStyle::Plain:
+          // At the top level a plain "..." would read as a document end marker
+          if (level == 0 && scalar.starts_with("..."))
+            m_out += "  ";
+          m_out += scalar;
+          break;
+        case ScalarStyle::SingleQuoted: writeSingleQuoted(scalar, level); break;
+        case ScalarStyle::DoubleQuoted: writeDoubleQuoted(scalar); break;
+      }
+    }
+
+    // Quotes are doubled; a run of n line breaks becomes n + 1, and the text
+    // after it is indented one level deeper than the entry
+    auto writeSingleQuoted(const StringView scalar, const usize level) -> void {
+      usize written = 0;
+
+      m_out += '\'';
+
+      for (usize pos = 0; pos < scalar.size(); ++pos) {
+        if (scalar[pos] == '\'') {
+          m_out.append(scalar.substr(written, pos + 1 - written));
+          m_out += '\'';
+          written = pos + 1;
+        } else if (scalar[pos] == '\n') {
+          m_out.append(scalar.substr(written, pos - written));
+          m_out += '\n';
+
+          for (; pos < scalar.size() && scalar[pos] == '\n'; ++pos)
+            m_out += '\n';
+
+          m_out.append(2 * (level + 1), ' ');
+          written = pos;
+          --pos;
+        }
+      }
+
+      m_out.append(scalar.substr(written));
+      m_out += '\'';
+    }
+
+    auto writeDoubleQuoted(const StringView scalar) -> void {
+      usize written = 0;
+
+      m_out += '"';
+
+      for (usize pos = 0; pos < scalar.size(); ++pos) {
+        StringView escape;
+
+        switch (scalar[pos]) {
+          case '"':  escape = "\\\""; break;
+          case '\\': escape = "\\\\"; break;
+          case '\n': escape = "\\n"; break;
+          case '\r': escape = "\\r"; break;
+          case '\b': escape = "\\b"; break;
+          default:   continue;
+        }
+
+        m_out.append(scalar.substr(written, pos - written));
+        m_out += escape;
+        written = pos + 1;
+      }
+
+      m_out.append(scalar.substr(written));
+      m_out += '"';
+    }
+  };
+} // namespace yaml_format::emitter
@@ -4,26 +4,210 @@
  * @author Draconis++ Team
  * @version 1.0.0
  *
- * @details This plugin provides YAML output formatting for system information
- * using the RapidYAML library (single-header amalgamation) for proper YAML generation.
+ * @details This plugin provides YAML output formatting for system information.
  * It supports a single output mode:
  * - "yaml": Human-readable YAML output
  *
+ * The document is written by one of two emitters, chosen at build time:
+ * - By default, yaml_emitter.hpp's BlockWriter appends it straight to the
+ *   output string, without a node tree.
+ * - With YAML_FORMAT_USE_RYML defined, it is built in a RapidYAML tree
+ *   (single-header amalgamation) and emitted from there.
+ * Both produce identical output; WriteDocument() lays out the document once
+ * for either of them.
+ *
  * This file supports both dynamic (shared library) and static compilation.
  * When compiled as a static plugin (DRAC_STATIC_PLUGIN_BUILD defined),
  * it exports factory functions in a namespace instead of extern "C".
  */
 
-#define RYML_SINGLE_HDR_DEFINE_NOW
+#ifdef YAML_FORMAT_USE_RYML
+  #define RYML_SINGLE_HDR_DEFINE_NOW
+  #include <mutex>
+#endif
+
+#include <variant>
+
 #include <Drac++/Core/Plugin.hpp>
 
 #include <Drac++/Utils/Error.hpp>
 #include <Drac++/Utils/Types.hpp>
 
-#include "ryml_all.hpp"
+#include "../common/format_fields.hpp"
+
+#ifdef YAML_FORMAT_USE_RYML
+  #include "ryml_all.hpp"
+#else
+  #include "yaml_emitter.hpp"
+#endif
 
 namespace {
   using namespace draconis::utils::types;
+  using format_fields::FieldId;
+  using format_fields::FieldValues;
+
+#ifdef YAML_FORMAT_USE_RYML
+  /**
+   * @brief Builds the document in a RapidYAML tree, with BlockWriter's interface
+   * @details Keys and values live in the arena. Growing it relocates earlier
+   * copies, so each one is attached to its node before the next copy.
+   */
+  class TreeWriter {
+   public:
+    explicit TreeWriter(ryml::Tree& tree) : m_tree(tree), m_node(tree.rootref()) {
+      m_node |= ryml::MAP;
+    }
+
+    auto beginMap(const StringView key) -> void {
+      m_node = m_node.append_child();
+      m_node.set_key(m_tree.copy_to_arena(ryml::to_csubstr(key)));
+      m_node |= ryml::MAP;
+    }
+
+    auto endMap() -> void {
+      m_node = m_node.parent();
+    }
+
+    auto entry(const StringView key, const StringView value) -> void {
+      ryml::NodeRef child = m_node.append_child();
+      child.set_key(m_tree.copy_to_arena(ryml::to_csubstr(key)));
+      child.set_val(m_tree.copy_to_arena(ryml::to_csubstr(value)));
+    }
+
+    auto finish() -> void {}
+
+   private:
+    ryml::Tree&   m_tree;
+    ryml::NodeRef m_node;
+  };
+#endif
+
+  /**
+   * @brief Add a key-value pair to the current map if the field has a value
+   */
+  template <typename Writer>
+  auto AddIfPresent(Writer& writer, const StringView key, const FieldValues& fields, const FieldId field) -> void {
+    if (fields.has(field))
+      writer.entry(key, fields.get(field));
+  }
+
+  /**
+   * @brief Lay out the whole document through a BlockWriter or TreeWriter
+   */
+  template <typename Writer>
+  auto WriteDocument(Writer& writer, const FieldValues& fields, const draconis::core::plugin::PluginData& pluginData) -> void {
+    // General section
+    if (fields.has(FieldId::Date)) {
+      writer.beginMap("general");
+      AddIfPresent(writer, "date", fields, FieldId::Date);
+      writer.endMap();
+    }
+
+    // Weather section
+    if (fields.has(FieldId::WeatherTemperature)) {
+      writer.beginMap("weather");
+      AddIfPresent(writer, "temperature", fields, FieldId::WeatherTemperature);
+      AddIfPresent(writer, "town", fields, FieldId::WeatherTown);
+      AddIfPresent(writer, "description", fields, FieldId::WeatherDescription);
+      writer.endMap();
+    }
+
+    // System section
+    if (fields.has(FieldId::Host) || fields.has(FieldId::Os) || fields.has(FieldId::Kernel)) {
+      writer.beginMap("system");
+      AddIfPresent(writer, "host", fields, FieldId::Host);
+      AddIfPresent(writer, "operating_system", fields, FieldId::Os);
+      AddIfPresent(writer, "os_name", fields, FieldId::OsName);
+      AddIfPresent(writer, "os_version", fields, FieldId::OsVersion);
+      AddIfPresent(writer, "os_id", fields, FieldId::OsId);
+      AddIfPresent(writer, "kernel", fields, FieldId::Kernel);
+      writer.endMap();
+    }
+
+    // Hardware section
+    if (fields.has(FieldId::Ram) || fields.has(FieldId::Disk) || fields.has(FieldId::Cpu) ||
+        fields.has(FieldId::Gpu) || fields.has(FieldId::Uptime)) {
+      writer.beginMap("hardware");
+
+      // Memory subsection
+      if (fields.has(FieldId::Ram)) {
+        writer.beginMap("memory");
+        AddIfPresent(writer, "info", fields, FieldId::Ram);
+        AddIfPresent(writer, "used_bytes", fields, FieldId::MemoryUsedBytes);
+        AddIfPresent(writer, "total_bytes", fields, FieldId::MemoryTotalBytes);
+        writer.endMap();
+      }
+
+      // Disk subsection
+      if (fields.has(FieldId::Disk)) {
+        writer.beginMap("disk");
+        AddIfPresent(writer, "info", fields, FieldId::Disk);
+        AddIfPresent(writer, "used_bytes", fields, FieldId::DiskUsedBytes);
+        AddIfPresent(writer, "total_bytes", fields, FieldId::DiskTotalBytes);
+        writer.endMap();
+      }
+
+      // CPU subsection
+      if (fields.has(FieldId::Cpu)) {
+        writer.beginMap("cpu");
+        AddIfPresent(writer, "model", fields, FieldId::Cpu);
+        AddIfPresent(writer, "cores_physical", fields, FieldId::CpuCoresPhysical);
+        AddIfPresent(writer, "cores_logical", fields, FieldId::CpuCoresLogical);
+        writer.endMap();
+      }
+
+      // GPU
+      AddIfPresent(writer, "gpu", fields, FieldId::Gpu);
+
+      // Uptime subsection
+      if (fields.has(FieldId::Uptime)) {
+        writer.beginMap("uptime");
+        AddIfPresent(writer, "formatted", fields, FieldId::Uptime);
+        AddIfPresent(writer, "seconds", fields, FieldId::UptimeSeconds);
+        writer.endMap();
+      }
+
+      writer.endMap();
+    }
+
+    // Software section
+    if (fields.has(FieldId::Shell) || fields.has(FieldId::Packages)) {
+      writer.beginMap("software");
+      AddIfPresent(writer, "shell", fields, FieldId::Shell);
+      AddIfPresent(writer, "package_count", fields, FieldId::Packages);
+      writer.endMap();
+    }
+
+    // Environment section
+    if (fields.has(FieldId::DesktopEnvironment) || fields.has(FieldId::WindowManager)) {
+      writer.beginMap("environment");
+      AddIfPresent(writer, "desktop_environment", fields, FieldId::DesktopEnvironment);
+      AddIfPresent(writer, "window_manager", fields, FieldId::WindowManager);
+      writer.endMap();
+    }
+
+    // Plugin data section - use pluginData directly
+    if (!pluginData.empty()) {
+      writer.beginMap("plugins");
+
+      for (const auto& [pluginId, pluginFields] : pluginData) {
+        writer.beginMap(pluginId);
+
+        for (const auto& [fieldName, value] : pluginFields) {
+          if (const String* text = std::get_if<String>(&value))
+            writer.entry(fieldName, *text);
+          else
+            writer.entry(fieldName, draconis::core::plugin::PluginFieldToString(value));
+        }
+
+        writer.endMap();
+      }
+
+      writer.endMap();
+    }
+
+    writer.finish();
+  }
 
   class YamlFormatPlugin : public draconis::core::plugin::IOutputFormatPlugin {
    private:
@@ -32,24 +216,19 @@ namespace {
 
     static constexpr auto FORMAT_YAML = "yaml";
 
-    /**
-     * @brief Helper to get value from data map, returning pointer to the string if found
-     * @note Returns pointer to the map's string which remains valid during formatOutput
-     */
-    static auto getValue(const Map<String, String>& data, const String& key) -> const String* {
-      if (auto iter = data.find(key); iter != data.end() && !iter->second.empty())
-        return &iter->second;
-      return nullptr;
-    }
+#ifdef YAML_FORMAT_USE_RYML
+    // Initial capacity of the reused tree; both grow to the largest document seen
+    static constexpr ryml::id_type TREE_NODE_CAPACITY = 96;
+    static constexpr usize         TREE_ARENA_BYTES   = 4096;
 
-    /**
-     * @brief Add a key-value pair to a YAML node if value exists
-     * @note The value pointer must remain valid for the lifetime of the tree
-     */
-    static auto addIfPresent(ryml::NodeRef node, const char* key, const String* value) -> void {
-      if (value)
-        node[ryml::to_csubstr(key)] = ryml::to_csubstr(*value);
-    }
+    // formatOutput() rebuilds the document in this tree on every call, so after
+    // the first few calls no node or arena memory is allocated
+    mutable std::mutex m_treeMutex;
+    mutable ryml::Tree m_tree;
+#else
+    // Enough for a typical document, so the output string is allocated once
+    static constexpr usize OUTPUT_RESERVE_BYTES = 2048;
+#endif
 
    public:
     YamlFormatPlugin() {
@@ -57,7 +236,7 @@ namespace {
         .name         = "YAML Format",
         .version      = "1.0.0",
         .author       = "Draconis++ Team",
-        .description  = "Provides YAML output formatting for system information using RapidYAML",
+        .description  = "Provides YAML output formatting for system information",
         .type         = draconis::core::plugin::PluginType::OutputFormat,
         .dependencies = {}
       };
@@ -68,6 +247,13 @@ namespace {
     }
 
     auto initialize(const draconis::core::plugin::PluginContext& /*ctx*/, ::PluginCache& /*cache*/) -> Result<Unit> override {
+#ifdef YAML_FORMAT_USE_RYML
+      const std::lock_guard lock(m_treeMutex);
+
+      m_tree.reserve(TREE_NODE_CAPACITY);
+      m_tree.reserve_arena(TREE_ARENA_BYTES);
+#endif
+
       m_ready = true;
       return {};
     }
@@ -88,120 +274,28 @@ namespace {
       if (!m_ready)
         return Err(draconis::utils::error::DracError { draconis::utils::error::DracErrorCode::Other, "YamlFormatPlugin is not ready." });
 
-      ryml::Tree    tree;
-      ryml::NodeRef root = tree.rootref();
-      root |= ryml::MAP;
+      const FieldValues fields = FieldValues::Extract(data);
 
-      // General section
-      if (getValue(data, "date")) {
-        ryml::NodeRef general = root["general"];
-        general |= ryml::MAP;
-        addIfPresent(general, "date", getValue(data, "date"));
-      }
-
-      // Weather section
-      if (getValue(data, "weather_temperature")) {
-        ryml::NodeRef weather = root["weather"];
-        weather |= ryml::MAP;
-        addIfPresent(weather, "temperature", getValue(data, "weather_temperature"));
-        addIfPresent(weather, "town", getValue(data, "weather_town"));
-        addIfPresent(weather, "description", getValue(data, "weather_description"));
-      }
-
-      // System section
-      if (getValue(data, "host") || getValue(data, "os") || getValue(data, "kernel")) {
-        ryml::NodeRef system = root["system"];
-        system |= ryml::MAP;
-        addIfPresent(system, "host", getValue(data, "host"));
-        addIfPresent(system, "operating_system", getValue(data, "os"));
-        addIfPresent(system, "os_name", getValue(data, "os_name"));
-        addIfPresent(system, "os_version", getValue(data, "os_version"));
-        addIfPresent(system, "os_id", getValue(data, "os_id"));
-        addIfPresent(system, "kernel", getValue(data, "kernel"));
-      }
+      // Emit YAML with document start marker
+      String yaml = "---\n";
 
-      // Hardware section
-      if (getValue(data, "ram") || getValue(data, "disk") || getValue(data, "cpu") ||
-          getValue(data, "gpu") || getValue(data, "uptime")) {
-        ryml::NodeRef hardware = root["hardware"];
-        hardware |= ryml::MAP;
-
-        // Memory subsection
-        if (getValue(data, "ram")) {
-          ryml::NodeRef memory = hardware["memory"];
-          memory |= ryml::MAP;
-          addIfPresent(memory, "info", getValue(data, "ram"));
-          addIfPresent(memory, "used_bytes", getValue(data, "memory_used_bytes"));
-          addIfPresent(memory, "total_bytes", getValue(data, "memory_total_bytes"));
-        }
+#ifdef YAML_FORMAT_USE_RYML
+      const std::lock_guard lock(m_treeMutex);
 
-        // Disk subsection
-        if (getValue(data, "disk")) {
-          ryml::NodeRef disk = hardware["disk"];
-          disk |= ryml::MAP;
-          addIfPresent(disk, "info", getValue(data, "disk"));
-          addIfPresent(disk, "used_bytes", getValue(data, "disk_used_bytes"));
-          addIfPresent(disk, "total_bytes", getValue(data, "disk_total_bytes"));
-        }
+      // Start over inside the node buffer and arena of the previous call
+      m_tree.clear();
+      m_tree.clear_arena();
 
-        // CPU subsection
-        if (getValue(data, "cpu")) {
-          ryml::NodeRef cpu = hardware["cpu"];
-          cpu |= ryml::MAP;
-          addIfPresent(cpu, "model", getValue(data, "cpu"));
-          addIfPresent(cpu, "cores_physical", getValue(data, "cpu_cores_physical"));
-          addIfPresent(cpu, "cores_logical", getValue(data, "cpu_cores_logical"));
-        }
+      TreeWriter writer(m_tree);
+      WriteDocument(writer, fields, pluginData);
 
-        // GPU
-        addIfPresent(hardware, "gpu", getValue(data, "gpu"));
+      ryml::emitrs_yaml(m_tree, &yaml, /*append=*/true);
+#else
+      yaml.reserve(OUTPUT_RESERVE_BYTES);
 
-        // Uptime subsection
-        if (getValue(data, "uptime")) {
-          ryml::NodeRef uptime = hardware["uptime"];
-          uptime |= ryml::MAP;
-          addIfPresent(uptime, "formatted", getValue(data, "uptime"));
-          addIfPresent(uptime, "seconds", getValue(data, "uptime_seconds"));
-        }
-      }
-
-      // Software section
-      if (getValue(data, "shell") || getValue(data, "packages")) {
-        ryml::NodeRef software = root["software"];
-        software |= ryml::MAP;
-        addIfPresent(software, "shell", getValue(data, "shell"));
-        addIfPresent(software, "package_count", getValue(data, "packages"));
-      }
-
-      // Environment section
-      if (getValue(data, "de") || getValue(data, "wm")) {
-        ryml::NodeRef environment = root["environment"];
-        environment |= ryml::MAP;
-        addIfPresent(environment, "desktop_environment", getValue(data, "de"));
-        addIfPresent(environment, "window_manager", getValue(data, "wm"));
-      }
-
-      // Plugin data section - use pluginData directly
-      if (!pluginData.empty()) {
-        ryml::NodeRef pluginsNode = root["plugins"];
-        pluginsNode |= ryml::MAP;
-
-        for (const auto& [pluginId, fields] : pluginData) {
-          // Copy plugin ID to arena so it outlives the loop
-          ryml::csubstr arenaPluginId = tree.copy_to_arena(ryml::to_csubstr(pluginId));
-          pluginsNode[arenaPluginId] |= ryml::MAP;
-
-          for (const auto& [fieldName, value] : fields) {
-            ryml::csubstr arenaFieldName               = tree.copy_to_arena(ryml::to_csubstr(fieldName));
-            const String stringValue                    = draconis::core::plugin::PluginFieldToString(value);
-            pluginsNode[arenaPluginId][arenaFieldName] = tree.copy_to_arena(ryml::to_csubstr(stringValue));
-          }
-        }
-      }
-
-      // Emit YAML with document start marker
-      String yaml = "---\n";
-      yaml += ryml::emitrs_yaml<String>(tree);
+      yaml_format::emitter::BlockWriter writer(yaml);
+      WriteDocument(writer, fields, pluginData);
+#endif
 
       return yaml;
     }